@@ -78,8 +78,9 @@ public:
 	 *
 	 * @param paused true, when the channel should be paused.
 	 *               false when it should be unpaused.
+	 * @param millis time at which the request was made.
 	 */
-	void pause(bool paused);
+	void pause(bool paused, uint32 millis);
 
 	/**
 	 * Queries whether the channel is currently paused.
@@ -98,7 +99,7 @@ public:
 	 *
 	 * @return volume
 	 */
-	byte getVolume();
+	byte getVolume() const;
 
 	/**
 	 * Sets the channel's balance setting.
@@ -112,7 +113,7 @@ public:
 	 *
 	 * @return balance
 	 */
-	int8 getBalance();
+	int8 getBalance() const;
 
 	/**
 	 * Sets the channel's left fader level.
@@ -126,7 +127,7 @@ public:
 	 *
 	 * @return The channel's left fader level.
 	 */
-	uint8 getFaderL();
+	uint8 getFaderL() const;
 
 	/**
 	 * Sets the channel's right fader level.
@@ -140,7 +141,7 @@ public:
 	 *
 	 * @return The channel's right fader level.
 	 */
-	uint8 getFaderR();
+	uint8 getFaderR() const;
 
 	/**
 	 * Set the channel's sample rate.
@@ -154,7 +155,7 @@ public:
 	 *
 	 * @return The current sample rate of the channel.
 	 */
-	uint32 getRate();
+	uint32 getRate() const;
 
 	/**
 	 * Reset the sample rate of the channel back to its
@@ -169,9 +170,13 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Timing bookkeeping, published by the mixer so that the elapsed
+	 * time can be queried without touching the channel.
 	 */
-	Timestamp getElapsedTime();
+	uint32 getSamplesConsumed() const { return _samplesConsumed; }
+	uint32 getMixerTimeStamp() const { return _mixerTimeStamp; }
+	uint32 getPauseStartTime() const { return _pauseStartTime; }
+	uint32 getPauseTime() const { return _pauseTime; }
 
 	/**
 	 * Replaces the channel's stream with a version that loops indefinitely.
@@ -226,6 +231,44 @@ private:
 #pragma mark --- Mixer ---
 #pragma mark -
 
+MixerImpl::CommandQueue::CommandQueue() : _writePos(0), _readPos(0) {
+	for (uint32 i = 0; i != COMMAND_QUEUE_SIZE; i++)
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool MixerImpl::CommandQueue::push(const Command &cmd) {
+	uint32 pos = _writePos.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell &cell = _cells[pos % COMMAND_QUEUE_SIZE];
+		const int32 diff = (int32)(cell.sequence.load(std::memory_order_acquire) - pos);
+		if (diff == 0) {
+			// The cell is free: try to claim it
+			if (_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				cell.command = cmd;
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			// The consumer has not freed this cell yet: the queue is full
+			return false;
+		} else {
+			// Another producer got there first
+			pos = _writePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool MixerImpl::CommandQueue::pop(Command &cmd) {
+	Cell &cell = _cells[_readPos % COMMAND_QUEUE_SIZE];
+	if ((int32)(cell.sequence.load(std::memory_order_acquire) - (_readPos + 1)) < 0)
+		return false;
+
+	cmd = cell.command;
+	cell.sequence.store(_readPos + COMMAND_QUEUE_SIZE, std::memory_order_release);
+	_readPos++;
+	return true;
+}
+
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
 	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
 
@@ -236,13 +279,13 @@ MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
 }
 
 MixerImpl::~MixerImpl() {
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
 }
 
 void MixerImpl::setReady(bool ready) {
-	Common::StackLock lock(_mutex);
-
 	_mixerReady = ready;
 }
 
@@ -258,10 +301,58 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
+int MixerImpl::findSlot(SoundHandle handle) const {
+	if (handle._val >= kReservedSlot)
+		return -1;
+
+	const int index = handle._val % NUM_CHANNELS;
+	if (_channelStates[index].handle.load(std::memory_order_acquire) != handle._val)
+		return -1;
+	return index;
+}
+
+bool MixerImpl::releaseSlot(int index, uint32 handle) {
+	return _channelStates[index].handle.compare_exchange_strong(handle, kFreeSlot);
+}
+
+void MixerImpl::postCommand(Command::Type type, int index, uint32 handle, int32 value, Channel *channel) {
+	Command cmd;
+	cmd.type = type;
+	cmd.index = index;
+	cmd.handle = handle;
+	cmd.channel = channel;
+	cmd.value = value;
+	cmd.millis = g_system->getMillis(true);
+
+	if (handle != kFreeSlot)
+		_channelStates[index].pendingCommands++;
+
+	while (!_commands.push(cmd)) {
+		// The mixing thread is not keeping up, or not running at all:
+		// apply the backlog from here
+		Common::StackLock lock(_mutex);
+		processCommands();
+	}
+}
+
+void MixerImpl::stopChannel(int index, uint32 handle) {
+	if (!releaseSlot(index, handle))
+		return;
+
+	// A sound whose play request is still queued is deleted by
+	// processCommands() when it finds its slot released
+	Channel *&chan = _channels[index];
+	if (chan && chan->getHandle()._val == handle) {
+		delete chan;
+		chan = nullptr;
+	}
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == nullptr) {
+		uint32 expected = kFreeSlot;
+		if (_channelStates[i].handle.compare_exchange_strong(expected, kReservedSlot)) {
 			index = i;
 			break;
 		}
@@ -272,13 +363,24 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		return;
 	}
 
-	_channels[index] = chan;
-
 	SoundHandle chanHandle;
-	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
-
+	chanHandle._val = index + (_handleSeed++ * NUM_CHANNELS);
 	chan->setHandle(chanHandle);
-	_handleSeed++;
+
+	ChannelState &state = _channelStates[index];
+	state.id = chan->getId();
+	state.type = chan->getType();
+	state.permanent = chan->isPermanent();
+	state.volume = chan->getVolume();
+	state.balance = chan->getBalance();
+	state.faderL = chan->getFaderL();
+	state.faderR = chan->getFaderR();
+	state.rate = chan->getRate();
+	state.streamRate = chan->getRate();
+	state.handle.store(chanHandle._val, std::memory_order_release);
+
+	postCommand(Command::kPlay, index, chanHandle._val, 0, chan);
+
 	if (handle)
 		*handle = chanHandle;
 }
@@ -291,8 +393,6 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == nullptr) {
 		warning("stream is 0");
 		return;
@@ -302,19 +402,16 @@ void MixerImpl::playStream(
 	assert(_mixerReady);
 
 	// Prevent duplicate sounds
-	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-				// Delete the stream if were asked to auto-dispose it.
-				// Note: This could cause trouble if the client code does not
-				// yet expect the stream to be gone. The primary example to
-				// keep in mind here is QueuingAudioStream.
-				// Thus, as a quick rule of thumb, you should never, ever,
-				// try to play QueuingAudioStreams with a sound id.
-				if (autofreeStream == DisposeAfterUse::YES)
-					delete stream;
-				return;
-			}
+	if (id != -1 && isSoundIDActive(id)) {
+		// Delete the stream if were asked to auto-dispose it.
+		// Note: This could cause trouble if the client code does not
+		// yet expect the stream to be gone. The primary example to
+		// keep in mind here is QueuingAudioStream.
+		// Thus, as a quick rule of thumb, you should never, ever,
+		// try to play QueuingAudioStreams with a sound id.
+		if (autofreeStream == DisposeAfterUse::YES)
+			delete stream;
+		return;
 	}
 
 #ifdef AUDIO_REVERSE_STEREO
@@ -328,11 +425,101 @@ void MixerImpl::playStream(
 	insertChannel(handle, chan);
 }
 
+void MixerImpl::processCommands() {
+	Command cmd;
+	while (_commands.pop(cmd)) {
+		Channel *&chan = _channels[cmd.index];
+
+		if (cmd.handle != kFreeSlot)
+			_channelStates[cmd.index].pendingCommands--;
+
+		if (cmd.type == Command::kPlay) {
+			// The sound may have been stopped before it got here
+			if (_channelStates[cmd.index].handle.load(std::memory_order_acquire) != cmd.handle) {
+				delete cmd.channel;
+				continue;
+			}
+			delete chan;
+			chan = cmd.channel;
+			publishTiming(cmd.index);
+			continue;
+		}
+
+		if (cmd.type == Command::kSoundTypeChanged) {
+			for (int i = 0; i != NUM_CHANNELS; i++) {
+				if (_channels[i] && _channels[i]->getType() == cmd.value)
+					_channels[i]->notifyGlobalVolChange();
+			}
+			continue;
+		}
+
+		// Ignore requests for sounds which already terminated
+		if (!chan || chan->getHandle()._val != cmd.handle)
+			continue;
+
+		switch (cmd.type) {
+		case Command::kPause:
+			chan->pause(cmd.value != 0, cmd.millis);
+			publishTiming(cmd.index);
+			break;
+		case Command::kVolume:
+			chan->setVolume(cmd.value);
+			break;
+		case Command::kBalance:
+			chan->setBalance(cmd.value);
+			break;
+		case Command::kFaderL:
+			chan->setFaderL(cmd.value);
+			break;
+		case Command::kFaderR:
+			chan->setFaderR(cmd.value);
+			break;
+		case Command::kRate:
+			chan->setRate(cmd.value);
+			break;
+		case Command::kResetRate:
+			chan->resetRate();
+			break;
+		case Command::kLoop:
+			chan->loop();
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void MixerImpl::flushCommands(int index) {
+	if (!_channelStates[index].pendingCommands)
+		return;
+
+	Common::StackLock lock(_mutex);
+	processCommands();
+}
+
+void MixerImpl::publishTiming(int index) {
+	const Channel *chan = _channels[index];
+	ChannelState &state = _channelStates[index];
+
+	state.timingSeq++;
+	state.timingHandle = chan->getHandle()._val;
+	state.samplesConsumed = chan->getSamplesConsumed();
+	state.mixerTimeStamp = chan->getMixerTimeStamp();
+	state.pauseStartTime = chan->getPauseStartTime();
+	state.pauseTime = chan->getPauseTime();
+	state.paused = chan->isPaused();
+	state.timingSeq++;
+}
+
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	// Engines may still lock mutex() to synchronize with the streams being
+	// mixed, but none of the Mixer API calls take it any more
 	Common::StackLock lock(_mutex);
 
+	processCommands();
+
 	int16 *buf = (int16 *)samples;
 
 	// Since the mixer callback has been called, the mixer must be ready...
@@ -355,10 +542,12 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
+				releaseSlot(i, _channels[i]->getHandle()._val);
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
+				publishTiming(i);
 
 				if (tmp > res)
 					res = tmp;
@@ -369,45 +558,46 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 }
 
 void MixerImpl::stopAll() {
+	// Stopping deletes the channels and their streams on the calling thread,
+	// so unlike the other calls it has to wait for an in-flight mix. The
+	// queued play requests are applied first to install their channels.
 	Common::StackLock lock(_mutex);
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		const uint32 handle = _channelStates[i].handle.load(std::memory_order_acquire);
+		if (handle < kReservedSlot && !_channelStates[i].permanent)
+			stopChannel(i, handle);
 	}
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
-		}
+		const uint32 handle = _channelStates[i].handle.load(std::memory_order_acquire);
+		if (handle < kReservedSlot && _channelStates[i].id == id)
+			stopChannel(i, handle);
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	Common::StackLock lock(_mutex);
+	processCommands();
+	stopChannel(index, handle._val);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 	_soundTypeSettings[type].mute = mute;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	postCommand(Command::kSoundTypeChanged, 0, kFreeSlot, type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
@@ -416,103 +606,97 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setVolume(volume);
+	_channelStates[index].volume = volume;
+	postCommand(Command::kVolume, index, handle._val, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getVolume();
+	return _channelStates[index].volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setBalance(balance);
+	_channelStates[index].balance = balance;
+	postCommand(Command::kBalance, index, handle._val, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getBalance();
+	return _channelStates[index].balance;
 }
 
 void MixerImpl::setChannelFaderL(SoundHandle handle, uint8 faderL) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setFaderL(faderL);
+	_channelStates[index].faderL = faderL;
+	postCommand(Command::kFaderL, index, handle._val, faderL);
 }
 
 uint8 MixerImpl::getChannelFaderL(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getFaderL();
+	return _channelStates[index].faderL;
 }
 
 void MixerImpl::setChannelFaderR(SoundHandle handle, uint8 faderR) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setFaderR(faderR);
+	_channelStates[index].faderR = faderR;
+	postCommand(Command::kFaderR, index, handle._val, faderR);
 }
 
 uint8 MixerImpl::getChannelFaderR(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getFaderR();
+	return _channelStates[index].faderR;
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->setRate(rate);
+	_channelStates[index].rate = rate;
+	postCommand(Command::kRate, index, handle._val, rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return 0;
 
-	return _channels[index]->getRate();
+	return _channelStates[index].rate;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->resetRate();
+	_channelStates[index].rate = _channelStates[index].streamRate.load();
+	postCommand(Command::kResetRate, index, handle._val);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -520,91 +704,118 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Timestamp ts(0, _sampleRate);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	const int index = findSlot(handle);
+	if (index == -1)
+		return ts;
+
+	// A queued pause must already stop the clock
+	flushCommands(index);
+
+	// Take a consistent snapshot of the timing published by the mixing thread
+	const ChannelState &state = _channelStates[index];
+	uint32 seq, timingHandle, samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime;
+	bool paused;
+	do {
+		seq = state.timingSeq;
+		timingHandle = state.timingHandle;
+		samplesConsumed = state.samplesConsumed;
+		mixerTimeStamp = state.mixerTimeStamp;
+		pauseStartTime = state.pauseStartTime;
+		pauseTime = state.pauseTime;
+		paused = state.paused;
+	} while ((seq & 1) || seq != state.timingSeq);
+
+	// The mixing thread has not picked up the sound yet
+	if (timingHandle != handle._val || mixerTimeStamp == 0)
+		return ts;
+
+	uint32 delta;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
 
-	return _channels[index]->getElapsedTime();
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
+
+	return ts;
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->loop();
+	postCommand(Command::kLoop, index, handle._val);
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr) {
-			_channels[i]->pause(paused);
-		}
+		const uint32 handle = _channelStates[i].handle.load(std::memory_order_acquire);
+		if (handle < kReservedSlot)
+			postCommand(Command::kPause, i, handle, paused);
 	}
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
+		const uint32 handle = _channelStates[i].handle.load(std::memory_order_acquire);
+		if (handle < kReservedSlot && _channelStates[i].id == id) {
+			postCommand(Command::kPause, i, handle, paused);
 			return;
 		}
 	}
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const int index = findSlot(handle);
+	if (index == -1)
 		return;
 
-	_channels[index]->pause(paused);
+	postCommand(Command::kPause, index, handle._val, paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channelStates[i].handle.load(std::memory_order_acquire) < kReservedSlot && _channelStates[i].id == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
-	return 0;
+	const int index = findSlot(handle);
+	if (index == -1)
+		return 0;
+
+	return _channelStates[index].id;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return findSlot(handle) != -1;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channelStates[i].handle.load(std::memory_order_acquire) < kReservedSlot && _channelStates[i].type == type)
 			return true;
 	return false;
 }
@@ -618,13 +829,9 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
 	_soundTypeSettings[type].volume = volume;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	postCommand(Command::kSoundTypeChanged, 0, kFreeSlot, type);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
@@ -660,7 +867,7 @@ void Channel::setVolume(const byte volume) {
 	updateChannelVolumes();
 }
 
-byte Channel::getVolume() {
+byte Channel::getVolume() const {
 	return _volume;
 }
 
@@ -669,7 +876,7 @@ void Channel::setBalance(const int8 balance) {
 	updateChannelVolumes();
 }
 
-int8 Channel::getBalance() {
+int8 Channel::getBalance() const {
 	return _balance;
 }
 
@@ -678,7 +885,7 @@ void Channel::setFaderL(uint8 faderL) {
 	updateChannelVolumes();
 }
 
-uint8 Channel::getFaderL() {
+uint8 Channel::getFaderL() const {
 	return _faderL;
 }
 
@@ -687,7 +894,7 @@ void Channel::setFaderR(uint8 faderR) {
 	updateChannelVolumes();
 }
 
-uint8 Channel::getFaderR() {
+uint8 Channel::getFaderR() const {
 	return _faderR;
 }
 
@@ -696,7 +903,7 @@ void Channel::setRate(uint32 rate) {
 		_converter->setInputRate(rate);
 }
 
-uint32 Channel::getRate() {
+uint32 Channel::getRate() const {
 	if (_converter)
 		return _converter->getInputRate();
 
@@ -738,52 +945,24 @@ void Channel::updateChannelVolumes() {
 	}
 }
 
-void Channel::pause(bool paused) {
+void Channel::pause(bool paused, uint32 millis) {
 	//assert((paused && _pauseLevel >= 0) || (!paused && _pauseLevel));
 
 	if (paused) {
 		_pauseLevel++;
 
 		if (_pauseLevel == 1)
-			_pauseStartTime = g_system->getMillis(true);
+			_pauseStartTime = millis;
 	} else if (_pauseLevel > 0) {
 		_pauseLevel--;
 
 		if (!_pauseLevel) {
-			_pauseTime = (g_system->getMillis(true) - _pauseStartTime);
+			_pauseTime = (millis - _pauseStartTime);
 			_pauseStartTime = 0;
 		}
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
-
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
-
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
-
-	return ts;
-}
-
 void Channel::loop() {
 	assert(_stream);
 
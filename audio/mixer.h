@@ -105,6 +105,12 @@ public:
 
 	/**
 	 * Return the mixer's internal mutex so that audio players can use it.
+	 *
+	 * The mutex is held while the streams are being mixed, so it can be used
+	 * to synchronize with the mixing thread. Apart from the stop calls, which
+	 * delete the stopped streams before returning, the Mixer methods do not
+	 * take it: they queue their requests for the mixing thread and answer
+	 * queries from atomically published channel state.
 	 */
 	virtual Common::Mutex &mutex() = 0;
 
@@ -178,6 +184,9 @@ public:
 	/**
 	 * Pause or unpause the sound corresponding to the given handle.
 	 *
+	 * The sound is paused by the next mix, but getElapsedTime() already
+	 * accounts for the request when this returns.
+	 *
 	 * @param handle  The sound to pause or unpause.
 	 * @param paused  True to pause the sound, false to unpause it.
 	 */
@@ -324,11 +333,17 @@ public:
 
 	/**
 	 * Get an approximation of for how long the channel has been playing.
+	 *
+	 * @see getElapsedTime
 	 */
 	virtual uint32 getSoundElapsedTime(SoundHandle handle) = 0;
 
 	/**
 	 * Get an approximation of for how long the channel has been playing.
+	 *
+	 * Pause requests made before the call are taken into account, even if
+	 * the mixer has not run since. If some requests for the sound are still
+	 * queued, this waits for a mix in progress to apply them.
 	 */
 	virtual Timestamp getElapsedTime(SoundHandle handle) = 0;
 
@@ -26,6 +26,8 @@
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
+#include <atomic>
+
 namespace Audio {
 
 /**
@@ -58,26 +60,118 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	/**
+	 * A request from the engine side, applied by the mixing thread at the
+	 * start of the next mixCallback().
+	 */
+	struct Command {
+		enum Type {
+			kPlay,
+			kPause,
+			kVolume,
+			kBalance,
+			kFaderL,
+			kFaderR,
+			kRate,
+			kResetRate,
+			kLoop,
+			kSoundTypeChanged
+		};
+
+		Type type;
+		int index;
+		uint32 handle;
+		Channel *channel;
+		int32 value;
+		uint32 millis;
+	};
+
+	/**
+	 * Bounded multi-producer, single-consumer command queue. Each cell
+	 * carries a sequence number telling whether it is free for the producer
+	 * or filled for the consumer, so neither side ever takes a lock.
+	 */
+	class CommandQueue {
+	public:
+		CommandQueue();
+
+		bool push(const Command &cmd);
+		bool pop(Command &cmd);
+
+	private:
+		struct Cell {
+			std::atomic<uint32> sequence;
+			Command command;
+		};
+
+		Cell _cells[COMMAND_QUEUE_SIZE];
+		std::atomic<uint32> _writePos;
+		uint32 _readPos;
+	};
+
+	/**
+	 * State of a channel slot, published with atomics so that handle and
+	 * parameter queries can be answered without touching the channel.
+	 *
+	 * The timing fields are only written by the mixing thread and guarded by
+	 * a sequence counter: readers retry if it changed or is odd.
+	 */
+	struct ChannelState {
+		ChannelState() : handle(kFreeSlot), id(-1), type(kPlainSoundType), permanent(false),
+			volume(0), balance(0), faderL(0), faderR(0), rate(0), streamRate(0),
+			pendingCommands(0), timingSeq(0), timingHandle(kFreeSlot), samplesConsumed(0), mixerTimeStamp(0), pauseStartTime(0), pauseTime(0), paused(false) {}
+
+		std::atomic<uint32> handle;
+		std::atomic<int> id;
+		std::atomic<int> type;
+		std::atomic<bool> permanent;
+		std::atomic<byte> volume;
+		std::atomic<int8> balance;
+		std::atomic<uint8> faderL;
+		std::atomic<uint8> faderR;
+		std::atomic<uint32> rate;
+		std::atomic<uint32> streamRate;
+
+		/** Number of queued commands for this slot. */
+		std::atomic<uint32> pendingCommands;
+
+		std::atomic<uint32> timingSeq;
+		std::atomic<uint32> timingHandle;
+		std::atomic<uint32> samplesConsumed;
+		std::atomic<uint32> mixerTimeStamp;
+		std::atomic<uint32> pauseStartTime;
+		std::atomic<uint32> pauseTime;
+		std::atomic<bool> paused;
 	};
 
+	static const uint32 kFreeSlot = 0xffffffff;
+	static const uint32 kReservedSlot = 0xfffffffe;
+
 	Common::Mutex _mutex;
 
 	const uint _sampleRate;
 	const bool _stereo;
 	uint _outBufSize;
-	bool _mixerReady;
-	uint32 _handleSeed;
+	std::atomic<bool> _mixerReady;
+	std::atomic<uint32> _handleSeed;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		std::atomic<bool> mute;
+		std::atomic<int> volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
+
+	/** Owned by the mixing thread; only touched with _mutex held. */
 	Channel *_channels[NUM_CHANNELS];
+	ChannelState _channelStates[NUM_CHANNELS];
+	CommandQueue _commands;
 
 
 public:
@@ -85,7 +179,7 @@ public:
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
 
-	bool isReady() const override { Common::StackLock lock(_mutex); return _mixerReady; }
+	bool isReady() const override { return _mixerReady; }
 
 	Common::Mutex &mutex() override { return _mutex; }
 
@@ -143,6 +237,34 @@ public:
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+private:
+	/** Return the slot index of handle if it is still playing, or -1. */
+	int findSlot(SoundHandle handle) const;
+
+	/** Mark the sound in slot index as stopped, if it still has the given handle. */
+	bool releaseSlot(int index, uint32 handle);
+
+	void postCommand(Command::Type type, int index, uint32 handle, int32 value = 0, Channel *channel = nullptr);
+
+	/**
+	 * Release the slot of the sound with the given handle and delete its
+	 * channel right away, so that its stream is gone once the stop call
+	 * returns. Must be called with _mutex held.
+	 */
+	void stopChannel(int index, uint32 handle);
+
+	/** Apply queued commands. Must be called with _mutex held. */
+	void processCommands();
+
+	/**
+	 * Apply the queued commands right away if some are for the sound in
+	 * slot index, so that its published state is up to date.
+	 */
+	void flushCommands(int index);
+
+	/** Copy the timing of the channel in slot index to its published state. */
+	void publishTiming(int index);
+
 public:
 	/**
 	 * Adjust the output buffer size
@@ -29,9 +29,20 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
+#include "common/config-manager.h"
+#include "common/jobsystem.h"
+#include "common/system.h"
 #include "common/util.h"
 
+#include <math.h>
+
+namespace Common {
+DECLARE_SINGLETON(Audio::SincFilterManager);
+}
+
 namespace Audio {
 
 /**
@@ -45,6 +56,198 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Number of resampled frames gathered before they are handed over to the
+ * volume and saturation stage.
+ */
+enum {
+	STAGE_FRAMES = 256
+};
+
+/**
+ * Limits of the windowed-sinc converter. Ratios needing more phases than
+ * SINC_PHASES use the nearest lower phase.
+ */
+enum {
+	SINC_PHASES = 512,
+	SINC_MAX_TAPS = 128,
+	SINC_HISTORY_FRAMES = 512
+};
+
+/** Passband of the sinc filters, relative to the lower Nyquist frequency */
+static const double SINC_ROLLOFF = 0.92;
+
+/** Kaiser window shape parameter, trading transition width for stopband attenuation */
+static const double SINC_KAISER_BETA = 8.0;
+
+RateMixer::MixFunc RateMixer::mixFunc = nullptr;
+
+void RateMixer::selectMixFunc() {
+	mixFunc = mixGeneric;
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) mixFunc = mixNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) mixFunc = mixSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) mixFunc = mixAVX2;
+#endif
+#endif
+}
+
+void RateMixer::mixGeneric(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo) {
+	for (uint i = 0; i < frames; i++) {
+		st_sample_t inL, inR;
+		inL = *in++;
+		inR = (inStereo ? *in++ : inL);
+
+		// The division truncates towards zero, which the SIMD versions
+		// have to reproduce
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		// Output left channel
+		clampedAdd(out[reverseStereo    ], outL);
+
+		// Output right channel
+		clampedAdd(out[reverseStereo ^ 1], outR);
+
+		out += 2;
+	}
+}
+
+void RateMixer::mixMono(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo) {
+	for (uint i = 0; i < frames; i++) {
+		st_sample_t inL, inR;
+		inL = *in++;
+		inR = (inStereo ? *in++ : inL);
+
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		// Output mono channel
+		clampedAdd(out[0], (outL + outR) / 2);
+
+		out += 1;
+	}
+}
+
+RateFilter::DotFunc RateFilter::dotFunc = nullptr;
+
+void RateFilter::selectDotFunc() {
+	dotFunc = dotGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) dotFunc = dotNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) dotFunc = dotSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) dotFunc = dotAVX2;
+#endif
+}
+
+int32 RateFilter::dotGeneric(const int16 *samples, const int16 *coefs, uint taps) {
+	int32 sum = 0;
+	for (uint i = 0; i < taps; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+}
+
+/** Modified Bessel function of the first kind, as used by the Kaiser window */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 64 && term > sum * 1e-12; k++) {
+		term *= (x / 2.0) / k;
+		sum += term * term;
+	}
+	return sum;
+}
+
+static void initSincFilterBank(SincFilterBank &bank, uint phases, uint taps, double cutoff) {
+	bank.phases = phases;
+	bank.taps = taps;
+	bank.coefs.resize(phases * taps);
+
+	const double halfWidth = taps / 2;
+	const double windowScale = 1.0 / besselI0(SINC_KAISER_BETA);
+	double values[SINC_MAX_TAPS];
+
+	for (uint p = 0; p < phases; p++) {
+		// Tap k of phase p weighs the input sample that lies
+		// halfWidth - 1 - k + p / phases samples before the output
+		const double frac = (double)p / phases;
+		double sum = 0.0;
+
+		for (uint k = 0; k < taps; k++) {
+			const double x = frac + halfWidth - 1 - k;
+			const double r = x / halfWidth;
+			const double window = (r > -1.0 && r < 1.0) ? besselI0(SINC_KAISER_BETA * sqrt(1.0 - r * r)) * windowScale : 0.0;
+			const double y = M_PI * cutoff * x;
+			const double sinc = (x == 0.0) ? 1.0 : sin(y) / y;
+
+			values[k] = cutoff * sinc * window;
+			sum += values[k];
+		}
+
+		// Normalize every phase to unity gain, and give the rounding error
+		// to its largest tap
+		int16 *coefs = &bank.coefs[p * taps];
+		int total = 0;
+		uint largest = 0;
+		for (uint k = 0; k < taps; k++) {
+			coefs[k] = (int16)CLIP<int>((int)floor(values[k] / sum * 32768.0 + 0.5), -32767, 32767);
+			total += coefs[k];
+			if (ABS(coefs[k]) > ABS(coefs[largest]))
+				largest = k;
+		}
+		coefs[largest] = (int16)CLIP<int>(coefs[largest] + 32768 - total, -32767, 32767);
+	}
+}
+
+const SincFilterBank *SincFilterBankSet::select(uint inStep, uint outStep) const {
+	// Ratios below the lowest cutoff alias a little
+	uint level = 0;
+	while (level < kLevels - 1 && cutoffs[level] * inStep > outStep)
+		level++;
+	return &banks[level];
+}
+
+SincFilterManager::~SincFilterManager() {
+	for (FilterBankMap::iterator i = _filterBanks.begin(); i != _filterBanks.end(); ++i)
+		delete i->_value;
+}
+
+const SincFilterBankSet *SincFilterManager::getFilterBanks(uint taps) {
+	assert(taps <= SINC_MAX_TAPS && (taps % 8) == 0);
+
+	Common::StackLock lock(_mutex);
+
+	FilterBankMap::iterator i = _filterBanks.find(taps);
+	if (i != _filterBanks.end())
+		return i->_value;
+
+	SincFilterBankSet *set = new SincFilterBankSet();
+	for (uint level = 0; level < SincFilterBankSet::kLevels; level++)
+		set->cutoffs[level] = pow(2.0, level / -4.0);
+
+	JobMan.parallelFor(0, SincFilterBankSet::kLevels, 1, [&](int firstLevel, int lastLevel) {
+		for (int level = firstLevel; level < lastLevel; level++) {
+			// Lower cutoff frequencies need proportionally longer filters for
+			// the same transition band
+			const uint levelTaps = MIN<uint>(SINC_MAX_TAPS, taps * (uint)ceil(1.0 / set->cutoffs[level] - 1e-6));
+			initSincFilterBank(set->banks[level], SINC_PHASES, levelTaps, SINC_ROLLOFF * set->cutoffs[level]);
+		}
+	});
+
+	_filterBanks[taps] = set;
+	return set;
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -76,6 +279,17 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
+	/** Resampled frames waiting for the volume stage */
+	st_sample_t _stage[STAGE_FRAMES * (inStereo ? 2 : 1)];
+
+	/** Apply the volume to frames input frames and add them to the output buffer */
+	static void mixFrames(st_sample_t *outBuffer, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR) {
+		if (outStereo)
+			RateMixer::mix(outBuffer, in, frames, volL, volR, inStereo, reverseStereo);
+		else
+			RateMixer::mixMono(outBuffer, in, frames, volL, volR, inStereo);
+	}
+
 	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
@@ -112,30 +326,13 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
-		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+		// Mix as much of the buffer as fits into the output buffer
+		const uint frames = MIN<uint>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		mixFrames(outBuffer, _bufferPos, frames, volL, volR);
 
-			outBuffer += 1;
-		}
+		_bufferPos += frames * (inStereo ? 2 : 1);
+		_bufferSize -= frames * (inStereo ? 2 : 1);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -152,50 +349,52 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
 	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
-			}
+		// Gather the selected input frames, then mix them in one go
+		const uint maxFrames = MIN<uint>(STAGE_FRAMES, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *stagePos = _stage;
+		uint frames = 0;
+		bool inputDone = false;
+
+		while (frames < maxFrames) {
+			// Read enough input samples so that _outPos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						inputDone = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_outPos--;
+
+				if (_outPos >= 0) {
+					_bufferPos += (inStereo ? 2 : 1);
+				}
+			} while (_outPos >= 0);
+
+			if (inputDone)
+				break;
+
+			*stagePos++ = *_bufferPos++;
+			if (inStereo)
+				*stagePos++ = *_bufferPos++;
 
-			_bufferSize -= (inStereo ? 2 : 1);
-			_outPos--;
-
-			if (_outPos >= 0) {
-				_bufferPos += (inStereo ? 2 : 1);
-			}
-		} while (_outPos >= 0);
-
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-
-		// Increment output position
-		_outPos += outPos_inc;
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+			// Increment output position
+			_outPos += outPos_inc;
 
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			frames++;
+		}
 
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+		mixFrames(outBuffer, _stage, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
 
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		if (inputDone)
+			break;
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -210,61 +409,61 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
 	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPosFrac < 0
-		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+		// Gather the interpolated frames, then mix them in one go
+		const uint maxFrames = MIN<uint>(STAGE_FRAMES, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *stagePos = _stage;
+		uint frames = 0;
+		bool inputDone = false;
+
+		while (frames < maxFrames) {
+			// Read enough input samples so that _outPosFrac < 0
+			while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						inputDone = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_inLastL = _inCurL;
+				_inCurL = *_bufferPos++;
+
+				if (inStereo) {
+					_inLastR = _inCurR;
+					_inCurR = *_bufferPos++;
+				}
+
+				_outPosFrac -= FRAC_ONE_LOW;
 			}
 
-			_bufferSize -= (inStereo ? 2 : 1);
-			_inLastL = _inCurL;
-			_inCurL = *_bufferPos++;
+			if (inputDone)
+				break;
 
-			if (inStereo) {
-				_inLastR = _inCurR;
-				_inCurR = *_bufferPos++;
-			}
+			// Loop as long as the _outPos trails behind, and as long as there is
+			// still space in the stage buffer.
+			while (_outPosFrac < (frac_t)FRAC_ONE_LOW && frames < maxFrames) {
+				// Interpolate
+				*stagePos++ = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (inStereo)
+					*stagePos++ = (st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			_outPosFrac -= FRAC_ONE_LOW;
-		}
+				// Increment output position
+				_outPosFrac += outPos_inc;
 
-		// Loop as long as the _outPos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
-			// Interpolate
-			st_sample_t inL, inR;
-			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			inR = (inStereo ?
-						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						inL);
-
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
+				frames++;
 			}
-
-			// Increment output position
-			_outPosFrac += outPos_inc;
 		}
+
+		mixFrames(outBuffer, _stage, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
+
+		if (inputDone)
+			break;
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -297,20 +496,286 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
+/**
+ * Polyphase windowed-sinc converter, used for the higher resampling qualities.
+ *
+ * The input is kept in a per channel history, and each output frame is the
+ * dot product of a window of that history with the filter phase matching
+ * its fractional position. The input and output rates are reduced to a
+ * ratio of two coprime steps, so the position is tracked exactly.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+private:
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** Rates the current filter bank was set up for */
+	st_rate_t _filterInRate, _filterOutRate;
+
+	/** The shared filter banks of the selected quality */
+	const SincFilterBankSet *_filterBanks;
+
+	/** The filter bank matching the current rates */
+	const SincFilterBank *_filterBank;
+
+	/** Number of taps of the current filter bank */
+	uint _taps;
+
+	/** Reduced rate ratio: _inStep input frames for every _outStep output frames */
+	uint _inStep, _outStep;
+
+	/** Position of the next output frame between two input frames, in 1/_outStep units */
+	uint _phase;
+
+	/** The intermediate input cache */
+	st_sample_t _buffer[512];
+
+	/** Current position inside the buffer */
+	const st_sample_t *_bufferPos;
+
+	/** Size of data currently loaded into the buffer */
+	int _bufferSize;
+
+	/** Deinterleaved input history, with room for the end of stream padding */
+	st_sample_t _history[inStereo ? 2 : 1][SINC_HISTORY_FRAMES + SINC_MAX_TAPS / 2];
+
+	/** Start of the window of the next output frame, and number of frames in the history */
+	uint _histPos, _histLen;
+
+	/** Input frames to drop because the position moved past the history */
+	uint _skip;
+
+	/** Whether the history was padded with silence after the end of the input */
+	bool _padded;
+
+	/** Resampled frames waiting for the volume stage */
+	st_sample_t _stage[STAGE_FRAMES * (inStereo ? 2 : 1)];
+
+	void setupFilter();
+	bool fillHistory(AudioStream &input);
+
+	static st_sample_t applyPhase(const st_sample_t *samples, const int16 *coefs, uint taps) {
+		const int32 sum = (RateFilter::dot(samples, coefs, taps) + (1 << 14)) >> 15;
+		return (st_sample_t)CLIP<int32>(sum, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+public:
+	SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, uint taps);
+	virtual ~SincRateConverter() {}
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override {
+		return _bufferSize != 0 || _histPos + _taps <= _histLen || (!_padded && _histPos < _histLen);
+	}
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter<inStereo, outStereo, reverseStereo>::SincRateConverter(st_rate_t inputRate, st_rate_t outputRate, uint taps) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_filterInRate(0),
+	_filterOutRate(0),
+	_filterBanks(SincFilterManager::instance().getFilterBanks(taps)),
+	_filterBank(nullptr),
+	_taps(0),
+	_inStep(1),
+	_outStep(1),
+	_phase(0),
+	_bufferPos(nullptr),
+	_bufferSize(0),
+	_histPos(0),
+	_histLen(0),
+	_skip(0),
+	_padded(false) {
+	setupFilter();
+
+	// Start with half a window of silence, so that the first output frame
+	// lines up with the first input frame
+	_histLen = _taps / 2 - 1;
+	for (uint c = 0; c < ARRAYSIZE(_history); c++)
+		memset(_history[c], 0, _histLen * sizeof(st_sample_t));
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::setupFilter() {
+	const st_rate_t div = Common::gcd(_inRate, _outRate);
+	_inStep = _inRate / div;
+	_outStep = _outRate / div;
+	_phase = 0;
+
+	// This runs on the mixing thread when the rate changes, so it only
+	// picks one of the banks computed up front
+	_filterBank = _filterBanks->select(_inStep, _outStep);
+	const uint taps = _filterBank->taps;
+
+	// Keep the window centered on the same input frame when its size changes
+	if (_taps != 0 && taps != _taps)
+		_histPos = (uint)MAX<int>((int)_histPos + ((int)_taps - (int)taps) / 2, 0);
+	_taps = taps;
+
+	_filterInRate = _inRate;
+	_filterOutRate = _outRate;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+bool SincRateConverter<inStereo, outStereo, reverseStereo>::fillHistory(AudioStream &input) {
+	// Drop the frames that no window uses anymore
+	if (_histPos >= _histLen) {
+		_skip += _histPos - _histLen;
+		_histLen = 0;
+	} else if (_histPos > 0) {
+		_histLen -= _histPos;
+		for (uint c = 0; c < ARRAYSIZE(_history); c++)
+			memmove(_history[c], _history[c] + _histPos, _histLen * sizeof(st_sample_t));
+	}
+	_histPos = 0;
+
+	while (_histLen < SINC_HISTORY_FRAMES) {
+		// Check if we have to refill the buffer
+		if (_bufferSize == 0) {
+			_bufferPos = _buffer;
+			_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+			if (_bufferSize <= 0) {
+				_bufferSize = 0;
+
+				// Flush the frames still held back by the filter delay
+				if (!_padded && input.endOfData()) {
+					for (uint c = 0; c < ARRAYSIZE(_history); c++)
+						memset(_history[c] + _histLen, 0, _taps / 2 * sizeof(st_sample_t));
+					_histLen += _taps / 2;
+					_padded = true;
+				}
+				break;
+			}
+
+			_padded = false;
+		}
+
+		uint frames = _bufferSize / (inStereo ? 2 : 1);
+		if (_skip) {
+			frames = MIN(frames, _skip);
+			_skip -= frames;
+		} else {
+			frames = MIN<uint>(frames, SINC_HISTORY_FRAMES - _histLen);
+			for (uint i = 0; i < frames; i++) {
+				_history[0][_histLen + i] = _bufferPos[i * (inStereo ? 2 : 1)];
+				if (inStereo)
+					_history[inStereo ? 1 : 0][_histLen + i] = _bufferPos[i * 2 + 1];
+			}
+			_histLen += frames;
+		}
+
+		_bufferPos += frames * (inStereo ? 2 : 1);
+		_bufferSize -= frames * (inStereo ? 2 : 1);
+	}
+
+	return _histPos + _taps <= _histLen;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	assert(input.isStereo() == inStereo);
+
+	if (_inRate != _filterInRate || _outRate != _filterOutRate)
+		setupFilter();
+
+	const SincFilterBank *bank = _filterBank;
+	const bool exactPhases = (bank->phases == _outStep);
+
+	st_sample_t *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		// Gather the filtered frames, then mix them in one go
+		const uint maxFrames = MIN<uint>(STAGE_FRAMES, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *stagePos = _stage;
+		uint frames = 0;
+		bool inputDone = false;
+
+		while (frames < maxFrames) {
+			if (_histPos + _taps > _histLen && !fillHistory(input)) {
+				inputDone = true;
+				break;
+			}
+
+			const int16 *coefs = bank->getPhase(exactPhases ? _phase : (uint)((uint64)_phase * bank->phases / _outStep));
+			*stagePos++ = applyPhase(_history[0] + _histPos, coefs, _taps);
+			if (inStereo)
+				*stagePos++ = applyPhase(_history[inStereo ? 1 : 0] + _histPos, coefs, _taps);
+
+			// Increment output position
+			_phase += _inStep;
+			while (_phase >= _outStep) {
+				_phase -= _outStep;
+				_histPos++;
+			}
+
+			frames++;
+		}
+
+		if (outStereo)
+			RateMixer::mix(outBuffer, _stage, frames, volL, volR, inStereo, reverseStereo);
+		else
+			RateMixer::mixMono(outBuffer, _stage, frames, volL, volR, inStereo);
+		outBuffer += frames * (outStereo ? 2 : 1);
+
+		if (inputDone)
+			break;
+	}
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+/**
+ * Number of taps of the windowed-sinc filters for the configured
+ * resampling quality, or 0 for the linear interpolating converters.
+ */
+static uint getSincTaps() {
+	if (ConfMan.hasKey("resampling_quality")) {
+		switch (ConfMan.getInt("resampling_quality")) {
+		case 1:
+			return 16;
+		case 2:
+			return 32;
+		default:
+			break;
+		}
+	}
+	return 0;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateConverter *makeConverter(st_rate_t inRate, st_rate_t outRate, uint sincTaps) {
+	if (sincTaps && inRate != outRate)
+		return new SincRateConverter<inStereo, outStereo, reverseStereo>(inRate, outRate, sincTaps);
+	return new RateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+}
+
 RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+	const uint sincTaps = getSincTaps();
+
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return makeConverter<true, true, true>(inRate, outRate, sincTaps);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return makeConverter<true, true, false>(inRate, outRate, sincTaps);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return makeConverter<true, false, false>(inRate, outRate, sincTaps);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return makeConverter<false, true, false>(inRate, outRate, sincTaps);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return makeConverter<false, false, false>(inRate, outRate, sincTaps);
 	}
 }
 
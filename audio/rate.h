@@ -23,6 +23,9 @@
 #define AUDIO_RATE_H
 
 #include "common/frac.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
 
 namespace Audio {
 /**
@@ -104,8 +107,46 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
+/**
+ * Create a rate converter for the given stream layout and rates.
+ *
+ * When the rates differ and the "resampling_quality" config key is set to 1
+ * or 2, a windowed-sinc converter is returned instead of the default linear
+ * interpolating one, at the cost of more CPU time.
+ */
 RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
 
+struct SincFilterBankSet;
+
+/**
+ * Keeps the coefficient tables of the windowed-sinc rate converters, so that
+ * all channels of a resampling quality share them.
+ */
+class SincFilterManager : public Common::Singleton<SincFilterManager> {
+public:
+	/**
+	 * Return the filter banks of the quality using the given number of taps
+	 * when upsampling, computing all of them the first time. They stay valid
+	 * until the manager is destroyed, and are only read afterwards, so the
+	 * mixing thread may use them without locking.
+	 *
+	 * This is called when a converter is created, which the mixing thread
+	 * never does.
+	 *
+	 * @param taps  Number of taps when upsampling, a multiple of 8.
+	 */
+	const SincFilterBankSet *getFilterBanks(uint taps);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	SincFilterManager() {}
+	~SincFilterManager();
+
+	typedef Common::HashMap<uint, SincFilterBankSet *> FilterBankMap;
+	FilterBankMap _filterBanks;
+	Common::Mutex _mutex;
+};
+
 /** @} */
 } // End of namespace Audio
 
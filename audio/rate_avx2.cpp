@@ -0,0 +1,114 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "audio/rate_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Audio {
+
+/**
+ * Multiply sixteen samples by their volumes and divide by kMaxMixerVolume,
+ * truncating towards zero like the generic code does.
+ */
+static FORCEINLINE __m256i avx2_applyVolume(__m256i samples, __m256i volumes) {
+	const __m256i lo = _mm256_mullo_epi16(samples, volumes);
+	const __m256i hi = _mm256_mulhi_epi16(samples, volumes);
+	// Unpacking and packing both work per 128-bit lane, so the order is kept
+	__m256i a = _mm256_unpacklo_epi16(lo, hi);
+	__m256i b = _mm256_unpackhi_epi16(lo, hi);
+
+	// Add 255 to negative products before shifting
+	a = _mm256_srai_epi32(_mm256_add_epi32(a, _mm256_srli_epi32(_mm256_srai_epi32(a, 31), 24)), 8);
+	b = _mm256_srai_epi32(_mm256_add_epi32(b, _mm256_srli_epi32(_mm256_srai_epi32(b, 31), 24)), 8);
+	return _mm256_packs_epi32(a, b);
+}
+
+void RateMixer::mixAVX2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo) {
+	// With reversed stereo, the left input goes to the right output, so the
+	// input pairs are swapped and the volumes follow them
+	const __m256i volumes = reverseStereo ?
+		_mm256_set1_epi32((volL << 16) | volR) :
+		_mm256_set1_epi32((volR << 16) | volL);
+
+	uint i = 0;
+	if (inStereo) {
+		for (; i + 8 <= frames; i += 8) {
+			__m256i samples = _mm256_loadu_si256((const __m256i *)in);
+			if (reverseStereo)
+				samples = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+
+			__m256i dst = _mm256_loadu_si256((const __m256i *)out);
+			_mm256_storeu_si256((__m256i *)out, _mm256_adds_epi16(dst, avx2_applyVolume(samples, volumes)));
+
+			in += 16;
+			out += 16;
+		}
+	} else {
+		for (; i + 8 <= frames; i += 8) {
+			__m256i samples = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)in));
+			// Duplicate each mono sample into the high half of its 32-bit pair
+			samples = _mm256_or_si256(samples, _mm256_slli_epi32(samples, 16));
+
+			__m256i dst = _mm256_loadu_si256((const __m256i *)out);
+			_mm256_storeu_si256((__m256i *)out, _mm256_adds_epi16(dst, avx2_applyVolume(samples, volumes)));
+
+			in += 8;
+			out += 16;
+		}
+	}
+
+	mixGeneric(out, in, frames - i, volL, volR, inStereo, reverseStereo);
+}
+
+int32 RateFilter::dotAVX2(const int16 *samples, const int16 *coefs, uint taps) {
+	__m256i sum = _mm256_setzero_si256();
+	uint i = 0;
+	for (; i + 16 <= taps; i += 16) {
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(samples + i)), _mm256_loadu_si256((const __m256i *)(coefs + i))));
+	}
+
+	__m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	if (i < taps)
+		sum128 = _mm_add_epi32(sum128, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(samples + i)), _mm_loadu_si128((const __m128i *)(coefs + i))));
+
+	sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum128);
+}
+
+} // End of namespace Audio
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,145 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "audio/rate.h"
+#include "common/array.h"
+
+namespace Audio {
+
+/**
+ * Volume and saturation stage shared by the rate converters.
+ *
+ * Each function scales a block of sample frames by the channel volume and
+ * adds it, with saturation, to a stereo output buffer. The SIMD variants
+ * are selected at runtime and produce exactly the same output as the
+ * generic ones.
+ */
+class RateMixer {
+public:
+	/**
+	 * @param out          Stereo output buffer, frames * 2 samples.
+	 * @param in           Input samples, frames * 2 for stereo input, frames for mono input.
+	 * @param frames       Number of sample frames to mix.
+	 * @param volL         Left channel volume, 0 - Mixer::kMaxMixerVolume.
+	 * @param volR         Right channel volume, 0 - Mixer::kMaxMixerVolume.
+	 * @param inStereo     Whether the input samples are interleaved stereo.
+	 * @param reverseStereo Whether to swap the left and right channels of stereo input.
+	 */
+	typedef void(*MixFunc)(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo);
+
+	static void mix(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo) {
+		if (!mixFunc)
+			selectMixFunc();
+		mixFunc(out, in, frames, volL, volR, inStereo, reverseStereo);
+	}
+
+	/** Scalar variant for mono output, which has no SIMD version. */
+	static void mixMono(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo);
+
+	static void selectMixFunc();
+
+	static MixFunc mixFunc;
+
+	static void mixGeneric(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo);
+#ifdef SCUMMVM_NEON
+	static void mixNEON(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void mixSSE2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void mixAVX2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo);
+#endif
+};
+
+/**
+ * Coefficients of a windowed-sinc filter, split into phases. Each phase
+ * holds the taps used for output samples at one fractional position
+ * between two input samples, in 1.15 fixed point.
+ */
+struct SincFilterBank {
+	uint phases;
+	uint taps;
+	Common::Array<int16> coefs;
+
+	const int16 *getPhase(uint phase) const { return &coefs[phase * taps]; }
+};
+
+/**
+ * The filter banks of one resampling quality, for a fixed set of cutoff
+ * frequencies a quarter octave apart. A converter uses the highest cutoff
+ * that does not exceed its rate ratio, so changing the rate never has to
+ * compute a new bank.
+ */
+struct SincFilterBankSet {
+	enum {
+		kLevels = 17
+	};
+
+	double cutoffs[kLevels];
+	SincFilterBank banks[kLevels];
+
+	const SincFilterBank *select(uint inStep, uint outStep) const;
+};
+
+/**
+ * Dot product used by the windowed-sinc converters to apply one filter
+ * phase. The SIMD variants are selected at runtime and return exactly the
+ * same sums as the generic one.
+ */
+class RateFilter {
+public:
+	/**
+	 * @param samples  Input samples, taps entries.
+	 * @param coefs    Filter coefficients, taps entries.
+	 * @param taps     Number of taps, a multiple of 8.
+	 */
+	typedef int32(*DotFunc)(const int16 *samples, const int16 *coefs, uint taps);
+
+	static int32 dot(const int16 *samples, const int16 *coefs, uint taps) {
+		if (!dotFunc)
+			selectDotFunc();
+		return dotFunc(samples, coefs, taps);
+	}
+
+	static void selectDotFunc();
+
+	static DotFunc dotFunc;
+
+	static int32 dotGeneric(const int16 *samples, const int16 *coefs, uint taps);
+#ifdef SCUMMVM_NEON
+	static int32 dotNEON(const int16 *samples, const int16 *coefs, uint taps);
+#endif
+#ifdef SCUMMVM_SSE2
+	static int32 dotSSE2(const int16 *samples, const int16 *coefs, uint taps);
+#endif
+#ifdef SCUMMVM_AVX2
+	static int32 dotAVX2(const int16 *samples, const int16 *coefs, uint taps);
+#endif
+};
+
+} // End of namespace Audio
+
+#endif
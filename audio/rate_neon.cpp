@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/rate_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+/**
+ * Multiply four samples by their volumes and divide by kMaxMixerVolume,
+ * truncating towards zero like the generic code does.
+ */
+static inline int16x4_t neon_applyVolume(int16x4_t samples, int16x4_t volumes) {
+	int32x4_t products = vmull_s16(samples, volumes);
+
+	// Add 255 to negative products before shifting
+	products = vaddq_s32(products, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(products, 31)), 24)));
+	return vmovn_s32(vshrq_n_s32(products, 8));
+}
+
+void RateMixer::mixNEON(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo) {
+	// With reversed stereo, the left input goes to the right output, so the
+	// input pairs are swapped and the volumes follow them
+	const int16 volPair[4] = {
+		(int16)(reverseStereo ? volR : volL), (int16)(reverseStereo ? volL : volR),
+		(int16)(reverseStereo ? volR : volL), (int16)(reverseStereo ? volL : volR)
+	};
+	const int16x4_t volumes = vld1_s16(volPair);
+
+	uint i = 0;
+	if (inStereo) {
+		for (; i + 4 <= frames; i += 4) {
+			int16x8_t samples = vld1q_s16(in);
+			if (reverseStereo)
+				samples = vrev32q_s16(samples);
+
+			const int16x8_t scaled = vcombine_s16(neon_applyVolume(vget_low_s16(samples), volumes), neon_applyVolume(vget_high_s16(samples), volumes));
+			vst1q_s16(out, vqaddq_s16(vld1q_s16(out), scaled));
+
+			in += 8;
+			out += 8;
+		}
+	} else {
+		for (; i + 4 <= frames; i += 4) {
+			const int16x4x2_t samples = vzip_s16(vld1_s16(in), vld1_s16(in));
+
+			const int16x8_t scaled = vcombine_s16(neon_applyVolume(samples.val[0], volumes), neon_applyVolume(samples.val[1], volumes));
+			vst1q_s16(out, vqaddq_s16(vld1q_s16(out), scaled));
+
+			in += 4;
+			out += 8;
+		}
+	}
+
+	mixGeneric(out, in, frames - i, volL, volR, inStereo, reverseStereo);
+}
+
+int32 RateFilter::dotNEON(const int16 *samples, const int16 *coefs, uint taps) {
+	int32x4_t sum = vdupq_n_s32(0);
+	for (uint i = 0; i < taps; i += 8) {
+		const int16x8_t s = vld1q_s16(samples + i);
+		const int16x8_t c = vld1q_s16(coefs + i);
+		sum = vmlal_s16(sum, vget_low_s16(s), vget_low_s16(c));
+		sum = vmlal_s16(sum, vget_high_s16(s), vget_high_s16(c));
+	}
+
+	int32x2_t sum2 = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(sum2, sum2), 0);
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
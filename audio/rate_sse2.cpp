@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "audio/rate_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+/**
+ * Multiply eight samples by their volumes and divide by kMaxMixerVolume,
+ * truncating towards zero like the generic code does.
+ */
+static FORCEINLINE __m128i sse2_applyVolume(__m128i samples, __m128i volumes) {
+	const __m128i lo = _mm_mullo_epi16(samples, volumes);
+	const __m128i hi = _mm_mulhi_epi16(samples, volumes);
+	__m128i a = _mm_unpacklo_epi16(lo, hi);
+	__m128i b = _mm_unpackhi_epi16(lo, hi);
+
+	// Add 255 to negative products before shifting
+	a = _mm_srai_epi32(_mm_add_epi32(a, _mm_srli_epi32(_mm_srai_epi32(a, 31), 24)), 8);
+	b = _mm_srai_epi32(_mm_add_epi32(b, _mm_srli_epi32(_mm_srai_epi32(b, 31), 24)), 8);
+	return _mm_packs_epi32(a, b);
+}
+
+void RateMixer::mixSSE2(st_sample_t *out, const st_sample_t *in, uint frames, st_volume_t volL, st_volume_t volR, bool inStereo, bool reverseStereo) {
+	// With reversed stereo, the left input goes to the right output, so the
+	// input pairs are swapped and the volumes follow them
+	const __m128i volumes = reverseStereo ?
+		_mm_set_epi16(volL, volR, volL, volR, volL, volR, volL, volR) :
+		_mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	uint i = 0;
+	if (inStereo) {
+		for (; i + 4 <= frames; i += 4) {
+			__m128i samples = _mm_loadu_si128((const __m128i *)in);
+			if (reverseStereo)
+				samples = _mm_shufflehi_epi16(_mm_shufflelo_epi16(samples, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+
+			__m128i dst = _mm_loadu_si128((const __m128i *)out);
+			_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, sse2_applyVolume(samples, volumes)));
+
+			in += 8;
+			out += 8;
+		}
+	} else {
+		for (; i + 4 <= frames; i += 4) {
+			__m128i samples = _mm_loadl_epi64((const __m128i *)in);
+			samples = _mm_unpacklo_epi16(samples, samples);
+
+			__m128i dst = _mm_loadu_si128((const __m128i *)out);
+			_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, sse2_applyVolume(samples, volumes)));
+
+			in += 4;
+			out += 8;
+		}
+	}
+
+	mixGeneric(out, in, frames - i, volL, volR, inStereo, reverseStereo);
+}
+
+int32 RateFilter::dotSSE2(const int16 *samples, const int16 *coefs, uint taps) {
+	__m128i sum = _mm_setzero_si128();
+	for (uint i = 0; i < taps; i += 8) {
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(samples + i)), _mm_loadu_si128((const __m128i *)(coefs + i))));
+	}
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -36,6 +36,14 @@ const char *AbstractFSNode::lastPathComponent(const Common::String &str, const c
 	return cur + 1;
 }
 
+bool AbstractFSNode::getFileStatus(int64 &size, int64 &modificationTime) const {
+	return false;
+}
+
+Common::SeekableReadStream *AbstractFSNode::createMappedReadStream() {
+	return createReadStream();
+}
+
 Common::SeekableReadStream *AbstractFSNode::createReadStreamForAltStream(Common::AltStreamType altStreamType) {
 	return nullptr;
 }
@@ -172,6 +172,18 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Queries the size and the last modification time of the file referred
+	 * by this node, to tell whether it changed since it was last seen.
+	 *
+	 * @param size             Set to the size of the file, in bytes.
+	 * @param modificationTime Set to the time of the last modification, in
+	 *                         seconds or finer backend specific units.
+	 *
+	 * @return true if the backend supports this and the file exists, false otherwise
+	 */
+	virtual bool getFileStatus(int64 &size, int64 &modificationTime) const;
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -182,6 +194,15 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance corresponding to the file
+	 * referred by this node, which may map the file into memory. By
+	 * default, this is the same as createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream();
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to an alternate
 	 * stream of the file referred by this node. This assumes that the node
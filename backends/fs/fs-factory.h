@@ -72,6 +72,12 @@ public:
 	 * root.
 	 */
 	virtual Common::String getSystemFullPath(const Common::String& path) const { return path; }
+
+	/**
+	 * Returns whether different nodes may be listed and read from several
+	 * threads at once. Each thread must only use its own nodes.
+	 */
+	virtual bool isThreadSafe() const { return false; }
 };
 
 #endif /*FILESYSTEM_FACTORY_H*/
@@ -25,6 +25,12 @@
 
 #include <sys/stat.h>
 
+#ifdef HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
 }
@@ -44,3 +50,72 @@ int64 PosixIoStream::size() const {
 
 	return st.st_size;
 }
+
+#ifdef HAS_MMAP
+
+// Small files are read faster than they are mapped
+#define MMAP_MIN_SIZE (64 * 1024)
+
+// Keep address space for everything else in 32-bit builds
+#define MMAP_MAX_SIZE (sizeof(void *) >= 8 ? 0x7FFFFFFFULL : 64 * 1024 * 1024ULL)
+
+namespace {
+
+struct MunmapDeleter {
+	MunmapDeleter(size_t size) : _size(size) {}
+
+	void operator()(byte *ptr) {
+		munmap(ptr, _size);
+	}
+
+	size_t _size;
+};
+
+} // End of anonymous namespace
+
+PosixMmapStream::PosixMmapStream(const Common::SharedPtr<byte> &mapping, const byte *data, uint32 dataSize) :
+		Common::MemoryReadStream(data, dataSize, DisposeAfterUse::NO), _mapping(mapping) {
+}
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) ||
+	    st.st_size < MMAP_MIN_SIZE || (uint64)st.st_size > MMAP_MAX_SIZE) {
+		close(fd);
+		return nullptr;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps a reference to the file
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	Common::SharedPtr<byte> mapping((byte *)data, MunmapDeleter(st.st_size));
+	return new PosixMmapStream(mapping, (const byte *)data, st.st_size);
+}
+
+Common::SeekableReadStream *PosixMmapStream::readStream(uint32 dataSize) {
+	uint32 offset = pos();
+	uint32 available = size() - offset;
+
+	seek(offset + MIN(dataSize, available));
+
+	if (dataSize > available) {
+		dataSize = available;
+
+		// Set the end-of-stream flag like a short read() does
+		byte dummy;
+		read(&dummy, 1);
+	}
+
+	return new PosixMmapStream(_mapping, getView(offset, dataSize), dataSize);
+}
+
+#endif
@@ -39,4 +39,32 @@ public:
 	int64 size() const override;
 };
 
+#ifdef HAS_MMAP
+
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+/**
+ * A read stream over a memory-mapped file. The file data is never copied:
+ * getView() returns pointers into the mapping, and readStream() returns
+ * streams sharing it.
+ */
+class PosixMmapStream final : public Common::MemoryReadStream {
+public:
+	/**
+	 * Map the file at the given path. Returns nullptr if the file cannot be
+	 * mapped, or is too small or too large to be worth mapping.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+
+	Common::SeekableReadStream *readStream(uint32 dataSize) override;
+
+private:
+	PosixMmapStream(const Common::SharedPtr<byte> &mapping, const byte *data, uint32 dataSize);
+
+	Common::SharedPtr<byte> _mapping;
+};
+
+#endif
+
 #endif
@@ -34,6 +34,7 @@ public:
 	AbstractFSNode *makeRootFileNode() const override;
 	AbstractFSNode *makeCurrentDirectoryFileNode() const override;
 	AbstractFSNode *makeFileNodePath(const Common::String &path) const override;
+	bool isThreadSafe() const override { return true; }
 };
 
 #endif /*WINDOWS_FILESYSTEM_FACTORY_H*/
@@ -1331,6 +1331,24 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_isInOverlayPalette = _overlayVisible;
 	}
 
+	// Coalesce the dirty areas of the frame
+	_numDirtyRects = 0;
+	if (!_forceRedraw) {
+		_dirtyRects.merge();
+		if (_dirtyRects.size() > NUM_DIRTY_RECT)
+			_forceRedraw = true;
+	}
+	if (!_forceRedraw) {
+		for (Graphics::DirtyRectList::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+			SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+			r->x = i->left;
+			r->y = i->top;
+			r->w = i->width();
+			r->h = i->height();
+		}
+	}
+	_dirtyRects.clear();
+
 	// In case of double buferring partially good version may be on another page,
 	// so we need to fully redraw
 	if (_isDoubleBuf && _numDirtyRects)
@@ -1795,11 +1813,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!inOverlay && !realCoordinates) {
@@ -1851,12 +1864,14 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	}
 
 	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+		_dirtyRects.push_back(Common::Rect(x, y, x + w, y + h));
 
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
+		// Coalesce the areas already added rather than giving up on them
+		if (_dirtyRects.size() >= NUM_DIRTY_RECT) {
+			_dirtyRects.merge();
+			if (_dirtyRects.size() >= NUM_DIRTY_RECT)
+				_forceRedraw = true;
+		}
 	}
 }
 
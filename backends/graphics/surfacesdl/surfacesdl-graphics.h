@@ -24,6 +24,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
@@ -349,9 +350,13 @@ protected:
 	};
 
 	// Dirty rect management
+	// The areas added since the last update are collected in
+	// _dirtyRects, which coalesces them, then copied to _dirtyRectList
+	// for drawing.
 	// When double-buffering we need to redraw both updates from
 	// current frame and previous frame. For convenience we copy
 	// them here before traversing the list.
+	Graphics::DirtyRectList _dirtyRects;
 	SDL_Rect _dirtyRectList[2 * NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
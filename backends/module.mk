@@ -215,6 +215,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mixer/null/null-mixer.o \
 	mutex/sdl/sdl-mutex.o \
+	thread/sdl/sdl-thread.o \
 	timer/sdl/sdl-timer.o
 
 ifndef USE_SDL3
@@ -446,6 +447,7 @@ ifdef IPHONE
 MODULE_OBJS += \
 	midi/coremidi.o \
 	mutex/pthread/pthread-mutex.o \
+	thread/pthread/pthread-thread.o \
 	graphics/ios/ios-graphics.o \
 	graphics/ios/renderbuffer.o
 
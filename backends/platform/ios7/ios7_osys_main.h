@@ -25,6 +25,7 @@
 #include "graphics/surface.h"
 #include "backends/platform/ios7/ios7_common.h"
 #include "backends/modular-backend.h"
+#include "common/thread.h"
 #include "backends/keymapper/hardware-input.h"
 #include "common/events.h"
 #include "common/str.h"
@@ -125,6 +126,9 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param) override;
+	Common::SemaphoreInternal *createSemaphore(uint initialCount = 0) override;
+	uint getCPUCount() const override;
 
 	static void mixCallback(void *sys, byte *samples, int len);
 	virtual void setupMixer(void);
@@ -53,6 +53,14 @@ typedef void (*sighandler_t)(int);
 #include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
 
+// The unit tests run the job system on worker threads, which needs real
+// mutexes
+#if defined(NULL_DRIVER_USE_FOR_TEST) && defined(POSIX)
+#define NULL_DRIVER_USE_THREADS
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/thread/pthread/pthread-thread.h"
+#endif
+
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
@@ -87,6 +95,10 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
+#ifdef NULL_DRIVER_USE_THREADS
+	virtual Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param);
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount = 0);
+#endif
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
@@ -189,9 +201,23 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#ifdef NULL_DRIVER_USE_THREADS
+	return createPthreadMutexInternal();
+#else
 	return new NullMutexInternal();
+#endif
 }
 
+#ifdef NULL_DRIVER_USE_THREADS
+Common::ThreadInternal *OSystem_NULL::createThread(Common::ThreadProc proc, void *param) {
+	return createPthreadThreadInternal(proc, param);
+}
+
+Common::SemaphoreInternal *OSystem_NULL::createSemaphore(uint initialCount) {
+	return createPthreadSemaphoreInternal(initialCount);
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
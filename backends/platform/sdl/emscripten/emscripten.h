@@ -53,6 +53,9 @@ public:
 	GraphicsManagerType getDefaultGraphicsManager() const override;
 #endif
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param) override { return nullptr; }
+	Common::SemaphoreInternal *createSemaphore(uint initialCount = 0) override { return nullptr; }
+	uint getCPUCount() const override { return 1; }
 	void exportFile(const Common::Path &filename);
 	void delayMillis(uint msecs) override;
 	void init() override;
@@ -46,6 +46,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/thread/sdl/sdl-thread.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -866,6 +867,18 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(Common::ThreadProc proc, void *param) {
+	return createSdlThreadInternal(proc, param);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore(uint initialCount) {
+	return createSdlSemaphoreInternal(initialCount);
+}
+
+uint OSystem_SDL::getCPUCount() const {
+	return getSdlCPUCount();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
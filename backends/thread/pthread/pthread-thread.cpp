@@ -0,0 +1,165 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "backends/thread/pthread/pthread-thread.h"
+#include "common/textconsole.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * pthreads thread implementation
+ */
+class PthreadThreadInternal final : public Common::ThreadInternal {
+public:
+	PthreadThreadInternal(Common::ThreadProc proc, void *param);
+	~PthreadThreadInternal() override;
+
+	bool start();
+	bool join() override;
+
+private:
+	static void *threadEntry(void *arg);
+
+	Common::ThreadProc _proc;
+	void *_param;
+	pthread_t _thread;
+	bool _running;
+};
+
+PthreadThreadInternal::PthreadThreadInternal(Common::ThreadProc proc, void *param) :
+	_proc(proc), _param(param), _running(false) {
+}
+
+PthreadThreadInternal::~PthreadThreadInternal() {
+	if (_running) {
+		warning("PthreadThreadInternal: thread destroyed without being joined");
+		pthread_detach(_thread);
+	}
+}
+
+void *PthreadThreadInternal::threadEntry(void *arg) {
+	PthreadThreadInternal *thread = (PthreadThreadInternal *)arg;
+	thread->_proc(thread->_param);
+	return nullptr;
+}
+
+bool PthreadThreadInternal::start() {
+	if (pthread_create(&_thread, nullptr, threadEntry, this) != 0) {
+		warning("pthread_create() failed");
+		return false;
+	}
+	_running = true;
+	return true;
+}
+
+bool PthreadThreadInternal::join() {
+	if (!_running)
+		return false;
+
+	_running = false;
+	if (pthread_join(_thread, nullptr) != 0) {
+		warning("pthread_join() failed");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * pthreads semaphore implementation
+ *
+ * Built on a mutex and a condition variable, as unnamed POSIX semaphores
+ * are not available everywhere (e.g. on macOS).
+ */
+class PthreadSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	PthreadSemaphoreInternal(uint initialCount);
+	~PthreadSemaphoreInternal() override;
+
+	bool wait() override;
+	bool post() override;
+
+private:
+	pthread_mutex_t _mutex;
+	pthread_cond_t _cond;
+	uint _count;
+};
+
+PthreadSemaphoreInternal::PthreadSemaphoreInternal(uint initialCount) : _count(initialCount) {
+	if (pthread_mutex_init(&_mutex, nullptr) != 0)
+		warning("pthread_mutex_init() failed");
+	if (pthread_cond_init(&_cond, nullptr) != 0)
+		warning("pthread_cond_init() failed");
+}
+
+PthreadSemaphoreInternal::~PthreadSemaphoreInternal() {
+	pthread_cond_destroy(&_cond);
+	pthread_mutex_destroy(&_mutex);
+}
+
+bool PthreadSemaphoreInternal::wait() {
+	if (pthread_mutex_lock(&_mutex) != 0) {
+		warning("pthread_mutex_lock() failed");
+		return false;
+	}
+	while (_count == 0)
+		pthread_cond_wait(&_cond, &_mutex);
+	_count--;
+	pthread_mutex_unlock(&_mutex);
+	return true;
+}
+
+bool PthreadSemaphoreInternal::post() {
+	if (pthread_mutex_lock(&_mutex) != 0) {
+		warning("pthread_mutex_lock() failed");
+		return false;
+	}
+	_count++;
+	pthread_cond_signal(&_cond);
+	pthread_mutex_unlock(&_mutex);
+	return true;
+}
+
+Common::ThreadInternal *createPthreadThreadInternal(Common::ThreadProc proc, void *param) {
+	PthreadThreadInternal *thread = new PthreadThreadInternal(proc, param);
+	if (!thread->start()) {
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createPthreadSemaphoreInternal(uint initialCount) {
+	return new PthreadSemaphoreInternal(initialCount);
+}
+
+uint getPthreadCPUCount() {
+#ifdef _SC_NPROCESSORS_ONLN
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count > 0)
+		return (uint)count;
+#endif
+	return 1;
+}
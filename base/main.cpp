@@ -30,6 +30,7 @@
 // FIXME: Avoid using printf
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
+#include "engines/advancedDetector.h"
 #include "engines/engine.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
@@ -43,6 +44,7 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/jobsystem.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -59,6 +61,7 @@
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
+#include "audio/rate.h"
 
 #include "graphics/cursorman.h"
 #include "graphics/fontman.h"
@@ -910,6 +913,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	//I think it's important to destroy it after ConnectionManager
 	Cloud::CloudManager::destroy();
 #endif
+	// Store MD5s computed by detections that were throttled
+	ADCacheMan.savePersistentCache(true);
+	AdvancedDetectorCacheManager::destroy();
+	Common::JobSystem::destroy();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
@@ -930,6 +937,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 	EngineManager::destroy();
 	Graphics::YUVToRGBManager::destroy();
+	Audio::SincFilterManager::destroy();
 
 	return 0;
 }
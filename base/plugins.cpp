@@ -703,6 +703,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
 
+	// Store newly computed MD5s for the next run
+	ADCacheMan.savePersistentCache(false);
+
 	return DetectionResults(candidates);
 }
 
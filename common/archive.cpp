@@ -33,6 +33,10 @@ namespace Common {
 ArchiveMember::~ArchiveMember() {
 }
 
+SeekableReadStream *ArchiveMember::createMappedReadStream() const {
+	return createReadStream();
+}
+
 U32String ArchiveMember::getDisplayName() const {
 	return getName();
 }
@@ -337,7 +341,95 @@ void SearchSet::insert(const Node &node) {
 		if (it->_priority < node._priority)
 			break;
 	}
-	_list.insert(it, node);
+
+	Node orderedNode(node);
+	orderedNode._order = _insertCount++;
+	_list.insert(it, orderedNode);
+
+	if (_indexed)
+		indexArchive(orderedNode);
+}
+
+void SearchSet::indexArchive(const Node &node) {
+	ArchiveMemberList members;
+	node._arc->listMembers(members);
+
+	IndexEntry entry;
+	entry._priority = node._priority;
+	entry._order = node._order;
+	entry._arc = node._arc;
+
+	_index.reserve(_index.size() + members.size());
+
+	for (const auto &member : members) {
+		IndexEntryList &entries = _index.getOrCreateVal(member->getPathInArchive());
+
+		// Keep the entries in search order: descending priority, then insertion order
+		uint i = 0;
+		while (i < entries.size() && (entries[i]._priority > entry._priority ||
+		       (entries[i]._priority == entry._priority && entries[i]._order < entry._order)))
+			i++;
+
+		if (i < entries.size() && entries[i]._arc == entry._arc)
+			continue;
+
+		entries.insert_at(i, entry);
+	}
+}
+
+void SearchSet::unindexArchive(const Node &node) {
+	ArchiveMemberList members;
+	node._arc->listMembers(members);
+
+	for (const auto &member : members) {
+		IndexMap::iterator it = _index.find(member->getPathInArchive());
+		if (it == _index.end())
+			continue;
+
+		IndexEntryList &entries = it->_value;
+		for (uint i = 0; i < entries.size(); i++) {
+			if (entries[i]._arc == node._arc) {
+				entries.remove_at(i);
+				break;
+			}
+		}
+
+		if (entries.empty())
+			_index.erase(it);
+	}
+}
+
+const SearchSet::IndexEntryList *SearchSet::lookupIndex(const Path &path) const {
+	_indexStats.lookups++;
+
+	IndexMap::const_iterator it = _index.find(path);
+	if (it == _index.end()) {
+		Path normalized = path.normalize();
+		if (normalized != path)
+			it = _index.find(normalized);
+	}
+
+	if (it == _index.end()) {
+		_indexStats.misses++;
+		return nullptr;
+	}
+
+	_indexStats.hits++;
+	return &it->_value;
+}
+
+void SearchSet::setIndexed(bool indexed) {
+	if (indexed == _indexed)
+		return;
+
+	_indexed = indexed;
+	_index.clear();
+	_indexStats = IndexStats();
+
+	if (_indexed) {
+		for (const auto &node : _list)
+			indexArchive(node);
+	}
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -431,6 +523,8 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		if (_indexed)
+			unindexArchive(*it);
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
@@ -457,6 +551,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_index.clear();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -470,6 +565,8 @@ void SearchSet::setPriority(const String &name, int priority) {
 		return;
 
 	Node node(*it);
+	if (_indexed)
+		unindexArchive(node);
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
@@ -479,6 +576,18 @@ bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	if (_indexed) {
+		const IndexEntryList *entries = lookupIndex(path);
+		if (entries) {
+			for (const auto &entry : *entries) {
+				if (entry._arc->hasFile(path))
+					return true;
+			}
+		}
+
+		return false;
+	}
+
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path))
 			return true;
@@ -559,6 +668,22 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	if (_indexed) {
+		const IndexEntryList *entries = lookupIndex(path);
+		if (entries) {
+			for (const auto &entry : *entries) {
+				if (entry._arc->hasFile(path)) {
+					if (container) {
+						*container = entry._arc;
+					}
+					return entry._arc->getMember(path);
+				}
+			}
+		}
+
+		return ArchiveMemberPtr();
+	}
+
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path)) {
 			if (container) {
@@ -579,6 +704,19 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (_indexed) {
+		const IndexEntryList *entries = lookupIndex(path);
+		if (entries) {
+			for (const auto &entry : *entries) {
+				SeekableReadStream *stream = entry._arc->createReadStreamForMember(path);
+				if (stream)
+					return stream;
+			}
+		}
+
+		return nullptr;
+	}
+
 	for (const auto &archive : _list) {
 		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
 		if (stream)
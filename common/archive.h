@@ -22,6 +22,7 @@
 #ifndef COMMON_ARCHIVE_H
 #define COMMON_ARCHIVE_H
 
+#include "common/array.h"
 #include "common/error.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -71,6 +72,13 @@ public:
 	virtual SeekableReadStream *createReadStream() const = 0; /*!< Create a read stream. */
 	virtual SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const = 0; /*!< Create a read stream of an alternate stream. */
 
+	/**
+	 * Create a read stream that maps the member into memory where possible,
+	 * see FSNode::createMappedReadStream. Members which cannot be mapped
+	 * fall back to createReadStream().
+	 */
+	virtual SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	* @deprecated Get the name of the archive member.  This may be a file name or a full path depending on archive type.
 	 *            DEPRECATED: Use getFileName or getPathInArchive instead, which always returns one or the other.
@@ -328,13 +336,25 @@ private:
  * priority order. In case of conflicting priorities, insertion order prevails.
  */
 class SearchSet : public Archive {
+public:
+	/** Statistics of the lookups resolved through the member index. */
+	struct IndexStats {
+		IndexStats() : lookups(0), hits(0), misses(0) {}
+
+		uint lookups; //!< Number of index lookups.
+		uint hits;    //!< Number of lookups of paths present in the index.
+		uint misses;  //!< Number of lookups of paths no archive has listed.
+	};
+
+private:
 	struct Node {
 		int		_priority;
+		uint	_order;
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _order(0), _name(name), _arc(arc), _autoFree(autoFree) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
@@ -346,9 +366,27 @@ class SearchSet : public Archive {
 	void insert(const Node& node); //!< Add an archive while keeping the list sorted by descending priority.
 
 	bool _ignoreClashes;
+	uint _insertCount;
+
+	/** An archive listing a path, ordered like the nodes of _list. */
+	struct IndexEntry {
+		int _priority;
+		uint _order;
+		Archive *_arc;
+	};
+	typedef Array<IndexEntry> IndexEntryList;
+	typedef FlatHashMap<Path, IndexEntryList, Path::IgnoreCase_Hash, Path::IgnoreCase_EqualTo> IndexMap;
+
+	bool _indexed;
+	IndexMap _index;
+	mutable IndexStats _indexStats;
+
+	void indexArchive(const Node &node);
+	void unindexArchive(const Node &node);
+	const IndexEntryList *lookupIndex(const Path &path) const;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _insertCount(0), _indexed(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	char getPathSeparator() const override { return '/'; }
@@ -476,6 +514,24 @@ public:
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
 
+	/**
+	 * Enable or disable the member index. When enabled, the members of each
+	 * archive are listed when it is added, and hasFile(), getMember() and
+	 * createReadStreamForMember() only ask the archives which listed the
+	 * requested path, instead of all of them in turn.
+	 *
+	 * This is only correct if the archives list every file they can open,
+	 * and if their list of files does not change after they are added.
+	 */
+	void setIndexed(bool indexed);
+	bool isIndexed() const { return _indexed; }
+
+	/** Return statistics about the lookups done through the member index. */
+	const IndexStats &getIndexStats() const { return _indexStats; }
+
+	/** Return the number of distinct paths in the member index. */
+	uint getIndexSize() const { return _index.size(); }
+
 	bool getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode = kListDirectoriesOnly, bool hidden = true) const override;
 };
 
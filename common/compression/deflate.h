@@ -151,6 +151,23 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped,
 		DisposeAfterUse::Flag disposeParent = DisposeAfterUse::YES, uint64 knownSize = 0,
 		const byte *dict = nullptr, uint dictLen = 0);
 
+/**
+ * Same as wrapDeflateReadStream(), except that the returned stream records a
+ * decompression checkpoint every @p checkpointInterval bytes of output. Seeks
+ * then resume decompression from the closest checkpoint instead of from the
+ * start of the data. Each checkpoint keeps a copy of the decompressor state,
+ * which takes about 40 KB.
+ *
+ * Without ZLIB support, no checkpoints are recorded.
+ *
+ * @param toBeWrapped	the stream to be wrapped
+ * @param knownSize	the length of the uncompressed data
+ * @param checkpointInterval	the distance between checkpoints in the uncompressed data
+ */
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped,
+		DisposeAfterUse::Flag disposeParent, uint64 knownSize,
+		uint32 checkpointInterval = 1024 * 1024);
+
 /**
  * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
  * provides transparent on-the-fly decompression. Assumes the data it
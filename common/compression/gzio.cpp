@@ -1388,6 +1388,11 @@ SeekableReadStream* wrapDeflateReadStream(Common::SeekableReadStream *parent, Di
 	return gzio;
 }
 
+SeekableReadStream *wrapSeekableDeflateReadStream(Common::SeekableReadStream *parent, DisposeAfterUse::Flag disposeParent, uint64 knownSize, uint32 checkpointInterval) {
+	// Checkpoints are not supported, seeking back restarts decompression
+	return wrapDeflateReadStream(parent, disposeParent, knownSize);
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 	// Not supported, return stream itself to write uncompressed data
 	return toBeWrapped;
@@ -95,6 +95,7 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -325,6 +326,7 @@ typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCa
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _sharedStream;	/* owns _stream, shared with members read from it */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -459,6 +461,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 	int err = UNZ_OK;
 
 	us->_stream = stream;
+	us->_sharedStream.reset(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos == 0)
@@ -489,7 +492,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_ERRNO;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -516,7 +518,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -606,7 +607,6 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -958,6 +958,27 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 	return err;
 }
 
+namespace Common {
+
+/**
+ * A member read straight from the archive stream. It keeps a reference to
+ * the archive stream, so that it stays valid after the archive is closed.
+ */
+class ZipMemberStream : public SafeSeekableSubReadStream {
+public:
+	ZipMemberStream(const SharedPtr<SeekableReadStream> &archiveStream, uint32 begin, uint32 end) :
+		SafeSeekableSubReadStream(archiveStream.get(), begin, end, DisposeAfterUse::NO), _archiveStream(archiveStream) {
+	}
+
+private:
+	SharedPtr<SeekableReadStream> _archiveStream;
+};
+
+} // End of namespace Common
+
+/* Deflated members larger than this are decompressed on demand */
+#define UNZ_STREAMING_SIZE (256 * 1024)
+
 /*
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
@@ -988,9 +1009,22 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	}
 
 	uint32 crc32_wait = s->cur_file_info.crc;
+	uint32 dataOffset = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+
+	// Stored members are served straight from the archive, without copying
+	// them. Large deflated members are decompressed as they are read, with
+	// checkpoints to keep seeking cheap. Neither of them is CRC checked.
+	if (s->cur_file_info.compression_method == 0 ||
+	    s->cur_file_info.uncompressed_size >= UNZ_STREAMING_SIZE) {
+		Common::SeekableReadStream *member = new Common::ZipMemberStream(s->_sharedStream, dataOffset, dataOffset + s->cur_file_info.compressed_size);
+		if (s->cur_file_info.compression_method == 0)
+			return Common::SharedArchiveContents::bypass(member);
+
+		return Common::SharedArchiveContents::bypass(Common::wrapSeekableDeflateReadStream(member, DisposeAfterUse::YES, s->cur_file_info.uncompressed_size));
+	}
 
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
-	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+	s->_stream->seek(dataOffset);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
 	byte *uncompressedBuffer = nullptr;
 
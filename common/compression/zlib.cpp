@@ -33,6 +33,7 @@
 
 #include "common/compression/deflate.h"
 
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -110,9 +111,67 @@ protected:
 	uint32 _origSize;
 	bool _eos;
 
+	/**
+	 * Copy of the decompressor state at a given output position, from
+	 * which decompression can be resumed when seeking.
+	 */
+	struct Checkpoint {
+		uint32 pos;
+		int64 inputPos;
+		z_stream state;
+	};
+
+	Array<Checkpoint *> _checkpoints;
+	uint32 _checkpointInterval;
+
+	void addCheckpoint(uint32 pos) {
+		Checkpoint *checkpoint = new Checkpoint();
+		checkpoint->pos = pos;
+		checkpoint->inputPos = _wrapped->pos() - _stream.avail_in;
+
+		if (inflateCopy(&checkpoint->state, &_stream) != Z_OK) {
+			delete checkpoint;
+			return;
+		}
+
+		_checkpoints.push_back(checkpoint);
+	}
+
+	bool restoreCheckpoint(const Checkpoint *checkpoint) {
+		inflateEnd(&_stream);
+		_zlibErr = inflateCopy(&_stream, const_cast<z_stream *>(&checkpoint->state));
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_pos = checkpoint->pos;
+		_wrapped->seek(checkpoint->inputPos, SEEK_SET);
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		return true;
+	}
+
+	void inflateStep(uint32 outPos) {
+		// Stop at the next checkpoint position so that the state there can be copied
+		uint32 nextCheckpoint = (_checkpoints.size() + 1) * _checkpointInterval;
+		if (!_checkpointInterval || outPos >= nextCheckpoint || nextCheckpoint - outPos > _stream.avail_out) {
+			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+			return;
+		}
+
+		uInt availOut = _stream.avail_out;
+		_stream.avail_out = nextCheckpoint - outPos;
+		_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+
+		uInt produced = (nextCheckpoint - outPos) - _stream.avail_out;
+		_stream.avail_out = availOut - produced;
+
+		if (_zlibErr == Z_OK && outPos + produced == nextCheckpoint)
+			addCheckpoint(nextCheckpoint);
+	}
+
 public:
 
-	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize) : _wrapped(w, disposeParent), _stream() {
+	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize) : _wrapped(w, disposeParent), _stream(), _checkpointInterval(0) {
 		assert(w != nullptr);
 
 		_parentPos = w->pos();
@@ -148,7 +207,8 @@ public:
 		_stream.avail_in = 0;
 	}
 
-	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize, const byte *dict, uint dictLen) : _wrapped(w, disposeParent), _stream() {
+	GZipReadStream(SeekableReadStream *w, DisposeAfterUse::Flag disposeParent, uint32 knownSize, const byte *dict, uint dictLen, uint32 checkpointInterval = 0) :
+			_wrapped(w, disposeParent), _stream(), _checkpointInterval(checkpointInterval) {
 		assert(w != nullptr);
 
 		_parentPos = w->pos();
@@ -176,6 +236,11 @@ public:
 	}
 
 	~GZipReadStream() {
+		for (uint i = 0; i < _checkpoints.size(); i++) {
+			inflateEnd(&_checkpoints[i]->state);
+			delete _checkpoints[i];
+		}
+
 		inflateEnd(&_stream);
 	}
 
@@ -196,7 +261,7 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
-			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+			inflateStep(_pos + dataSize - _stream.avail_out);
 		}
 
 		// Update the position counter
@@ -236,7 +301,14 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
+		// Resume from the closest checkpoint before the new position, if
+		// that is closer than the current position
+		uint checkpoint = _checkpointInterval ? MIN<uint>(newPos / _checkpointInterval, _checkpoints.size()) : 0;
+
+		if (checkpoint > 0 && ((uint32)newPos < _pos || _checkpoints[checkpoint - 1]->pos > _pos)) {
+			if (!restoreCheckpoint(_checkpoints[checkpoint - 1]))
+				return false;
+		} else if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
 			// to avoid it. :/
@@ -422,6 +494,20 @@ SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, Dispo
 	return new GZipReadStream(toBeWrapped, disposeParent, knownSize, dict, dictLen);
 }
 
+SeekableReadStream *wrapSeekableDeflateReadStream(SeekableReadStream *toBeWrapped, DisposeAfterUse::Flag disposeParent, uint64 knownSize, uint32 checkpointInterval) {
+	if (!toBeWrapped) {
+		return nullptr;
+	}
+
+	if (toBeWrapped->eos() || toBeWrapped->err()) {
+		if (disposeParent == DisposeAfterUse::YES) {
+			delete toBeWrapped;
+		}
+		return nullptr;
+	}
+	return new GZipReadStream(toBeWrapped, disposeParent, knownSize, nullptr, 0, checkpointInterval);
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 	if (!toBeWrapped)
 		return nullptr;
@@ -58,6 +58,18 @@ bool File::open(const Path &filename, Archive &archive) {
 	return open(stream, filename.toString());
 }
 
+bool File::openMapped(const Path &filename) {
+	assert(!filename.empty());
+	assert(!_handle);
+
+	ArchiveMemberPtr member = SearchMan.getMember(filename);
+	if (!member)
+		member = SearchMan.getMember(filename.append("."));
+
+	SeekableReadStream *stream = member ? member->createMappedReadStream() : nullptr;
+	return open(stream, filename.toString());
+}
+
 bool File::open(const FSNode &node) {
 	assert(!_handle);
 
@@ -142,6 +154,16 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+const byte *File::getView(int64 offset, uint32 size) const {
+	assert(_handle);
+	return _handle->getView(offset, size);
+}
+
+SeekableReadStream *File::readStream(uint32 dataSize) {
+	assert(_handle);
+	return _handle->readStream(dataSize);
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
@@ -84,6 +84,17 @@ public:
 	 */
 	virtual bool open(const Path &filename, Archive &archive);
 
+	/**
+	 * Try to open the file with the given file name, by searching SearchMan,
+	 * mapping it into memory where possible. This is meant for large game
+	 * archives, see FSNode::createMappedReadStream.
+	 * @note Must not be called if this file is already open (i.e. if isOpen returns true).
+	 *
+	 * @param	filename	Name of the file to open.
+	 * @return	True if the file was opened successfully, false otherwise.
+	 */
+	bool openMapped(const Path &filename);
+
 	/**
 	 * Try to open the file corresponding to the given node. Will check whether the
 	 * node actually refers to an existing file (and not a directory), and handle
@@ -133,6 +144,8 @@ public:
 	int64 size() const override; /*!< Implement abstract SeekableReadStream method. */
 	bool seek(int64 offs, int whence = SEEK_SET) override;	/*!< Implement abstract SeekableReadStream method. */
 	uint32 read(void *dataPtr, uint32 dataSize) override;	/*!< Implement abstract SeekableReadStream method. */
+	const byte *getView(int64 offset, uint32 size) const override;
+	SeekableReadStream *readStream(uint32 dataSize) override;
 };
 
 
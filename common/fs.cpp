@@ -34,6 +34,7 @@ public:
 	FSDirectoryFile(const Common::Path &pathInDirectory, const FSNode &fsNode);
 
 	SeekableReadStream *createReadStream() const override;
+	SeekableReadStream *createMappedReadStream() const override;
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 	String getName() const override;
 	Path getPathInArchive() const override;
@@ -55,6 +56,10 @@ SeekableReadStream *FSDirectoryFile::createReadStream() const {
 	return _fsNode.createReadStream();
 }
 
+SeekableReadStream *FSDirectoryFile::createMappedReadStream() const {
+	return _fsNode.createMappedReadStream();
+}
+
 SeekableReadStream *FSDirectoryFile::createReadStreamForAltStream(AltStreamType altStreamType) const {
 	return _fsNode.createReadStreamForAltStream(altStreamType);
 }
@@ -233,6 +238,15 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+bool FSNode::getFileStatus(int64 &size, int64 &modificationTime) const {
+	return _realNode && _realNode->getFileStatus(size, modificationTime);
+}
+
+bool FSNode::isThreadSafe() {
+	FilesystemFactory *factory = g_system->getFilesystemFactory();
+	return factory && factory->isThreadSafe();
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -248,6 +262,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStreamType) const {
 	if (_realNode == nullptr)
 		return nullptr;
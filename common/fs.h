@@ -252,6 +252,24 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Query the size and the time of the last modification of the file
+	 * referred by this node. Only meant to tell whether a file changed,
+	 * the unit of the time depends on the backend.
+	 *
+	 * @param size             Set to the size of the file, in bytes.
+	 * @param modificationTime Set to the time of the last modification.
+	 *
+	 * @return True if the file exists and the backend supports this, false otherwise.
+	 */
+	bool getFileStatus(int64 &size, int64 &modificationTime) const;
+
+	/**
+	 * Return whether the backend allows listing and reading different nodes
+	 * from several threads at once. Each thread must only use its own nodes.
+	 */
+	static bool isThreadSafe();
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -261,6 +279,20 @@ public:
 	 */
 	SeekableReadStream *createReadStream() const override;
 
+	/**
+	 * Create a SeekableReadStream instance corresponding to the file
+	 * referred by this node, like createReadStream(). Where the backend
+	 * supports it, large files are mapped into memory instead of being
+	 * read, so that getView() and readStream() do not copy the data.
+	 *
+	 * This is meant for large read-only data files, like game archives.
+	 * A mapped file must not be truncated while the stream exists: reading
+	 * past its new end crashes rather than failing.
+	 *
+	 * @return Pointer to the stream object, nullptr in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const override;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to an alternate stream
 	 * of the file referred by this node. This assumes that the node actually
@@ -0,0 +1,248 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/jobsystem.h"
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(JobSystem);
+
+enum {
+	kMaxWorkerThreads = 32,
+	kChunksPerThread = 4
+};
+
+JobGroup::JobGroup() : _pending(0) {
+	_done = g_system->createSemaphore(0);
+}
+
+JobGroup::~JobGroup() {
+	if (!isDone())
+		wait();
+	delete _done;
+}
+
+bool JobGroup::isDone() const {
+	StackLock lock(_mutex);
+	return _pending == 0;
+}
+
+void JobGroup::wait() {
+	JobMan.wait(*this);
+}
+
+void JobGroup::addPending() {
+	StackLock lock(_mutex);
+	_pending++;
+}
+
+void JobGroup::finishPending() {
+	// Post while holding the lock, so a waiter that sees the group as done
+	// cannot destroy it before the semaphore has been touched
+	StackLock lock(_mutex);
+	assert(_pending > 0);
+	if (--_pending == 0 && _done)
+		_done->post();
+}
+
+JobSystem::JobSystem() : _wakeUp(nullptr), _nextQueue(0), _quit(false) {
+	int count = (int)g_system->getCPUCount() - 1;
+	if (ConfMan.hasKey("worker_threads"))
+		count = ConfMan.getInt("worker_threads");
+	count = CLIP<int>(count, 0, kMaxWorkerThreads);
+
+	if (count > 0)
+		_wakeUp = g_system->createSemaphore(0);
+	if (!_wakeUp)
+		return;
+
+	for (int i = 0; i < count; i++)
+		_queues.push_back(new JobQueue());
+
+	for (int i = 0; i < count; i++) {
+		Worker *worker = new Worker();
+		worker->owner = this;
+		worker->index = i;
+		worker->thread = g_system->createThread(&workerProc, worker);
+		if (!worker->thread) {
+			delete worker;
+			break;
+		}
+		_workers.push_back(worker);
+	}
+
+	if (_workers.empty()) {
+		shutdown();
+		return;
+	}
+
+	debug(1, "JobSystem: started %u worker threads", _workers.size());
+}
+
+JobSystem::~JobSystem() {
+	shutdown();
+}
+
+void JobSystem::shutdown() {
+	_quit = true;
+	for (uint i = 0; i < _workers.size(); i++)
+		_wakeUp->post();
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		_workers[i]->thread->join();
+		delete _workers[i]->thread;
+		delete _workers[i];
+	}
+	_workers.clear();
+
+	// Nobody is left to run queued jobs, so finish them here
+	Job job;
+	for (uint i = 0; i < _queues.size(); i++) {
+		while (pop(i, true, job))
+			runJob(job);
+		delete _queues[i];
+	}
+	_queues.clear();
+
+	delete _wakeUp;
+	_wakeUp = nullptr;
+}
+
+void JobSystem::workerProc(void *param) {
+	Worker *worker = (Worker *)param;
+	JobSystem *jobs = worker->owner;
+
+	for (;;) {
+		jobs->_wakeUp->wait();
+		if (jobs->_quit)
+			break;
+
+		while (jobs->runPendingJob(worker->index))
+			;
+	}
+}
+
+void JobSystem::submit(JobProc proc, void *param, JobGroup *group, JobProc release) {
+	Job job;
+	job.proc = proc;
+	job.param = param;
+	job.group = group;
+	job.release = release;
+
+	if (group)
+		group->addPending();
+
+	if (!isThreaded()) {
+		runJob(job);
+		return;
+	}
+
+	uint queue;
+	{
+		StackLock lock(_submitMutex);
+		queue = _nextQueue;
+		_nextQueue = (_nextQueue + 1) % _queues.size();
+	}
+
+	push(queue, job);
+	_wakeUp->post();
+}
+
+void JobSystem::wait(JobGroup &group) {
+	while (!group.isDone()) {
+		if (runPendingJob(0))
+			continue;
+
+		// Everything left is already running on workers
+		if (group._done)
+			group._done->wait();
+	}
+}
+
+int JobSystem::computeChunkSize(int count, int grain) const {
+	if (!isThreaded())
+		return count;
+
+	int chunks = (_workers.size() + 1) * kChunksPerThread;
+	return MAX(MAX(grain, 1), (count + chunks - 1) / chunks);
+}
+
+void JobSystem::push(uint queue, const Job &job) {
+	JobQueue &q = *_queues[queue];
+	StackLock lock(q.mutex);
+
+	if (q.count == q.jobs.size()) {
+		// Grow and unwrap the ring buffer
+		Array<Job> jobs;
+		jobs.resize(MAX<uint>(16, q.jobs.size() * 2));
+		for (uint i = 0; i < q.count; i++)
+			jobs[i] = q.jobs[(q.head + i) % q.jobs.size()];
+		q.jobs.swap(jobs);
+		q.head = 0;
+	}
+
+	q.jobs[(q.head + q.count) % q.jobs.size()] = job;
+	q.count++;
+}
+
+bool JobSystem::pop(uint queue, bool steal, Job &job) {
+	JobQueue &q = *_queues[queue];
+	StackLock lock(q.mutex);
+
+	if (q.count == 0)
+		return false;
+
+	if (steal) {
+		job = q.jobs[q.head];
+		q.head = (q.head + 1) % q.jobs.size();
+	} else {
+		job = q.jobs[(q.head + q.count - 1) % q.jobs.size()];
+	}
+	q.count--;
+	return true;
+}
+
+bool JobSystem::runPendingJob(uint firstQueue) {
+	Job job;
+	for (uint i = 0; i < _queues.size(); i++) {
+		if (pop((firstQueue + i) % _queues.size(), i != 0, job)) {
+			runJob(job);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::runJob(const Job &job) {
+	job.proc(job.param);
+	if (job.group)
+		job.group->finishPending();
+	// The group may belong to what release() frees, so it comes last
+	if (job.release)
+		job.release(job.param);
+}
+
+} // End of namespace Common
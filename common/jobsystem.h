@@ -0,0 +1,284 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_JOBSYSTEM_H
+#define COMMON_JOBSYSTEM_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+
+#include <atomic>
+
+namespace Common {
+
+/**
+ * @defgroup common_jobsystem Job system
+ * @ingroup common
+ *
+ * @brief Pool of worker threads for fanning CPU-heavy work out across cores.
+ *
+ * Jobs are plain function/parameter pairs pushed to per-worker queues.
+ * Idle workers steal from the other queues, and a thread waiting for a
+ * JobGroup runs pending jobs itself instead of blocking, so nested
+ * parallelism cannot deadlock.
+ *
+ * On backends without thread support (see OSystem::createThread()), or
+ * when the "worker_threads" config key is set to 0, every job is run
+ * synchronously on the submitting thread.
+ * @{
+ */
+
+typedef void (*JobProc)(void *param);
+
+class JobSystem;
+
+/**
+ * Tracks completion of a set of jobs.
+ *
+ * A group can be reused once wait() has returned. It must not be destroyed
+ * while jobs are still pending; the destructor waits for them.
+ */
+class JobGroup : NonCopyable {
+	friend class JobSystem;
+
+public:
+	JobGroup();
+	~JobGroup();
+
+	/** Return true if no job of this group is queued or running. */
+	bool isDone() const;
+
+	/** Block until all jobs of this group have finished, running pending jobs meanwhile. */
+	void wait();
+
+private:
+	void addPending();
+	void finishPending();
+
+	Mutex _mutex;
+	SemaphoreInternal *_done;
+	uint _pending;
+};
+
+/**
+ * Result of a job started with JobSystem::async().
+ */
+template<typename T>
+class JobFuture {
+	friend class JobSystem;
+
+	/**
+	 * Shared by the futures and the job. The futures hold one reference
+	 * through their SharedPtr and the job holds the other, which it only
+	 * drops after the group has been signalled, so the state outlives the
+	 * job even if every future is gone.
+	 */
+	struct State {
+		State() : _refs(2) {}
+		virtual ~State() {}
+		virtual void run() = 0;
+
+		void release() {
+			bool last;
+			{
+				StackLock lock(_refMutex);
+				last = --_refs == 0;
+			}
+			if (last)
+				delete this;
+		}
+
+		JobGroup group;
+		T value;
+
+	private:
+		Mutex _refMutex;
+		uint _refs;
+	};
+
+	/** Deleter of the futures' reference to the state. */
+	struct StateReleaser {
+		void operator()(State *state) { state->release(); }
+	};
+
+	template<typename Func>
+	struct FuncState : public State {
+		FuncState(const Func &func) : _func(func) {}
+		void run() override { this->value = _func(); }
+
+		Func _func;
+	};
+
+	SharedPtr<State> _state;
+
+	static void runJob(void *param) {
+		((State *)param)->run();
+	}
+
+	static void releaseJob(void *param) {
+		((State *)param)->release();
+	}
+
+public:
+	bool isValid() const { return _state.get() != nullptr; }
+	bool isReady() const { return _state->group.isDone(); }
+
+	/** Wait for the job to finish and return its result. */
+	const T &get() const {
+		_state->group.wait();
+		return _state->value;
+	}
+};
+
+class JobSystem : public Singleton<JobSystem> {
+	friend class Singleton<SingletonBaseType>;
+	friend class JobGroup;
+
+public:
+	/** Number of worker threads. 0 means every job runs synchronously. */
+	uint getWorkerCount() const { return _workers.size(); }
+	bool isThreaded() const { return !_workers.empty(); }
+
+	/**
+	 * Queue a job. If a group is given, it is marked as pending until
+	 * the job has finished.
+	 */
+	void submit(JobProc proc, void *param, JobGroup *group = nullptr) {
+		submit(proc, param, group, nullptr);
+	}
+
+	/**
+	 * Run func(first, last) over sub-ranges of [begin, end) in parallel and
+	 * wait for all of them. Ranges hold at least grain elements, except the
+	 * last one. The calling thread takes part in the work.
+	 */
+	template<typename Func>
+	void parallelFor(int begin, int end, int grain, const Func &func) {
+		if (end <= begin)
+			return;
+
+		int chunk = computeChunkSize(end - begin, grain);
+		if (chunk >= end - begin) {
+			func(begin, end);
+			return;
+		}
+
+		Array<RangeJob<Func> > ranges;
+		ranges.reserve((end - begin + chunk - 1) / chunk);
+		for (int first = begin; first < end; first += chunk)
+			ranges.push_back(RangeJob<Func>(&func, first, MIN(first + chunk, end)));
+
+		JobGroup group;
+		for (uint i = 1; i < ranges.size(); i++)
+			submit(&RangeJob<Func>::run, &ranges[i], &group);
+		RangeJob<Func>::run(&ranges[0]);
+		group.wait();
+	}
+
+	/**
+	 * Run func() as a job and return a future holding its result.
+	 */
+	template<typename T, typename Func>
+	JobFuture<T> async(const Func &func) {
+		typedef typename JobFuture<T>::State State;
+		State *state = new typename JobFuture<T>::template FuncState<Func>(func);
+
+		JobFuture<T> future;
+		future._state = SharedPtr<State>(state, typename JobFuture<T>::StateReleaser());
+		submit(&JobFuture<T>::runJob, state, &state->group, &JobFuture<T>::releaseJob);
+		return future;
+	}
+
+	/** Block until all jobs of group have finished, running pending jobs meanwhile. */
+	void wait(JobGroup &group);
+
+private:
+	JobSystem();
+	~JobSystem();
+
+	template<typename Func>
+	struct RangeJob {
+		RangeJob(const Func *func, int first, int last) : _func(func), _first(first), _last(last) {}
+
+		static void run(void *param) {
+			RangeJob *range = (RangeJob *)param;
+			(*range->_func)(range->_first, range->_last);
+		}
+
+		const Func *_func;
+		int _first, _last;
+	};
+
+	struct Job {
+		JobProc proc;
+		void *param;
+		JobGroup *group;
+		/** Called with param once the group has been signalled, or nullptr. */
+		JobProc release;
+	};
+
+	/** Double-ended ring buffer of jobs. The owner pops from the back, thieves from the front. */
+	struct JobQueue {
+		JobQueue() : head(0), count(0) {}
+
+		Mutex mutex;
+		Array<Job> jobs;
+		uint head;
+		uint count;
+	};
+
+	struct Worker {
+		JobSystem *owner;
+		uint index;
+		ThreadInternal *thread;
+	};
+
+	static void workerProc(void *param);
+
+	void submit(JobProc proc, void *param, JobGroup *group, JobProc release);
+	int computeChunkSize(int count, int grain) const;
+	void push(uint queue, const Job &job);
+	bool pop(uint queue, bool steal, Job &job);
+	bool runPendingJob(uint firstQueue);
+	void runJob(const Job &job);
+	void shutdown();
+
+	Array<Worker *> _workers;
+	Array<JobQueue *> _queues;
+	SemaphoreInternal *_wakeUp;
+	Mutex _submitMutex;
+	uint _nextQueue;
+	std::atomic<bool> _quit;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+/** Shortcut for accessing the job system. */
+#define JobMan Common::JobSystem::instance()
+
+#endif
@@ -93,6 +93,12 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	const byte *getView(int64 offset, uint32 size) const {
+		if (offset < 0 || offset > _size || size > _size - offset)
+			return nullptr;
+		return _ptrOrig.get() + offset;
+	}
 };
 
 
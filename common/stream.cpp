@@ -292,6 +292,13 @@ bool SeekableSubReadStream::seek(int64 offset, int whence) {
 	return ret;
 }
 
+const byte *SeekableSubReadStream::getView(int64 offset, uint32 size) const {
+	if (offset < 0 || offset > _end - _begin || size > _end - _begin - offset)
+		return nullptr;
+
+	return _parentStream->getView(_begin + offset, size);
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
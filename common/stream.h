@@ -714,8 +714,11 @@ public:
 	 * if reading more data failed. This is because of an I/O error or because
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
+	 *
+	 * Streams whose data lives in shared memory, such as memory-mapped
+	 * files, may return a stream referencing that memory instead of a copy.
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
@@ -792,6 +795,19 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Return a direct pointer to the stream data in the range
+	 * [@p offset, @p offset + @p size), if the stream is backed by contiguous
+	 * memory, like a memory buffer or a memory-mapped file. No data is copied,
+	 * and the position of the stream does not change.
+	 *
+	 * The pointer stays valid as long as the stream exists.
+	 *
+	 * @return Pointer to the data, or nullptr if the stream cannot provide
+	 *         a view of this range. In that case, the data has to be read().
+	 */
+	virtual const byte *getView(int64 offset, uint32 size) const { return nullptr; }
+
 	/**
 	 * Read at most one less than the number of characters specified
 	 * by @p bufSize from the stream and store them in the string buffer.
@@ -982,6 +998,7 @@ public:
 	int64 pos() const override { return _parentStream->pos(); }
 	int64 size() const override { return _parentStream->size(); }
 	bool seek(int64 offset, int whence = SEEK_SET) override { return _parentStream->seek(offset, whence); }
+	const byte *getView(int64 offset, uint32 size) const override { return _parentStream->getView(offset, size); }
 };
 
 /** @} */
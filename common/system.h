@@ -56,6 +56,7 @@ namespace Common {
 class EventManager;
 class MutexInternal;
 struct Rect;
+class SemaphoreInternal;
 class SaveFileManager;
 class SearchSet;
 class String;
@@ -66,6 +67,7 @@ class TaskbarManager;
 class UpdateManager;
 #endif
 class TextToSpeechManager;
+class ThreadInternal;
 #if defined(USE_SYSDIALOGS)
 class DialogManager;
 #endif
@@ -1656,6 +1658,45 @@ public:
 	/** @} */
 
 
+	/**
+	 * @defgroup common_system_threads Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Optional thread support used by Common::JobSystem to spread CPU-heavy
+	 * work over several cores. Backends that cannot create threads keep the
+	 * default implementations, in which case all jobs are run synchronously
+	 * on the calling thread.
+	 *
+	 * Backends implementing these must also return real mutexes from
+	 * createMutex().
+	 */
+
+	/**
+	 * Create a new thread running the given procedure.
+	 *
+	 * The thread must be joined with Common::ThreadInternal::join() before
+	 * it is deleted.
+	 *
+	 * @return The newly created thread, or nullptr if threads are not supported.
+	 */
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param) { return nullptr; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @return The newly created semaphore, or nullptr if threads are not supported.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount = 0) { return nullptr; }
+
+	/**
+	 * Return the number of logical CPU cores available to the process.
+	 */
+	virtual uint getCPUCount() const { return 1; }
+
+	/** @} */
+
+
 
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
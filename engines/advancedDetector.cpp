@@ -26,6 +26,7 @@
 #include "common/file.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/ptr.h"
 #include "common/config-manager.h"
 #include "common/punycode.h"
 #include "common/system.h"
@@ -476,6 +477,148 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+#define PERSISTENT_CACHE_FILENAME "detection-md5.cache"
+#define PERSISTENT_CACHE_MAGIC MKTAG('A', 'D', 'M', '5')
+#define PERSISTENT_CACHE_VERSION 1
+#define PERSISTENT_CACHE_SAVE_DELAY 10000
+
+static Common::FSNode getPersistentCacheNode() {
+	Common::Path configPath = ConfMan.getCustomConfigFileName();
+	if (configPath.empty())
+		configPath = g_system->getDefaultConfigFileName();
+
+	return Common::FSNode(configPath.getParent().appendComponent(PERSISTENT_CACHE_FILENAME));
+}
+
+bool AdvancedDetectorCacheManager::loadPersistentCache() {
+	if (_persistentState != kPersistentUnloaded)
+		return _persistentState == kPersistentLoaded;
+
+	if (ConfMan.hasKey("detection_md5_cache") && !ConfMan.getBool("detection_md5_cache")) {
+		_persistentState = kPersistentDisabled;
+		return false;
+	}
+
+	_persistentState = kPersistentLoaded;
+
+	Common::FSNode node = getPersistentCacheNode();
+	if (!node.exists())
+		return true;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return true;
+
+	if (stream->readUint32BE() != PERSISTENT_CACHE_MAGIC || stream->readUint32LE() != PERSISTENT_CACHE_VERSION) {
+		debugC(3, kDebugGlobalDetection, "Ignoring outdated MD5 cache '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return true;
+	}
+
+	uint32 count = stream->readUint32LE();
+	Common::StackLock lock(_persistentMutex);
+	_persistentMap.clear();
+
+	for (uint32 i = 0; i < count; i++) {
+		Common::String key = stream->readString();
+		PersistentEntry entry;
+		entry.fileSize = stream->readSint64LE();
+		entry.modificationTime = stream->readSint64LE();
+		entry.props.size = stream->readSint64LE();
+		entry.props.md5prop = (MD5Properties)stream->readUint32LE();
+		entry.props.md5 = stream->readString();
+
+		if (stream->err() || stream->eos()) {
+			warning("Truncated MD5 cache '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+			_persistentMap.clear();
+			break;
+		}
+
+		_persistentMap.setVal(key, entry);
+	}
+
+	debugC(3, kDebugGlobalDetection, "Loaded %u entries from MD5 cache", _persistentMap.size());
+	return true;
+}
+
+bool AdvancedDetectorCacheManager::getPersistentFileProperties(const Common::FSNode &node, const Common::String &hashname, FileProperties &fileProps) {
+	if (!loadPersistentCache())
+		return false;
+
+	int64 fileSize, modificationTime;
+	if (!node.getFileStatus(fileSize, modificationTime)) {
+		_persistentMisses++;
+		return false;
+	}
+
+	Common::String key = node.getPath().toString('/') + ':' + hashname;
+	Common::StackLock lock(_persistentMutex);
+	PersistentHashMap::const_iterator it = _persistentMap.find(key);
+	if (it == _persistentMap.end() || it->_value.fileSize != fileSize || it->_value.modificationTime != modificationTime) {
+		_persistentMisses++;
+		return false;
+	}
+
+	_persistentHits++;
+	fileProps = it->_value.props;
+	return true;
+}
+
+void AdvancedDetectorCacheManager::setPersistentFileProperties(const Common::FSNode &node, const Common::String &hashname, const FileProperties &fileProps) {
+	if (!loadPersistentCache())
+		return;
+
+	PersistentEntry entry;
+	if (!node.getFileStatus(entry.fileSize, entry.modificationTime))
+		return;
+
+	entry.props = fileProps;
+	Common::StackLock lock(_persistentMutex);
+	_persistentMap.setVal(node.getPath().toString('/') + ':' + hashname, entry);
+	_persistentDirty = true;
+}
+
+void AdvancedDetectorCacheManager::savePersistentCache(bool force) {
+	if (_persistentHits || _persistentMisses)
+		debugC(3, kDebugGlobalDetection, "MD5 cache: %u hits, %u misses", _persistentHits, _persistentMisses);
+
+	if (!_persistentDirty)
+		return;
+
+	uint32 now = g_system->getMillis();
+	if (!force && now - _persistentSaveTime < PERSISTENT_CACHE_SAVE_DELAY)
+		return;
+
+	Common::FSNode node = getPersistentCacheNode();
+	Common::ScopedPtr<Common::SeekableWriteStream> stream(node.createWriteStream());
+	if (!stream) {
+		warning("Could not write MD5 cache '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		_persistentDirty = false;
+		return;
+	}
+
+	Common::StackLock lock(_persistentMutex);
+	stream->writeUint32BE(PERSISTENT_CACHE_MAGIC);
+	stream->writeUint32LE(PERSISTENT_CACHE_VERSION);
+	stream->writeUint32LE(_persistentMap.size());
+
+	for (PersistentHashMap::const_iterator it = _persistentMap.begin(); it != _persistentMap.end(); ++it) {
+		stream->writeString(it->_key);
+		stream->writeByte(0);
+		stream->writeSint64LE(it->_value.fileSize);
+		stream->writeSint64LE(it->_value.modificationTime);
+		stream->writeSint64LE(it->_value.props.size);
+		stream->writeUint32LE(it->_value.props.md5prop);
+		stream->writeString(it->_value.props.md5);
+		stream->writeByte(0);
+	}
+
+	if (!stream->flush() || stream->err())
+		warning("Could not write MD5 cache '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+
+	_persistentDirty = false;
+	_persistentSaveTime = now;
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -549,7 +692,24 @@ bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles,
 		return true;
 	}
 
-	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
+	// Plain files are also looked up in the persistent cache, which survives
+	// restarts and is keyed by the full path rather than the detection path.
+	const Common::FSNode *node = nullptr;
+	Common::String persistentHashname;
+	FileMap::const_iterator file = allFiles.find(fname);
+	if (file != allFiles.end() && !(md5prop & (kMD5MacResFork | kMD5MacDataFork | kMD5Archive))) {
+		node = &file->_value;
+		persistentHashname = md5PropToCachePrefix(md5prop) + ':' + Common::String::format("%d", _md5Bytes);
+	}
+
+	bool res;
+	if (node && ADCacheMan.getPersistentFileProperties(*node, persistentHashname, fileProps)) {
+		res = true;
+	} else {
+		res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
+		if (res && node)
+			ADCacheMan.setPersistentFileProperties(*node, persistentHashname, fileProps);
+	}
 
 	if (res) {
 		ADCacheMan.setMD5(hashname, fileProps.md5);
@@ -563,6 +723,62 @@ bool AdvancedMetaEngineBase::getFilePropertiesExtern(uint md5Bytes, const FileMa
 	return getFilePropertiesIntern(md5Bytes, allFiles, md5prop, fname, fileProps);
 }
 
+bool AdvancedDetectorCacheManager::preparePrehash() {
+	if (!loadPersistentCache())
+		return false;
+
+	if (!_prehashRequests.empty())
+		return true;
+
+	// Detection tables do not change while running
+	const PluginList &plugins = EngineMan.getPlugins(PLUGIN_TYPE_ENGINE_DETECTION);
+	for (const auto &plugin : plugins) {
+		const AdvancedMetaEngineDetectionBase *metaEngine = dynamic_cast<const AdvancedMetaEngineDetectionBase *>(&plugin->get<MetaEngineDetection>());
+		if (metaEngine)
+			metaEngine->getPrehashRequests(_prehashRequests);
+	}
+
+	debugC(3, kDebugGlobalDetection, "Hashing %u file names ahead of detection", _prehashRequests.size());
+	return true;
+}
+
+void AdvancedDetectorCacheManager::prehashFiles(const Common::FSList &files, PrehashedFileList &results) const {
+	for (const auto &file : files) {
+		ADPrehashMap::const_iterator requests = _prehashRequests.find(file.getName());
+		if (requests == _prehashRequests.end() || file.isDirectory())
+			continue;
+
+		int64 fileSize, modificationTime;
+		if (!file.getFileStatus(fileSize, modificationTime))
+			continue;
+
+		for (const auto &request : requests->_value) {
+			PrehashedFile result;
+			result.hashname = md5PropToCachePrefix(request.md5prop) + ':' + Common::String::format("%d", request.md5Bytes);
+
+			{
+				Common::StackLock lock(_persistentMutex);
+				PersistentHashMap::const_iterator it = _persistentMap.find(file.getPath().toString('/') + ':' + result.hashname);
+				if (it != _persistentMap.end() && it->_value.fileSize == fileSize && it->_value.modificationTime == modificationTime)
+					continue;
+			}
+
+			AdvancedMetaEngineBase::FileMap allFiles;
+			allFiles[Common::Path(file.getName(), Common::Path::kNoSeparator)] = file;
+			if (!getFilePropertiesIntern(request.md5Bytes, allFiles, request.md5prop, Common::Path(file.getName(), Common::Path::kNoSeparator), result.props))
+				continue;
+
+			result.node = file;
+			results.push_back(result);
+		}
+	}
+}
+
+void AdvancedDetectorCacheManager::addPrehashedFiles(const PrehashedFileList &files) {
+	for (const auto &file : files)
+		setPersistentFileProperties(file.node, file.hashname, file.props);
+}
+
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) {
 	if (md5prop & (kMD5MacResFork | kMD5MacDataFork)) {
 		FileMapArchive fileMapArchive(allFiles);
@@ -706,6 +922,35 @@ void AdvancedMetaEngineDetectionBase::dumpDetectionEntries() const {
 	}
 }
 
+void AdvancedMetaEngineDetectionBase::getPrehashRequests(ADPrehashMap &files) const {
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+		const ADGameDescription *g = (const ADGameDescription *)descPtr;
+
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+			MD5Properties md5prop = gameFileToMD5Props(fileDesc, g->flags);
+
+			// Forks, archive members and files in subdirectories are only
+			// hashed during detection
+			if ((md5prop & (kMD5MacResFork | kMD5MacDataFork | kMD5Archive)) || strchr(fileDesc->fileName, '/'))
+				continue;
+
+			Common::Array<ADPrehashRequest> &requests = files[fileDesc->fileName];
+			bool found = false;
+			for (const auto &request : requests) {
+				if (request.md5prop == md5prop && request.md5Bytes == _md5Bytes) {
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				ADPrehashRequest request = { md5prop, _md5Bytes };
+				requests.push_back(request);
+			}
+		}
+	}
+}
+
 ADDetectedGames AdvancedMetaEngineDetectionBase::detectGame(const Common::FSNode &parent, const FileMap &allFiles, Common::Language language, Common::Platform platform, const Common::String &extra, uint32 skipADFlags, bool skipIncomplete) {
 	CachedPropertiesMap filesProps;
 	ADDetectedGames matched;
@@ -26,6 +26,7 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/mutex.h"
 
 #include "common/gui_options.h" // Keep it here, so detection tables can refer to them
 
@@ -404,6 +405,18 @@ struct ADExtraGuiOptionsMap {
 
 #define AD_EXTRA_GUI_OPTIONS_TERMINATOR { 0, { 0, 0, 0, 0, 0, 0 } }
 
+/**
+ * How the detection hashes a plain file, see
+ * @ref AdvancedDetectorCacheManager::preparePrehash.
+ */
+struct ADPrehashRequest {
+	MD5Properties md5prop; /*!< Part of the file that is hashed. */
+	uint md5Bytes;         /*!< Number of bytes hashed. */
+};
+
+/** Hash requests by case-insensitive file name. */
+typedef Common::HashMap<Common::String, Common::Array<ADPrehashRequest>, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> ADPrehashMap;
+
 /**
  * A @ref MetaEngineDetection implementation based on the Advanced Detector code.
  */
@@ -526,6 +539,12 @@ public:
 
 	void dumpDetectionEntries() const override;
 
+	/**
+	 * Add the plain files in the top directory of a game which the detection
+	 * hashes to @p files.
+	 */
+	void getPrehashRequests(ADPrehashMap &files) const;
+
 	/**
 	 * Sanitizes a string to be usable by gameId
 	 */
@@ -778,7 +797,72 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Look up the properties of a file in the persistent MD5 cache. This cache
+	 * is stored in the config directory, keyed by the full path of the file,
+	 * and entries only match while the size and modification time of the
+	 * file stay the same.
+	 *
+	 * @param node      The file.
+	 * @param hashname  Hash type of the file properties, including the number of bytes hashed.
+	 * @param fileProps Set to the cached properties.
+	 *
+	 * @return True if the cache has valid properties for the file, false otherwise.
+	 */
+	bool getPersistentFileProperties(const Common::FSNode &node, const Common::String &hashname, FileProperties &fileProps);
+
+	/**
+	 * Store the properties of a file in the persistent MD5 cache.
+	 *
+	 * @see getPersistentFileProperties
+	 */
+	void setPersistentFileProperties(const Common::FSNode &node, const Common::String &hashname, const FileProperties &fileProps);
+
+	/**
+	 * Write the persistent MD5 cache to disk, if it changed. Unless @p force
+	 * is set, the cache is written at most once every few seconds, so that
+	 * it can be called after every detection.
+	 */
+	void savePersistentCache(bool force);
+
+	/** A file hashed ahead of detection by prehashFiles(). */
+	struct PrehashedFile {
+		Common::FSNode node;
+		Common::String hashname;
+		FileProperties props;
+	};
+
+	typedef Common::Array<PrehashedFile> PrehashedFileList;
+
+	/**
+	 * Collect the plain files that the advanced detectors hash, so that
+	 * prehashFiles() can hash them ahead of detection. Must be called on
+	 * the main thread.
+	 *
+	 * @return False if the persistent MD5 cache is disabled, in which case
+	 *         hashing ahead of time is useless.
+	 */
+	bool preparePrehash();
+
+	/**
+	 * Hash the files of a directory which the advanced detectors will hash
+	 * and which are not in the persistent MD5 cache yet. This only reads the
+	 * files and the cache, so it can run on a worker thread, as long as the
+	 * nodes are not used by other threads meanwhile.
+	 */
+	void prehashFiles(const Common::FSList &files, PrehashedFileList &results) const;
+
+	/** Store the results of prehashFiles() in the persistent MD5 cache. */
+	void addPrehashedFiles(const PrehashedFileList &files);
+
+	/** Number of persistent MD5 cache lookups that found valid properties. */
+	uint getPersistentCacheHits() const { return _persistentHits; }
+
+	/** Number of persistent MD5 cache lookups that had to hash the file. */
+	uint getPersistentCacheMisses() const { return _persistentMisses; }
+
+	AdvancedDetectorCacheManager() : _persistentState(kPersistentUnloaded), _persistentDirty(false),
+		_persistentSaveTime(0), _persistentHits(0), _persistentMisses(0) {
 		clear();
 	}
 
@@ -804,6 +888,31 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+
+	struct PersistentEntry {
+		int64 fileSize;
+		int64 modificationTime;
+		FileProperties props;
+	};
+
+	enum PersistentState {
+		kPersistentUnloaded,
+		kPersistentLoaded,
+		kPersistentDisabled
+	};
+
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap _persistentMap;
+	/** Guards _persistentMap, which prehashFiles() reads from worker threads. */
+	mutable Common::Mutex _persistentMutex;
+	PersistentState _persistentState;
+	bool _persistentDirty;
+	uint32 _persistentSaveTime;
+	uint _persistentHits, _persistentMisses;
+
+	ADPrehashMap _prehashRequests;
+
+	bool loadPersistentCache();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
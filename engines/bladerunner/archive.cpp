@@ -42,7 +42,7 @@ bool MIXArchive::exists(const Common::Path &filename) {
 }
 
 bool MIXArchive::open(const Common::Path &filename) {
-	if (!_fd.open(filename)) {
+	if (!_fd.openMapped(filename)) {
 		error("MIXArchive::open(): Can not open %s", filename.toString(Common::Path::kNativeSeparator).c_str());
 		return false;
 	}
@@ -51,7 +51,7 @@ bool Lab::open(const Common::Path &filename, bool keepStream) {
 	bool result = true;
 
 	Common::File *file = new Common::File();
-	if (!file->open(filename) || file->readUint32BE() != MKTAG('L','A','B','N')) {
+	if (!file->openMapped(filename) || file->readUint32BE() != MKTAG('L','A','B','N')) {
 		result = false;
 	} else {
 		file->readUint32LE(); // version
@@ -62,6 +62,11 @@ bool Lab::open(const Common::Path &filename, bool keepStream) {
 			parseMonkey4FileTable(file);
 	}
 	if (result && keepStream) {
+		if (file->getView(0, file->size())) {
+			// The lab is mapped, so keep it rather than copying it
+			_stream = file;
+			return result;
+		}
 		file->seek(0, SEEK_SET);
 		byte *data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
 		file->read(data, file->size());
@@ -175,11 +180,12 @@ Common::SeekableReadStream *Lab::createReadStreamForMember(const Common::Path &p
 		Common::File *file = new Common::File();
 		file->open(_labFileName);
 		return new Common::SeekableSubReadStream(file, i->_offset, i->_offset + i->_len, DisposeAfterUse::YES);
+	} else if (i->_len == 0) {
+		return new Common::MemoryReadStream(nullptr, 0);
 	} else {
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * i->_len));
+		// Mapped labs hand out views of the mapping instead of copies
 		_stream->seek(i->_offset, SEEK_SET);
-		_stream->read(data, i->_len);
-		return new Common::MemoryReadStream(data, i->_len, DisposeAfterUse::YES);
+		return _stream->readStream(i->_len);
 	}
 }
 
@@ -194,7 +194,7 @@ bool Archive::open(const char *fileName, const char *room) {
 		_roomName = room;
 	}
 
-	if (_file.open(fileName)) {
+	if (_file.openMapped(fileName)) {
 		readDirectory();
 		return true;
 	}
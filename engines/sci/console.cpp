@@ -31,6 +31,7 @@
 #include "sci/engine/state.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/selector.h"
+#include "sci/engine/selector_lookup.h"
 #include "sci/engine/savegame.h"
 #include "sci/engine/gc.h"
 #include "sci/engine/features.h"
@@ -54,6 +55,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -117,6 +119,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -150,6 +153,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("list_build",         WRAP_METHOD(Console, cmdListBuild));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -202,6 +207,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("send",				WRAP_METHOD(Console, cmdSend));
 	registerCmd("go",					WRAP_METHOD(Console, cmdGo));
 	registerCmd("logkernel",          WRAP_METHOD(Console, cmdLogKernel));
+	registerCmd("selector_cache",     WRAP_METHOD(Console, cmdSelectorCache));
 	registerCmd("vocab994",          WRAP_METHOD(Console, cmdMapVocab994));
 	registerCmd("gameflags_init",    WRAP_METHOD(Console, cmdGameFlagsInit));
 	registerCmd("gameflags_test",    WRAP_METHOD(Console, cmdGameFlagsTest));
@@ -357,6 +363,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows the use and the statistics of the resource cache\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -386,6 +393,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" list_build - Shows the time spent calculating the draw lists, or selects how they find screen items (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows the use and the statistics of the cache of decompressed and scaled cels (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -429,6 +438,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" send - Sends a message to an object\n");
 	debugPrintf(" go - Executes the script\n");
 	debugPrintf(" logkernel - Logs kernel calls\n");
+	debugPrintf(" selector_cache - Shows the hit rates of the selector lookup caches\n");
 	debugPrintf(" gameflags_init - Initialize gameflag commands if necessary\n");
 	debugPrintf(" gameflags_test / tf - Test game flags\n");
 	debugPrintf(" gameflags_set / sf - Sets game flags\n");
@@ -1134,6 +1144,39 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Shows the use and the statistics of the resource cache.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		debugPrintf("With \"reset\", the statistics are set back to zero.\n");
+		return true;
+	}
+
+	ResourceManager *resMan = _engine->getResMan();
+	if (argc == 2) {
+		resMan->resetCacheStats();
+		debugPrintf("Resource cache statistics reset\n");
+		return true;
+	}
+
+	static const char *const poolNames[kResourcePoolCount] = { "Audio", "Graphics", "Scripts", "Other" };
+	for (int i = 0; i < kResourcePoolCount; ++i) {
+		int maxMemory, memory;
+		resMan->getPoolMemory((ResourcePool)i, maxMemory, memory);
+		debugPrintf("%s pool: %d of %d KiB\n", poolNames[i], memory / 1024, maxMemory / 1024);
+	}
+
+	const ResourceManager::CacheStats &stats = resMan->getCacheStats();
+	const uint32 requests = stats.hits + stats.misses;
+	debugPrintf("Requests: %u hits, %u misses (%.1f%% hits)\n",
+		stats.hits, stats.misses, requests ? 100.0f * stats.hits / requests : 0.0f);
+	debugPrintf("Loaded and decompressed: %u KiB\n", stats.bytesLoaded / 1024);
+	debugPrintf("Stalled %u ms loading requested resources\n", stats.stallTime);
+	debugPrintf("Prefetched %u resources, %u of them requested later\n", stats.prefetched, stats.prefetchHits);
+
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -2174,6 +2217,82 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdListBuild(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "scalar") != 0 && strcmp(argv[1], "indexed") != 0 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Shows the time spent and the screen item tests made calculating the draw and erase lists of the planes.\n");
+		debugPrintf("Usage: %s [scalar | indexed | reset]\n", argv[0]);
+		debugPrintf("With \"scalar\", every screen item is tested against the rects of the lists.\n");
+		debugPrintf("With \"indexed\", the screen items are found through a tile index.\n");
+		debugPrintf("With \"reset\", the statistics are set back to zero.\n");
+		return true;
+	}
+
+#ifdef ENABLE_SCI32
+	GfxFrameout *frameout = _engine->_gfxFrameout;
+	if (!frameout) {
+		debugPrintf("This SCI version does not have a list of planes\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!strcmp(argv[1], "reset")) {
+			frameout->resetListBuildStats();
+			debugPrintf("List build statistics reset\n");
+		} else {
+			frameout->_useScreenItemTileIndex = !strcmp(argv[1], "indexed");
+			frameout->resetListBuildStats();
+			debugPrintf("Screen items are now found %s\n", frameout->_useScreenItemTileIndex ? "through the tile index" : "by testing all of them");
+		}
+		return true;
+	}
+
+	const GfxFrameout::ListBuildStats &stats = frameout->getListBuildStats();
+	debugPrintf("Screen items found %s\n", frameout->_useScreenItemTileIndex ? "through the tile index" : "by testing all of them");
+	debugPrintf("Frames: %u\n", stats.frames);
+	debugPrintf("Last frame: %u screen item tests\n", stats.lastTests);
+	debugPrintf("Total: %u ms, %u screen item tests\n", stats.totalTime, stats.totalTests);
+	debugPrintf("Average: %.3f ms, %.1f screen item tests\n",
+		stats.frames ? (float)stats.totalTime / stats.frames : 0.0f,
+		stats.frames ? (float)stats.totalTests / stats.frames : 0.0f);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
+bool Console::cmdCelCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Shows the use and the statistics of the cache of decompressed and scaled cels.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		debugPrintf("With \"reset\", the statistics are set back to zero.\n");
+		return true;
+	}
+
+#ifdef ENABLE_SCI32
+	CelBitmapCache *cache = CelObj::_bitmapCache;
+	if (!cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		cache->resetStats();
+		debugPrintf("Cel cache statistics reset\n");
+		return true;
+	}
+
+	const CelBitmapCache::Stats &stats = cache->getStats();
+	const uint32 requests = stats.hits + stats.misses;
+	debugPrintf("%u bitmaps, %u of %u KiB\n", cache->getBitmapCount(), cache->getMemory() / 1024, cache->getMaxMemory() / 1024);
+	debugPrintf("Requests: %u hits, %u misses (%.1f%% hits)\n",
+		stats.hits, stats.misses, requests ? 100.0f * stats.hits / requests : 0.0f);
+	debugPrintf("Bitmaps created: %u, evicted: %u\n", stats.created, stats.evicted);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (_engine->_gfxFrameout) {
@@ -4051,6 +4170,35 @@ bool Console::cmdGo(int argc, const char **argv) {
 	return cmdExit(argc, argv);
 }
 
+static float selectorCacheHitRate(uint32 hits, uint32 misses) {
+	return hits + misses ? 100.0f * hits / (hits + misses) : 0.0f;
+}
+
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Shows the hit rates of the selector lookup caches.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		debugPrintf("With \"reset\", the counters are set back to zero.\n");
+		return true;
+	}
+
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+	if (argc == 2) {
+		cache.resetStats();
+		debugPrintf("Selector lookup cache counters reset\n");
+		return true;
+	}
+
+	const SelectorLookupCache::Stats &stats = cache.getStats();
+	debugPrintf("Inline caches: %u hits, %u misses (%.1f%% hits)\n",
+		stats.inlineHits, stats.inlineMisses, selectorCacheHitRate(stats.inlineHits, stats.inlineMisses));
+	debugPrintf("Class selector hash: %u hits, %u misses (%.1f%% hits), %u entries\n",
+		stats.hashHits, stats.hashMisses, selectorCacheHitRate(stats.hashHits, stats.hashMisses), cache.getHashSize());
+	debugPrintf("Flushed %u times by script loads and unloads\n", stats.flushes);
+
+	return true;
+}
+
 bool Console::cmdLogKernel(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Logs calls to specified kernel function.\n");
@@ -76,6 +76,7 @@ private:
 	bool cmdList(int argc, const char **argv);
 	bool cmdResourceIntegrityDump(int argc, const char **argv);
 	bool cmdAllocList(int argc, const char **argv);
+	bool cmdResourceCache(int argc, const char **argv);
 	bool cmdHexgrep(int argc, const char **argv);
 	bool cmdVerifyScripts(int argc, const char **argv);
 	// Game
@@ -99,6 +100,8 @@ private:
 	bool cmdWindowList(int argc, const char **argv);
 	bool cmdPlaneList(int argc, const char **argv);
 	bool cmdVisiblePlaneList(int argc, const char **argv);
+	bool cmdListBuild(int argc, const char **argv);
+	bool cmdCelCache(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
 	bool cmdVisiblePlaneItemList(int argc, const char **argv);
 	bool cmdSavedBits(int argc, const char **argv);
@@ -143,6 +146,7 @@ private:
 	bool cmdSend(int argc, const char **argv);
 	bool cmdGo(int argc, const char **argv);
 	bool cmdLogKernel(int argc, const char **argv);
+	bool cmdSelectorCache(int argc, const char **argv);
 	bool cmdMapVocab994(int argc, const char **argv);
 	bool cmdGameFlagsInit(int argc, const char **argv);
 	bool cmdGameFlagsTest(int argc, const char **argv);
@@ -45,6 +45,15 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// The resource is only loaded once it is used, in the meantime it can
+	// be loaded ahead while the engine is idle
+	ResourceType prefetchType = restype;
+	if (prefetchType == kResourceTypeSound && getSciVersion() >= SCI_VERSION_1_1)
+		prefetchType = g_sci->_soundCmd->getSoundResourceType(resnr);
+	const ResourceId id(prefetchType, resnr);
+	g_sci->getResMan()->recordRoomResource(s->variables[VAR_GLOBAL][kGlobalVarCurrentRoomNo].toUint16(), id);
+	g_sci->getResMan()->prefetchResource(id);
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
@@ -106,6 +115,7 @@ reg_t kLock(EngineState *s, int argc, reg_t *argv) {
 	}
 
 	if (lock) {
+		g_sci->getResMan()->recordRoomResource(s->variables[VAR_GLOBAL][kGlobalVarCurrentRoomNo].toUint16(), id);
 		g_sci->getResMan()->findResource(id, true);
 	} else {
 		if (getSciVersion() < SCI_VERSION_2 && id.getNumber() == 0xFFFF) {
@@ -74,6 +74,30 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	clearDecodedInstructions();
+}
+
+const DecodedInstruction &Script::decodeInstruction(uint32 offset) {
+	// The heap of SCI1.1 - SCI2.1 scripts holds no code
+	const uint32 codeSize = getHeapOffset() ? getHeapOffset() : getBufSize();
+	if (_instructionIndex.empty())
+		_instructionIndex.resize(codeSize);
+
+	// SCI3 code may hold more instructions than the index can address
+	DecodedInstruction *instruction = &_uncachedInstruction;
+	if (offset < codeSize && _instructions.size() < 0xFFFF) {
+		_instructions.push_back(DecodedInstruction());
+		_instructionIndex[offset] = _instructions.size();
+		instruction = &_instructions.back();
+	}
+
+	int16 opparams[4];
+	instruction->size = readPMachineInstruction(getBuf(offset), instruction->extOpcode, opparams);
+	for (int i = 0; i < ARRAYSIZE(instruction->opparams); i++)
+		instruction->opparams[i] = opparams[i];
+
+	return *instruction;
 }
 
 enum {
@@ -68,6 +68,13 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/** An instruction as decoded by readPMachineInstruction(). */
+struct DecodedInstruction {
+	uint16 size; ///< Length of the instruction in bytes
+	byte extOpcode;
+	int16 opparams[3];
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -101,6 +108,21 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * The instructions of the code, in the order they were decoded. They are
+	 * decoded the first time they are executed, which is after the script
+	 * patches have been applied.
+	 */
+	Common::Array<DecodedInstruction> _instructions;
+	/**
+	 * For each offset of the code, one more than the index of its instruction
+	 * in _instructions, or 0 if the instruction there has not been decoded.
+	 */
+	Common::Array<uint16> _instructionIndex;
+	DecodedInstruction _uncachedInstruction;
+
+	const DecodedInstruction &decodeInstruction(uint32 offset);
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -131,6 +153,26 @@ public:
 		return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
 	}
 
+	/**
+	 * Returns the instruction at the given offset, which is only decoded
+	 * the first time. The returned reference is valid until the next call.
+	 */
+	// speed optimization: inline due to frequent calling
+	const DecodedInstruction &getInstruction(uint32 offset) {
+		if (offset < _instructionIndex.size() && _instructionIndex[offset])
+			return _instructions[_instructionIndex[offset] - 1];
+		return decodeInstruction(offset);
+	}
+
+	/**
+	 * Forgets the decoded instructions, for when the code of the script
+	 * has been written to.
+	 */
+	void clearDecodedInstructions() {
+		_instructions.clear();
+		_instructionIndex.clear();
+	}
+
 public:
 	Script();
 	~Script() override;
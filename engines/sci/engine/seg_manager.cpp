@@ -79,6 +79,8 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	_selectorLookupCache.flush();
 }
 
 void SegManager::initSysStrings() {
@@ -165,6 +167,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		_selectorLookupCache.flush();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -784,6 +787,7 @@ void SegManager::memcpy(reg_t dest, const byte* src, size_t n) {
 	if (dest_r.isRaw) {
 		// raw -> raw
 		forwardCopy<false>(dest_r.raw, src, n);
+		invalidateScriptCode(dest.getSegment());
 	} else {
 		// raw -> non-raw
 		for (uint i = 0; i < n; i++)
@@ -817,6 +821,7 @@ void SegManager::memcpy(reg_t dest, reg_t src, size_t n) {
 	} else if (dest_r.isRaw) {
 		// * -> raw
 		memcpy(dest_r.raw, src, n);
+		invalidateScriptCode(dest.getSegment());
 	} else {
 		// non-raw -> non-raw
 		for (uint i = 0; i < n; i++) {
@@ -826,6 +831,11 @@ void SegManager::memcpy(reg_t dest, reg_t src, size_t n) {
 	}
 }
 
+void SegManager::invalidateScriptCode(SegmentId seg) {
+	if (getSegmentType(seg) == SEG_TYPE_SCRIPT)
+		getScript(seg)->clearDecodedInstructions();
+}
+
 void SegManager::memcpy(byte *dest, reg_t src, size_t n) {
 	const SegmentRef src_r = dereference(src);
 	if (!src_r.isValid()) {
@@ -1106,6 +1116,9 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
 
+	// The objects of the script may reuse the positions of cached lookups
+	_selectorLookupCache.flush();
+
 	return segmentId;
 }
 
@@ -1136,6 +1149,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_selectorLookupCache.flush();
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
@@ -28,6 +28,7 @@
 #include "sci/engine/vm.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/segment.h"
+#include "sci/engine/selector_lookup.h"
 #ifdef ENABLE_SCI32
 #include "sci/graphics/celobj32.h" // kLowResX, kLowResY
 #endif
@@ -360,6 +361,13 @@ public:
 	 */
 	void memcpy(byte *dest, reg_t src, size_t n);
 
+	/**
+	 * Forgets the decoded instructions of the script in the given segment,
+	 * for when its code may have been written to. Other segments are
+	 * ignored.
+	 */
+	void invalidateScriptCode(SegmentId seg);
+
 	/**
 	 * Determine length of string at str.
 	 * str can point to a raw or non-raw segment.
@@ -460,6 +468,8 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	SelectorLookupCache &getSelectorLookupCache() { return _selectorLookupCache; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -483,6 +493,8 @@ private:
 	SegmentId _bitmapSegId;
 #endif
 
+	SelectorLookupCache _selectorLookupCache;
+
 public:
 	SegmentId allocSegment(SegmentObj *mobj);
 
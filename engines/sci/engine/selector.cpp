@@ -25,6 +25,7 @@
 #include "sci/engine/scriptdebug.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
+#include "sci/engine/selector_lookup.h"
 
 namespace Sci {
 
@@ -323,7 +324,7 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
-SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr, reg_t callSite) {
 	const Object *obj = segMan->getObject(obj_location);
 	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
 
@@ -336,31 +337,19 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
 	}
 
-	int index = obj->locateVarSelector(segMan, selectorId);
+	const SelectorLookupCache::Result result = segMan->getSelectorLookupCache().lookup(segMan, obj, selectorId, callSite);
 
-	if (index >= 0) {
-		// Found it as a variable
+	if (result.type == kSelectorVariable) {
 		if (varp) {
 			varp->obj = obj_location;
-			varp->varindex = index;
+			varp->varindex = result.varIndex;
 		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
-			}
-		}
-
-		return kSelectorNone;
+	} else if (result.type == kSelectorMethod) {
+		if (fptr)
+			*fptr = result.func;
 	}
+
+	return result.type;
 }
 
 } // End of namespace Sci
@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "sci/engine/object.h"
+#include "sci/engine/seg_manager.h"
+#include "sci/engine/selector_lookup.h"
+
+namespace Sci {
+
+SelectorLookupCache::SelectorLookupCache() {
+	flush();
+	resetStats();
+}
+
+SelectorLookupCache::Result SelectorLookupCache::lookup(SegManager *segMan, const Object *obj, Selector selector, reg_t callSite) {
+	Key key;
+	key.pos = obj->getPos();
+	key.superClass = obj->getSuperClassSelector();
+	key.selector = selector;
+	key.isClass = obj->isClass();
+
+	if (callSite.isNull())
+		return lookupHash(segMan, obj, key);
+
+	InlineCache &cache = _inlineCaches[(callSite.getOffset() ^ (callSite.getSegment() * 0x9E37)) & (kInlineCacheCount - 1)];
+	if (cache.callSite == callSite) {
+		for (uint i = 0; i < cache.count; i++) {
+			if (cache.keys[i] == key) {
+				_stats.inlineHits++;
+				return cache.results[i];
+			}
+		}
+	} else {
+		// Another instruction used the same cache, take it over
+		cache.callSite = callSite;
+		cache.count = 0;
+		cache.replaced = 0;
+	}
+
+	_stats.inlineMisses++;
+	const Result result = lookupHash(segMan, obj, key);
+
+	uint entry;
+	if (cache.count < kInlineCacheEntries) {
+		entry = cache.count++;
+	} else {
+		entry = cache.replaced;
+		cache.replaced = (cache.replaced + 1) % kInlineCacheEntries;
+	}
+	cache.keys[entry] = key;
+	cache.results[entry] = result;
+
+	return result;
+}
+
+SelectorLookupCache::Result SelectorLookupCache::lookupHash(SegManager *segMan, const Object *obj, const Key &key) {
+	Common::HashMap<Key, Result, KeyHash>::const_iterator it = _hash.find(key);
+	if (it != _hash.end()) {
+		_stats.hashHits++;
+		return it->_value;
+	}
+
+	_stats.hashMisses++;
+	const Result result = find(segMan, obj, key.selector);
+	_hash[key] = result;
+	return result;
+}
+
+SelectorLookupCache::Result SelectorLookupCache::find(SegManager *segMan, const Object *obj, Selector selector) {
+	Result result;
+	result.type = kSelectorNone;
+	result.varIndex = -1;
+	result.func = NULL_REG;
+
+	int index = obj->locateVarSelector(segMan, selector);
+
+	if (index >= 0) {
+		// Found it as a variable
+		result.type = kSelectorVariable;
+		result.varIndex = index;
+		return result;
+	}
+
+	// Check if it's a method, with recursive lookup in superclasses
+	while (obj) {
+		index = obj->funcSelectorPosition(selector);
+		if (index >= 0) {
+			result.type = kSelectorMethod;
+			result.func = obj->getFunction(index);
+			return result;
+		}
+
+		obj = segMan->getObject(obj->getSuperClassSelector());
+	}
+
+	return result;
+}
+
+void SelectorLookupCache::flush() {
+	for (uint i = 0; i < kInlineCacheCount; i++) {
+		_inlineCaches[i].callSite = NULL_REG;
+		_inlineCaches[i].count = 0;
+		_inlineCaches[i].replaced = 0;
+	}
+
+	_hash.clear();
+	_stats.flushes++;
+}
+
+void SelectorLookupCache::resetStats() {
+	_stats.inlineHits = 0;
+	_stats.inlineMisses = 0;
+	_stats.hashHits = 0;
+	_stats.hashMisses = 0;
+	_stats.flushes = 0;
+}
+
+} // End of namespace Sci
@@ -0,0 +1,131 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCI_ENGINE_SELECTOR_LOOKUP_H
+#define SCI_ENGINE_SELECTOR_LOOKUP_H
+
+#include "common/hashmap.h"
+
+#include "sci/engine/vm.h"
+#include "sci/engine/vm_types.h"
+
+namespace Sci {
+
+class Object;
+class SegManager;
+
+/**
+ * Caches the results of lookupSelector().
+ *
+ * Where a selector is found only depends on the script object the receiver
+ * was created from (its position, which clones share with the object they
+ * were cloned from), on its superclass and on whether it is a class. These
+ * make up the key of the cached lookups, so an object whose class changes
+ * simply uses other entries.
+ *
+ * Each send instruction has an inline cache of the last few receivers it
+ * has seen, found by the address of the instruction. The lookups missing
+ * it, as well as those of the kernel functions, go through a hash of the
+ * selectors of each class. Both are flushed when scripts are loaded or
+ * unloaded, as that reuses object positions and instruction addresses.
+ */
+class SelectorLookupCache {
+public:
+	struct Result {
+		SelectorType type;
+		int varIndex; ///< Index of the variable, for kSelectorVariable
+		reg_t func;   ///< Address of the method, for kSelectorMethod
+	};
+
+	struct Stats {
+		uint32 inlineHits;
+		uint32 inlineMisses;
+		uint32 hashHits;
+		uint32 hashMisses;
+		uint32 flushes;
+	};
+
+	SelectorLookupCache();
+
+	/**
+	 * Looks up a selector of an object.
+	 * @param segMan    The segment manager
+	 * @param obj       The object to look the selector up in
+	 * @param selector  The selector to look up
+	 * @param callSite  Address of the send instruction, or NULL_REG when
+	 *                  not called from a send instruction
+	 */
+	Result lookup(SegManager *segMan, const Object *obj, Selector selector, reg_t callSite);
+
+	/** Forgets all the cached lookups. */
+	void flush();
+
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+	uint getHashSize() const { return _hash.size(); }
+
+private:
+	enum {
+		kInlineCacheCount = 512, ///< Number of inline caches, a power of 2
+		kInlineCacheEntries = 4  ///< Number of receivers in an inline cache
+	};
+
+	struct Key {
+		reg_t pos;
+		reg_t superClass;
+		Selector selector;
+		bool isClass;
+
+		bool operator==(const Key &other) const {
+			return pos == other.pos && superClass == other.superClass &&
+			       selector == other.selector && isClass == other.isClass;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return (key.pos.getSegment() << 3) ^ key.pos.getOffset() ^
+			       (key.superClass.getSegment() << 19) ^ (key.superClass.getOffset() << 7) ^
+			       ((uint)key.selector * 2654435761U) ^ (uint)key.isClass;
+		}
+	};
+
+	struct InlineCache {
+		reg_t callSite;
+		uint count;    ///< Number of entries in use
+		uint replaced; ///< Next entry to replace once all are in use
+		Key keys[kInlineCacheEntries];
+		Result results[kInlineCacheEntries];
+	};
+
+	/** The uncached lookup, walking the superclass chain. */
+	static Result find(SegManager *segMan, const Object *obj, Selector selector);
+
+	Result lookupHash(SegManager *segMan, const Object *obj, const Key &key);
+
+	InlineCache _inlineCaches[kInlineCacheCount];
+	Common::HashMap<Key, Result, KeyHash> _hash;
+	Stats _stats;
+};
+
+} // End of namespace Sci
+
+#endif // SCI_ENGINE_SELECTOR_LOOKUP_H
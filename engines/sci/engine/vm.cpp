@@ -236,7 +236,7 @@ static void _exec_varselectors(EngineState *s) {
 }
 
 
-ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPtr sp, int framesize, StackPtr argp) {
+ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPtr sp, int framesize, StackPtr argp, reg_t callSite) {
 	// send_obj and work_obj are equal for anything but 'super'
 	// Returns a pointer to the TOS exec_stack element
 	assert(s);
@@ -262,7 +262,7 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 		g_sci->_guestAdditions->sendSelectorHook(send_obj, selector, argp);
 #endif
 
-		SelectorType selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp);
+		SelectorType selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp, callSite);
 		if (selectorType == kSelectorNone)
 			error("Send to invalid selector 0x%x (%s) of object at %04x:%04x", 0xffff & selector, g_sci->getKernel()->getSelectorName(0xffff & selector).c_str(), PRINT_REG(send_obj));
 
@@ -547,7 +547,7 @@ void run_vm(EngineState *s) {
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
-	int16 opparams[4]; // opcode parameters
+	int16 opparams[4] = { 0, 0, 0, 0 }; // opcode parameters
 
 	s->r_rest = 0;	// &rest adjusts the parameter count by this value
 	// Current execution data:
@@ -605,16 +605,21 @@ void run_vm(EngineState *s) {
 			s->variables[VAR_PARAM] = s->xs->variables_argp;
 		}
 
-		g_sci->checkAddressBreakpoint(s->xs->addr.pc);
-
-		// Debug if this has been requested:
-		// TODO: re-implement sci_debug_flags
-		if (g_sci->_debugState.debugging /* sci_debug_flags*/) {
-			g_sci->scriptDebug();
-			g_sci->_debugState.breakpointWasHit = false;
+		// The debugger only needs to see each instruction while debugging,
+		// with address breakpoints or when it is about to be opened
+		if (g_sci->_debugState.debugging || (g_sci->_debugState._activeBreakpointTypes & BREAK_ADDRESS) ||
+			g_sci->getSciDebugger()->isAttached()) {
+			g_sci->checkAddressBreakpoint(s->xs->addr.pc);
+
+			// Debug if this has been requested:
+			// TODO: re-implement sci_debug_flags
+			if (g_sci->_debugState.debugging /* sci_debug_flags*/) {
+				g_sci->scriptDebug();
+				g_sci->_debugState.breakpointWasHit = false;
+			}
+			Console *con = g_sci->getSciDebugger();
+			con->onFrame();
 		}
-		Console *con = g_sci->getSciDebugger();
-		con->onFrame();
 
 		if (s->xs->sp < s->xs->fp)
 			error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
@@ -624,9 +629,14 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. The instruction is copied, as executing it may free
+		// or reload the script.
+		const DecodedInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+		const byte extOpcode = instruction.extOpcode;
+		opparams[0] = instruction.opparams[0];
+		opparams[1] = instruction.opparams[1];
+		opparams[2] = instruction.opparams[2];
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -968,7 +978,8 @@ void run_vm(EngineState *s) {
 
 			s->xs->sp[1].incOffset(s->r_rest);
 			xs_new = send_selector(s, s->r_acc, s->r_acc, s_temp,
-									(int)(opparams[0] >> 1) + (uint16)s->r_rest, s->xs->sp);
+									(int)(opparams[0] >> 1) + (uint16)s->r_rest, s->xs->sp,
+									s->xs->addr.pc);
 
 			if (xs_new && xs_new != s->xs)
 				s->_executionStackPosChanged = true;
@@ -1015,7 +1026,7 @@ void run_vm(EngineState *s) {
 			s->xs->sp[1].incOffset(s->r_rest);
 			xs_new = send_selector(s, s->xs->objp, s->xs->objp,
 									s_temp, (int)(opparams[0] >> 1) + (uint16)s->r_rest,
-									s->xs->sp);
+									s->xs->sp, s->xs->addr.pc);
 
 			if (xs_new && xs_new != s->xs)
 				s->_executionStackPosChanged = true;
@@ -1044,7 +1055,7 @@ void run_vm(EngineState *s) {
 				s->xs->sp[1].incOffset(s->r_rest);
 				xs_new = send_selector(s, r_temp, s->xs->objp, s_temp,
 										(int)(opparams[1] >> 1) + (uint16)s->r_rest,
-										s->xs->sp);
+										s->xs->sp, s->xs->addr.pc);
 
 				if (xs_new && xs_new != s->xs)
 					s->_executionStackPosChanged = true;
@@ -361,10 +361,11 @@ ExecStack *execute_method(EngineState *s, uint16 script, uint16 pubfunct,
  * 						[selector_number][argument_counter] and then
  * 						"argument_counter" word entries with the
  * 						parameter values.
+ * @param[in] callSite	Address of the send instruction, or NULL_REG
  * @return				A pointer to the new execution stack TOS entry
  */
 ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj,
-	StackPtr sp, int framesize, StackPtr argp);
+	StackPtr sp, int framesize, StackPtr argp, reg_t callSite = NULL_REG);
 
 
 /**
@@ -388,6 +389,8 @@ void run_vm(EngineState *s);
  * 							fptr is written to iff it is non-NULL and the
  * 							selector indicates a member function of that
  * 							object.
+ * @param[in] callSite		Address of the send instruction doing the
+ * 							lookup, for its inline cache, or NULL_REG
  * @return					kSelectorNone if the selector was not found in
  * 							the object or its superclasses.
  * 							kSelectorVariable if the selector represents an
@@ -396,7 +399,7 @@ void run_vm(EngineState *s);
  * 							method
  */
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
-		ObjVarRef *varp, reg_t *fptr);
+		ObjVarRef *varp, reg_t *fptr, reg_t callSite = NULL_REG);
 
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
@@ -81,16 +81,102 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 	return _scaleTables[_activeIndex];
 }
 
+#pragma mark -
+#pragma mark CelBitmapCache
+
+CelBitmapCache::CelBitmapCache(const uint32 maxMemory) :
+	_maxMemory(maxMemory),
+	_memory(0),
+	_bitmapCount(0) {
+	resetStats();
+}
+
+Common::SharedPtr<Buffer> CelBitmapCache::find(const CelBitmapKey &key, bool &shouldCreate) {
+	shouldCreate = false;
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		++_stats.misses;
+		makeRoom(kRequestSize);
+		Entry &entry = _entries[key];
+		entry.size = kRequestSize;
+		entry.lru = _lru.insert(_lru.end(), key);
+		_memory += kRequestSize;
+		return Common::SharedPtr<Buffer>();
+	}
+
+	Entry &entry = it->_value;
+	_lru.erase(entry.lru);
+	entry.lru = _lru.insert(_lru.end(), key);
+
+	if (!entry.bitmap) {
+		++_stats.misses;
+		shouldCreate = true;
+		return Common::SharedPtr<Buffer>();
+	}
+
+	++_stats.hits;
+	return entry.bitmap;
+}
+
+void CelBitmapCache::put(const CelBitmapKey &key, const Common::SharedPtr<Buffer> &bitmap) {
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		removeEntry(it);
+	}
+
+	const uint32 size = bitmap->w * bitmap->h;
+	if (size > _maxMemory) {
+		return;
+	}
+
+	makeRoom(size);
+	Entry &entry = _entries[key];
+	entry.bitmap = bitmap;
+	entry.size = size;
+	entry.lru = _lru.insert(_lru.end(), key);
+	_memory += size;
+	++_bitmapCount;
+	++_stats.created;
+}
+
+void CelBitmapCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void CelBitmapCache::removeEntry(EntryMap::iterator it) {
+	Entry &entry = it->_value;
+	_memory -= entry.size;
+	if (entry.bitmap) {
+		--_bitmapCount;
+		++_stats.evicted;
+	}
+	_lru.erase(entry.lru);
+	_entries.erase(it);
+}
+
+void CelBitmapCache::makeRoom(const uint32 size) {
+	while (_memory + size > _maxMemory && !_lru.empty()) {
+		removeEntry(_entries.find(_lru.front()));
+	}
+}
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
 
+/**
+ * The memory used by the bitmaps of the cel bitmap cache.
+ */
+static const uint32 kCelBitmapCacheSize = 4 * 1024 * 1024;
+
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
 	_cache = new CelCache(100);
+	_bitmapCache = new CelBitmapCache(kCelBitmapCacheSize);
 }
 
 void CelObj::deinit() {
@@ -98,6 +184,8 @@ void CelObj::deinit() {
 	_scaler = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _bitmapCache;
+	_bitmapCache = nullptr;
 }
 
 #pragma mark -
@@ -279,7 +367,30 @@ struct SCALER_Scale {
 				for (int16 y = targetRect.top; y < targetRect.bottom; ++y) {
 					_valuesY[y] = table.valuesY[y] - unscaledY;
 				}
+
+				// The source pixels depend on the position of the cel, so only
+				// the decompressed cel can be reused
+				_sourceBuffer = celObj.getCachedBitmap(Ratio(), Ratio(), false);
 			} else {
+				// The scaled pixels only depend on the position relative to
+				// the cel, so a pre-scaled bitmap can be drawn unscaled
+				_sourceBuffer = celObj.getCachedBitmap(scaleX, scaleY, FLIP);
+				if (_sourceBuffer &&
+					targetRect.left >= scaledPosition.x &&
+					targetRect.top >= scaledPosition.y &&
+					targetRect.right - scaledPosition.x <= _sourceBuffer->w &&
+					targetRect.bottom - scaledPosition.y <= _sourceBuffer->h
+				) {
+					for (int16 x = targetRect.left; x < targetRect.right; ++x) {
+						_valuesX[x] = x - scaledPosition.x;
+					}
+					for (int16 y = targetRect.top; y < targetRect.bottom; ++y) {
+						_valuesY[y] = y - scaledPosition.y;
+					}
+					return;
+				}
+
+				_sourceBuffer.reset();
 				if (FLIP) {
 					const int lastIndex = celObj._width - 1;
 					for (int16 x = targetRect.left; x < targetRect.right; ++x) {
@@ -739,6 +850,92 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	entry.id = ++_nextCacheId;
 }
 
+CelBitmapCache *CelObj::_bitmapCache = nullptr;
+
+static void scaleCelBitmap(const CelObj &celObj, Buffer &bitmap, const int *valuesX, const int *valuesY, const bool mirrorX) {
+	READER_Compressed reader(celObj, celObj._width);
+	const int lastIndex = celObj._width - 1;
+	for (int16 y = 0; y < bitmap.h; ++y) {
+		const byte *source = reader.getRow(valuesY[y]);
+		byte *target = (byte *)bitmap.getBasePtr(0, y);
+		if (mirrorX) {
+			for (int16 x = 0; x < bitmap.w; ++x) {
+				*target++ = source[lastIndex - valuesX[x]];
+			}
+		} else {
+			for (int16 x = 0; x < bitmap.w; ++x) {
+				*target++ = source[valuesX[x]];
+			}
+		}
+	}
+}
+
+Common::SharedPtr<Buffer> CelObj::getCachedBitmap(const Ratio &scaleX, const Ratio &scaleY, const bool mirrorX) const {
+	// Uncompressed cels are already read straight from their resource
+	if (
+		_bitmapCache == nullptr ||
+		(_info.type != kCelTypeView && _info.type != kCelTypePic) ||
+		_compressionType != kCelCompressionRLE
+	) {
+		return Common::SharedPtr<Buffer>();
+	}
+
+	CelBitmapKey key;
+	key.type = _info.type;
+	key.resourceId = _info.resourceId;
+	key.loopNo = _info.loopNo;
+	key.celNo = _info.celNo;
+	key.scaleXNum = scaleX.getNumerator();
+	key.scaleXDenom = scaleX.getDenominator();
+	key.scaleYNum = scaleY.getNumerator();
+	key.scaleYDenom = scaleY.getDenominator();
+	key.mirrorX = mirrorX;
+
+	bool shouldCreate;
+	Common::SharedPtr<Buffer> bitmap = _bitmapCache->find(key, shouldCreate);
+	if (!shouldCreate) {
+		return bitmap;
+	}
+
+	// Unscaled bitmaps do not go through the scaler, so that the scale tables
+	// in use are not replaced
+	static int identity[kCelScalerTableSize];
+	if (identity[kCelScalerTableSize - 1] == 0) {
+		for (int i = 0; i < kCelScalerTableSize; ++i) {
+			identity[i] = i;
+		}
+	}
+
+	const int *valuesX = identity;
+	const int *valuesY = identity;
+	if (!scaleX.isOne() || !scaleY.isOne()) {
+		const CelScalerTable &table = _scaler->getScalerTable(scaleX, scaleY);
+		valuesX = table.valuesX;
+		valuesY = table.valuesY;
+	}
+
+	// The bitmap ends where the scaler would read past the edges of the cel
+	int16 width = 0;
+	while (width < kCelScalerTableSize && valuesX[width] < _width) {
+		++width;
+	}
+	int16 height = 0;
+	while (height < kCelScalerTableSize && valuesY[height] < _height) {
+		++height;
+	}
+
+	if (width == 0 || height == 0) {
+		return bitmap;
+	}
+
+	bitmap = Common::SharedPtr<Buffer>(new Buffer(), Graphics::SurfaceDeleter());
+	bitmap->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+	scaleCelBitmap(*this, *bitmap, valuesX, valuesY, mirrorX);
+
+	_bitmapCache->put(key, bitmap);
+	return bitmap;
+}
+
 #pragma mark -
 #pragma mark CelObj - Drawing
 
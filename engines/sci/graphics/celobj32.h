@@ -22,10 +22,14 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
 #include "sci/engine/vm_types.h"
+#include "sci/graphics/helpers.h"
 #include "sci/util.h"
 
 namespace Sci {
@@ -231,6 +235,142 @@ public:
 	const CelScalerTable &getScalerTable(const Ratio &scaleX, const Ratio &scaleY);
 };
 
+#pragma mark -
+#pragma mark CelBitmapCache
+
+/**
+ * Identifies a cel bitmap in the CelBitmapCache: the pixels of a view or pic
+ * cel, scaled by the given ratios and optionally mirrored.
+ *
+ * The bitmaps hold the palette indexes of the cel before they go through the
+ * remap and skip color tests of the renderer, so remapped cels share the
+ * bitmaps of the others.
+ */
+struct CelBitmapKey {
+	CelType type;
+	GuiResourceId resourceId;
+	int16 loopNo;
+	int16 celNo;
+	int scaleXNum, scaleXDenom;
+	int scaleYNum, scaleYDenom;
+	bool mirrorX;
+
+	inline bool operator==(const CelBitmapKey &other) const {
+		return (
+			type == other.type &&
+			resourceId == other.resourceId &&
+			loopNo == other.loopNo &&
+			celNo == other.celNo &&
+			scaleXNum == other.scaleXNum &&
+			scaleXDenom == other.scaleXDenom &&
+			scaleYNum == other.scaleYNum &&
+			scaleYDenom == other.scaleYDenom &&
+			mirrorX == other.mirrorX
+		);
+	}
+};
+
+struct CelBitmapKeyHash {
+	uint operator()(const CelBitmapKey &key) const {
+		uint hash = key.type;
+		hash = hash * 31 + key.resourceId;
+		hash = hash * 31 + (uint16)key.loopNo;
+		hash = hash * 31 + (uint16)key.celNo;
+		hash = hash * 31 + key.scaleXNum;
+		hash = hash * 31 + key.scaleXDenom;
+		hash = hash * 31 + key.scaleYNum;
+		hash = hash * 31 + key.scaleYDenom;
+		return hash * 2 + key.mirrorX;
+	}
+};
+
+/**
+ * A cache of decompressed and pre-scaled cel bitmaps, bounded by the memory
+ * used by the bitmaps. When the cache is full, the least recently used
+ * bitmaps are dropped.
+ *
+ * A bitmap is only created the second time it is requested: the scale of an
+ * actor walking towards the camera changes with every step, and making a
+ * bitmap of the whole cel for a single draw would cost more than drawing
+ * through the scaler.
+ */
+class CelBitmapCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 created;
+		uint32 evicted;
+	};
+
+	CelBitmapCache(const uint32 maxMemory);
+
+	/**
+	 * Looks up the bitmap for the given key. If it is not cached,
+	 * `shouldCreate` is set when the bitmap has been requested before, in which
+	 * case the caller should create it and put it in the cache.
+	 */
+	Common::SharedPtr<Buffer> find(const CelBitmapKey &key, bool &shouldCreate);
+
+	/**
+	 * Puts the bitmap for the given key in the cache, dropping the least
+	 * recently used bitmaps as needed.
+	 */
+	void put(const CelBitmapKey &key, const Common::SharedPtr<Buffer> &bitmap);
+
+	uint32 getMemory() const { return _memory; }
+	uint32 getMaxMemory() const { return _maxMemory; }
+	uint getBitmapCount() const { return _bitmapCount; }
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
+private:
+	typedef Common::List<CelBitmapKey> LRUList;
+
+	struct Entry {
+		/**
+		 * The bitmap, or null if it was requested only once.
+		 */
+		Common::SharedPtr<Buffer> bitmap;
+
+		/**
+		 * The memory accounted for this entry.
+		 */
+		uint32 size;
+
+		LRUList::iterator lru;
+	};
+
+	typedef Common::HashMap<CelBitmapKey, Entry, CelBitmapKeyHash> EntryMap;
+
+	/**
+	 * The memory accounted for an entry without a bitmap, so that the
+	 * requests of bitmaps which are never created also count towards the
+	 * bound of the cache.
+	 */
+	static const uint32 kRequestSize = 64;
+
+	EntryMap _entries;
+
+	/**
+	 * The keys of the entries, least recently used first.
+	 */
+	LRUList _lru;
+
+	uint32 _maxMemory;
+	uint32 _memory;
+	uint _bitmapCount;
+	Stats _stats;
+
+	void removeEntry(EntryMap::iterator it);
+
+	/**
+	 * Drops the least recently used entries until `size` more bytes fit in
+	 * the cache.
+	 */
+	void makeRoom(const uint32 size);
+};
+
 #pragma mark -
 #pragma mark CelObj
 
@@ -411,6 +551,21 @@ public:
 	 */
 	void submitPalette() const;
 
+	/**
+	 * Gets the pixels of this cel scaled by the given ratios, mirrored if
+	 * `mirrorX` is true, from the cel bitmap cache. The pixel at (x, y) of the
+	 * bitmap is the one the scaler draws at (x, y) from the scaled position of
+	 * the cel when the global scaling pattern is not used. Returns null when
+	 * the bitmap is not cached yet, or this cel does not come from a view or
+	 * pic resource.
+	 */
+	Common::SharedPtr<Buffer> getCachedBitmap(const Ratio &scaleX, const Ratio &scaleY, const bool mirrorX) const;
+
+	/**
+	 * The cache of decompressed and pre-scaled cel bitmaps.
+	 */
+	static CelBitmapCache *_bitmapCache;
+
 #pragma mark -
 #pragma mark CelObj - Drawing
 private:
@@ -70,6 +70,7 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	_overdrawThreshold(0),
 	_throttleKernelFrameOut(true),
 	_palMorphIsOn(false),
+	_useScreenItemTileIndex(true),
 	_lastScreenUpdateTick(0) {
 
 	if (g_sci->getGameId() == GID_PHANTASMAGORIA) {
@@ -80,6 +81,7 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 		_currentBuffer.create(320, 200, Graphics::PixelFormat::createFormatCLUT8());
 	}
 	initGraphics(_currentBuffer.w, _currentBuffer.h);
+	resetListBuildStats();
 
 	switch (g_sci->getGameId()) {
 	case GID_HOYLE5:
@@ -759,6 +761,8 @@ void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseL
 	int deletedPlaneCount = 0;
 	bool addedToEraseList = false;
 	bool foundTransparentPlane = false;
+	const uint32 startTime = g_system->getMillis();
+	uint32 intersectionTests = 0;
 
 	if (!eraseRect.isEmpty()) {
 		addedToEraseList = true;
@@ -940,7 +944,7 @@ void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseL
 					error("Missing visible plane for source plane %04x:%04x", PRINT_REG(plane._object));
 				}
 
-				plane.calcLists(*visiblePlane, _planes, drawLists[planeIndex], eraseLists[planeIndex]);
+				intersectionTests += plane.calcLists(*visiblePlane, _planes, drawLists[planeIndex], eraseLists[planeIndex]);
 			}
 		} else {
 			plane.decrementScreenItemArrayCounts(visiblePlane, false);
@@ -992,6 +996,11 @@ void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseL
 			}
 		}
 	}
+
+	++_listBuildStats.frames;
+	_listBuildStats.totalTime += g_system->getMillis() - startTime;
+	_listBuildStats.lastTests = intersectionTests;
+	_listBuildStats.totalTests += intersectionTests;
 }
 
 void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
@@ -1440,6 +1449,10 @@ void GfxFrameout::remapMarkRedraw() {
 #pragma mark -
 #pragma mark Debugging
 
+void GfxFrameout::resetListBuildStats() {
+	memset(&_listBuildStats, 0, sizeof(_listBuildStats));
+}
+
 Plane *GfxFrameout::getTopVisiblePlane() {
 	for (PlaneList::const_iterator it = _visiblePlanes.begin(); it != _visiblePlanes.end(); ++it) {
 		Plane *p = *it;
@@ -226,6 +226,13 @@ public:
 	 */
 	bool _palMorphIsOn;
 
+	/**
+	 * Whether planes with many screen items find the screen items
+	 * intersecting their draw and erase rects through a ScreenItemTileIndex,
+	 * instead of testing every screen item.
+	 */
+	bool _useScreenItemTileIndex;
+
 	inline const Buffer &getCurrentBuffer() const {
 		return _currentBuffer;
 	}
@@ -436,12 +443,36 @@ private:
 #pragma mark -
 #pragma mark Debugging
 public:
+	/**
+	 * Statistics of the calculation of the draw and erase lists, including
+	 * building the tile indexes of the screen items.
+	 */
+	struct ListBuildStats {
+		uint32 frames;
+		/**
+		 * Time spent over all frames, in ms. A frame usually takes well
+		 * under a millisecond, so only the total is meaningful.
+		 */
+		uint32 totalTime;
+		/**
+		 * Screen item rects tested against draw and erase rects.
+		 */
+		uint32 lastTests;
+		uint32 totalTests;
+	};
+
+	const ListBuildStats &getListBuildStats() const { return _listBuildStats; }
+	void resetListBuildStats();
+
 	void printPlaneList(Console *con) const;
 	void printVisiblePlaneList(Console *con) const;
 	void printPlaneListInternal(Console *con, const PlaneList &planeList) const;
 	void printPlaneItemList(Console *con, const reg_t planeObject) const;
 	void printVisiblePlaneItemList(Console *con, const reg_t planeObject) const;
 	void printPlaneItemListInternal(Console *con, const ScreenItemList &screenItemList) const;
+
+private:
+	ListBuildStats _listBuildStats;
 };
 
 } // End of namespace Sci
@@ -41,6 +41,77 @@ void DrawList::add(ScreenItem *screenItem, const Common::Rect &rect) {
 	DrawListBase::add(drawItem);
 }
 
+#pragma mark -
+#pragma mark ScreenItemTileIndex
+void ScreenItemTileIndex::reset(const Common::Rect &screenRect) {
+	memset(_tiles, 0, sizeof(_tiles));
+	memset(_unplaced, 0, sizeof(_unplaced));
+	memset(_all, 0, sizeof(_all));
+	_origin = Common::Point(screenRect.left, screenRect.top);
+	_tileWidth = MAX<int>(1, (screenRect.width() + kGridSize - 1) / kGridSize);
+	_tileHeight = MAX<int>(1, (screenRect.height() + kGridSize - 1) / kGridSize);
+}
+
+bool ScreenItemTileIndex::getTiles(const Common::Rect &rect, int &left, int &top, int &right, int &bottom) const {
+	if (rect.right < rect.left || rect.bottom < rect.top) {
+		return false;
+	}
+
+	// Rects outside of the plane are clamped to its border tiles, which
+	// keeps the tiles of intersecting rects overlapping
+	left = CLIP<int>((rect.left - _origin.x) / _tileWidth, 0, kGridSize - 1);
+	top = CLIP<int>((rect.top - _origin.y) / _tileHeight, 0, kGridSize - 1);
+	right = CLIP<int>((MAX(rect.left, (int16)(rect.right - 1)) - _origin.x) / _tileWidth, 0, kGridSize - 1);
+	bottom = CLIP<int>((MAX(rect.top, (int16)(rect.bottom - 1)) - _origin.y) / _tileHeight, 0, kGridSize - 1);
+	return true;
+}
+
+void ScreenItemTileIndex::add(const uint index, const Common::Rect &rect) {
+	assert(index < kMaxItems);
+	const uint32 bit = 1U << (index % 32);
+	const uint word = index / 32;
+	_all[word] |= bit;
+
+	int left, top, right, bottom;
+	if (!getTiles(rect, left, top, right, bottom)) {
+		_unplaced[word] |= bit;
+		return;
+	}
+
+	for (int y = top; y <= bottom; ++y) {
+		for (int x = left; x <= right; ++x) {
+			_tiles[y][x][word] |= bit;
+		}
+	}
+}
+
+uint ScreenItemTileIndex::find(const Common::Rect &rect, uint16 *indexes) const {
+	ItemMask found;
+	int left, top, right, bottom;
+	if (getTiles(rect, left, top, right, bottom)) {
+		memcpy(found, _unplaced, sizeof(found));
+		for (int y = top; y <= bottom; ++y) {
+			for (int x = left; x <= right; ++x) {
+				for (uint word = 0; word < ARRAYSIZE(found); ++word) {
+					found[word] |= _tiles[y][x][word];
+				}
+			}
+		}
+	} else {
+		memcpy(found, _all, sizeof(found));
+	}
+
+	uint count = 0;
+	for (uint word = 0; word < ARRAYSIZE(found); ++word) {
+		for (uint bit = 0, bits = found[word]; bits != 0; ++bit, bits >>= 1) {
+			if (bits & 1) {
+				indexes[count++] = word * 32 + bit;
+			}
+		}
+	}
+	return count;
+}
+
 #pragma mark -
 #pragma mark Plane
 uint16 Plane::_nextObjectId; // Will be initialized in Plane::init()
@@ -262,6 +333,12 @@ void Plane::deleteAllPics() {
 #pragma mark -
 #pragma mark Plane - Rendering
 
+/**
+ * The number of screen items from which `calcLists` finds the screen items
+ * intersecting the draw and erase rects through a ScreenItemTileIndex.
+ */
+static const ScreenItemList::size_type kTileIndexMinItems = 32;
+
 void Plane::breakDrawListByPlanes(DrawList &drawList, const PlaneList &planeList) const {
 	const int nextPlaneIndex = planeList.findIndexByObject(_object) + 1;
 	const PlaneList::size_type planeCount = planeList.size();
@@ -314,7 +391,7 @@ void Plane::breakEraseListByPlanes(RectList &eraseList, const PlaneList &planeLi
 	eraseList.pack();
 }
 
-void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList &drawList, RectList &eraseList) {
+uint Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList &drawList, RectList &eraseList) {
 	const ScreenItemList::size_type screenItemCount = _screenItemList.size();
 	const ScreenItemList::size_type visiblePlaneItemCount = visiblePlane._screenItemList.size();
 
@@ -431,6 +508,33 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	DrawList::size_type drawListSizePrimary = drawList.size();
 	const RectList::size_type eraseListCount = eraseList.size();
 
+	// Past a few screen items, the items which can intersect the rects of the
+	// erase and draw lists are found through a tile index. Only the items
+	// which did not change in this frame are looked for, their rects are the
+	// ones from the last frame, so the index is built from scratch in one
+	// pass over the list. The candidates come in the order of the list, which
+	// keeps the draw list the same as with the full scans below.
+	uint intersectionTests = 0;
+	ScreenItemTileIndex tileIndex;
+	uint16 candidates[ScreenItemTileIndex::kMaxItems];
+	const bool useTileIndex =
+		getSciVersion() != SCI_VERSION_3 &&
+		g_sci->_gfxFrameout->_useScreenItemTileIndex &&
+		screenItemCount >= kTileIndexMinItems;
+	if (useTileIndex) {
+		tileIndex.reset(_screenRect);
+		const ScreenItemList::size_type indexedCount = MIN(screenItemCount, _screenItemList.size());
+		for (ScreenItemList::size_type j = 0; j < indexedCount; ++j) {
+			const ScreenItem *item = _screenItemList[j];
+			if (
+				item != nullptr &&
+				!item->_created && !item->_updated && !item->_deleted
+			) {
+				tileIndex.add(j, item->_screenRect);
+			}
+		}
+	}
+
 	if (getSciVersion() == SCI_VERSION_3) {
 		_screenItemList.sort();
 		bool pictureDrawn = false;
@@ -474,6 +578,19 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		}
 
 		_screenItemList.unsort();
+	} else if (useTileIndex) {
+		// Add all items overlapping the erase list to the draw list
+		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
+			const Common::Rect &rect = *eraseList[i];
+			const uint candidateCount = tileIndex.find(rect, candidates);
+			for (uint k = 0; k < candidateCount; ++k) {
+				ScreenItem *item = _screenItemList[candidates[k]];
+				++intersectionTests;
+				if (rect.intersects(item->_screenRect)) {
+					drawList.add(item, rect.findIntersectingRect(item->_screenRect));
+				}
+			}
+		}
 	} else {
 		// Add all items overlapping the erase list to the draw list
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
@@ -482,10 +599,12 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				ScreenItem *item = _screenItemList[j];
 				if (
 					item != nullptr &&
-					!item->_created && !item->_updated && !item->_deleted &&
-					rect.intersects(item->_screenRect)
+					!item->_created && !item->_updated && !item->_deleted
 				) {
-					drawList.add(item, rect.findIntersectingRect(item->_screenRect));
+					++intersectionTests;
+					if (rect.intersects(item->_screenRect)) {
+						drawList.add(item, rect.findIntersectingRect(item->_screenRect));
+					}
 				}
 			}
 		}
@@ -504,6 +623,26 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				drawListEntry = drawList[i];
 			}
 
+			if (useTileIndex) {
+				if (drawListEntry == nullptr) {
+					continue;
+				}
+
+				const ScreenItem *drawnItem = drawListEntry->screenItem;
+				const uint candidateCount = tileIndex.find(drawListEntry->rect, candidates);
+				for (uint k = 0; k < candidateCount; ++k) {
+					const ScreenItemList::size_type j = candidates[k];
+					const ScreenItem *newItem = _screenItemList[j];
+					++intersectionTests;
+					if (newItem->hasPriorityAbove(*drawnItem) &&
+						drawListEntry->rect.intersects(newItem->_screenRect)
+					) {
+						mergeToDrawList(j, drawListEntry->rect.findIntersectingRect(newItem->_screenRect), drawList);
+					}
+				}
+				continue;
+			}
+
 			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
 				ScreenItem *newItem = nullptr;
 				if (j < _screenItemList.size()) {
@@ -516,6 +655,7 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				) {
 					const ScreenItem *drawnItem = drawListEntry->screenItem;
 
+					++intersectionTests;
 					if (newItem->hasPriorityAbove(*drawnItem) &&
 						drawListEntry->rect.intersects(newItem->_screenRect)
 					) {
@@ -527,6 +667,7 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	}
 
 	decrementScreenItemArrayCounts(&visiblePlane, false);
+	return intersectionTests;
 }
 
 void Plane::decrementScreenItemArrayCounts(Plane *visiblePlane, const bool forceUpdate) {
@@ -92,6 +92,79 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark ScreenItemTileIndex
+
+/**
+ * A grid of tiles over the screen rect of a plane, recording which screen
+ * items of the plane cover each tile. It is used when calculating the draw
+ * lists to find the screen items which may intersect a rect, instead of
+ * testing the rect against every screen item of the plane.
+ */
+class ScreenItemTileIndex {
+public:
+	enum {
+		/**
+		 * The capacity of ScreenItemList.
+		 */
+		kMaxItems = 250,
+
+		/**
+		 * The number of tiles across and down the plane.
+		 */
+		kGridSize = 8
+	};
+
+	/**
+	 * Removes all screen items from the index and lays the tiles out over
+	 * the given screen rect.
+	 */
+	void reset(const Common::Rect &screenRect);
+
+	/**
+	 * Adds the screen item at `index` in the screen item list, which covers
+	 * `rect`, to the index.
+	 */
+	void add(const uint index, const Common::Rect &rect);
+
+	/**
+	 * Fills `indexes` with the indexes of the screen items which share a
+	 * tile with `rect`, in ascending order, and returns how many there are.
+	 * Every screen item whose rect intersects `rect` is returned, but some of
+	 * the returned ones may not intersect it.
+	 */
+	uint find(const Common::Rect &rect, uint16 *indexes) const;
+
+private:
+	typedef uint32 ItemMask[(kMaxItems + 31) / 32];
+
+	/**
+	 * The screen items covering each tile.
+	 */
+	ItemMask _tiles[kGridSize][kGridSize];
+
+	/**
+	 * Screen items with an inverted rect, which are returned by all queries.
+	 */
+	ItemMask _unplaced;
+
+	/**
+	 * All screen items of the index, returned for queries of an inverted
+	 * rect.
+	 */
+	ItemMask _all;
+
+	Common::Point _origin;
+	int _tileWidth, _tileHeight;
+
+	/**
+	 * Gets the range of tiles covered by `rect`. An empty rect covers the
+	 * tile of its top left corner, since it still intersects the rects
+	 * around it. Returns false for inverted rects.
+	 */
+	bool getTiles(const Common::Rect &rect, int &left, int &top, int &right, int &bottom) const;
+};
+
 class PlaneList;
 
 #pragma mark -
@@ -394,9 +467,10 @@ public:
 	 * Calculates the location and dimensions of dirty rects of the screen items
 	 * in this plane and adds them to the given draw and erase lists, and
 	 * synchronises this plane's list of screen items to the given visible
-	 * plane.
+	 * plane. Returns the number of screen item rects which were tested
+	 * against the rects of the draw and erase lists.
 	 */
-	void calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList &drawList, RectList &eraseList);
+	uint calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList &drawList, RectList &eraseList);
 
 	/**
 	 * Synchronises changes to screen items from the current plane to the
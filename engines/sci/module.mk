@@ -34,6 +34,7 @@ MODULE_OBJS := \
 	engine/scriptdebug.o \
 	engine/script_patches.o \
 	engine/selector.o \
+	engine/selector_lookup.o \
 	engine/seg_manager.o \
 	engine/segment.o \
 	engine/state.o \
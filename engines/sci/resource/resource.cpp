@@ -21,10 +21,12 @@
 
 // Resource library
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -207,6 +209,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_prefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -225,6 +228,7 @@ void Resource::unalloc() {
 	delete[] _header;
 	_header = nullptr;
 	_status = kResStatusNoMalloc;
+	_prefetched = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -1005,10 +1009,13 @@ ResourceManager::ResourceManager(const bool detectionMode) :
 	_detectionMode(detectionMode) {}
 
 void ResourceManager::init() {
-	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
-	_memoryLRU = 0;
-	_LRU.clear();
+	resetPools();
+	resetCacheStats();
+	_prefetchQueue.clear();
+	_roomResources.clear();
+	_nextRoom.clear();
+	_prefetchRoom = -1;
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1074,13 +1081,8 @@ void ResourceManager::init() {
 
 	debugC(1, kDebugLevelResMan, "resMan: Detected %s", getSciVersionDesc(getSciVersion()));
 
-	// Resources in SCI32 games are significantly larger than SCI16
-	// games and can cause immediate exhaustion of the LRU resource
-	// cache, leading to constant decompression of picture resources
-	// and making the renderer very slow.
-	if (getSciVersion() >= SCI_VERSION_2) {
-		_maxMemoryLRU = 4096 * 1024; // 4MiB
-	}
+	// The budgets of the LRU pools depend on the SCI version
+	initPools();
 
 	switch (_viewType) {
 	case kViewEga:
@@ -1123,13 +1125,76 @@ ResourceManager::~ResourceManager() {
 	}
 }
 
+ResourcePool ResourceManager::getResourcePool(ResourceType type) {
+	switch (type) {
+	case kResourceTypeSound:
+	case kResourceTypeAudio:
+	case kResourceTypeSync:
+	case kResourceTypeAudio36:
+	case kResourceTypeSync36:
+	case kResourceTypeWave:
+	case kResourceTypeRave:
+		return kResourcePoolAudio;
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypePalette:
+	case kResourceTypeCursor:
+		return kResourcePoolGraphics;
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+		return kResourcePoolScript;
+	default:
+		return kResourcePoolOther;
+	}
+}
+
+// Budgets of the LRU pools in KiB. Resources in SCI32 games are significantly
+// larger than SCI16 games and can cause immediate exhaustion of the LRU
+// resource cache, leading to constant decompression of picture resources and
+// making the renderer very slow.
+static const int s_sci16PoolBudgets[kResourcePoolCount] = { 64, 128, 32, 32 };
+static const int s_sci32PoolBudgets[kResourcePoolCount] = { 2048, 4096, 1024, 512 };
+
+void ResourceManager::resetPools() {
+	// The SCI version is not known yet, so the SCI16 budgets apply until
+	// initPools() is called
+	for (int i = 0; i < kResourcePoolCount; ++i) {
+		_pools[i].maxMemory = s_sci16PoolBudgets[i] * 1024;
+		_pools[i].memory = 0;
+		_pools[i].resources.clear();
+	}
+}
+
+void ResourceManager::initPools() {
+	static const char *const configKeys[kResourcePoolCount] = {
+		"resource_cache_audio",
+		"resource_cache_graphics",
+		"resource_cache_scripts",
+		"resource_cache_other"
+	};
+
+	const bool sci32 = getSciVersion() >= SCI_VERSION_2;
+
+	for (int i = 0; i < kResourcePoolCount; ++i) {
+		int budget = sci32 ? s_sci32PoolBudgets[i] : s_sci16PoolBudgets[i];
+		// The budgets can be set per game in the configuration file
+		if (!_detectionMode && ConfMan.hasKey(configKeys[i]))
+			budget = MAX(ConfMan.getInt(configKeys[i]), 0);
+
+		_pools[i].maxMemory = budget * 1024;
+	}
+
+	freeOldResources();
+}
+
 void ResourceManager::removeFromLRU(Resource *res) {
 	if (res->_status != kResStatusEnqueued) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
-	_memoryLRU -= res->size();
+	LRUPool &pool = _pools[getResourcePool(res->getType())];
+	pool.resources.remove(res);
+	pool.memory -= res->size();
 	res->_status = kResStatusAllocated;
 }
 
@@ -1138,25 +1203,118 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
-	_memoryLRU += res->size();
+	LRUPool &pool = _pools[getResourcePool(res->getType())];
+	pool.resources.push_front(res);
+	pool.memory += res->size();
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
-	      _memoryLRU);
+	      pool.memory);
 #endif
 	res->_status = kResStatusEnqueued;
 }
 
 void ResourceManager::freeOldResources() {
-	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
-		removeFromLRU(goner);
-		goner->unalloc();
+	for (int i = 0; i < kResourcePoolCount; ++i) {
+		LRUPool &pool = _pools[i];
+		while (pool.maxMemory < pool.memory) {
+			assert(!pool.resources.empty());
+			Resource *goner = pool.resources.back();
+			removeFromLRU(goner);
+			goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
-		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
+			debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
+		}
+	}
+}
+
+void ResourceManager::resetCacheStats() {
+	_cacheStats.hits = 0;
+	_cacheStats.misses = 0;
+	_cacheStats.bytesLoaded = 0;
+	_cacheStats.stallTime = 0;
+	_cacheStats.prefetched = 0;
+	_cacheStats.prefetchHits = 0;
+}
+
+void ResourceManager::getPoolMemory(ResourcePool pool, int &maxMemory, int &memory) const {
+	maxMemory = _pools[pool].maxMemory;
+	memory = _pools[pool].memory;
+}
+
+void ResourceManager::prefetchResource(const ResourceId &id) {
+	// Keep the queue short, as the oldest requests are the least likely
+	// to still be useful
+	const uint maxQueueSize = 256;
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	if (Common::find(_prefetchQueue.begin(), _prefetchQueue.end(), id) != _prefetchQueue.end())
+		return;
+
+	_prefetchQueue.push_back(id);
+	if (_prefetchQueue.size() > maxQueueSize)
+		_prefetchQueue.pop_front();
+}
+
+void ResourceManager::recordRoomResource(uint16 room, const ResourceId &id) {
+	// Limits the memory used to remember the resources of a room
+	const uint maxRoomResources = 128;
+
+	if (!testResource(id))
+		return;
+
+	if (room != _prefetchRoom) {
+		if (_prefetchRoom >= 0)
+			_nextRoom[_prefetchRoom] = room;
+		_prefetchRoom = room;
+
+		queueRoomResources(room);
+		if (_nextRoom.contains(room))
+			queueRoomResources(_nextRoom[room]);
+	}
+
+	Common::Array<ResourceId> &resources = _roomResources[room];
+	if (resources.size() < maxRoomResources && Common::find(resources.begin(), resources.end(), id) == resources.end())
+		resources.push_back(id);
+}
+
+void ResourceManager::queueRoomResources(uint16 room) {
+	RoomResourcesMap::const_iterator it = _roomResources.find(room);
+	if (it == _roomResources.end())
+		return;
+
+	for (uint i = 0; i < it->_value.size(); ++i)
+		prefetchResource(it->_value[i]);
+}
+
+void ResourceManager::runPrefetch(uint32 untilTime) {
+	while (!_prefetchQueue.empty() && g_system->getMillis() < untilTime) {
+		const ResourceId id = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		Resource *res = testResource(id);
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		// Only fill the free room of the pool, a prefetched resource must
+		// not evict the resources in use
+		const LRUPool &pool = _pools[getResourcePool(res->getType())];
+		if (pool.memory + (int)res->size() >= pool.maxMemory)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		_cacheStats.bytesLoaded += res->size();
+		_cacheStats.prefetched++;
+		res->_prefetched = true;
+		addToLRU(res);
+		freeOldResources();
 	}
 }
 
@@ -1196,9 +1354,21 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		const uint32 startTime = g_system->getMillis();
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+		_cacheStats.stallTime += g_system->getMillis() - startTime;
+		_cacheStats.bytesLoaded += retval->size();
+		_cacheStats.misses++;
+	} else {
+		_cacheStats.hits++;
+		if (retval->_prefetched) {
+			_cacheStats.prefetchHits++;
+			retval->_prefetched = false;
+		}
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
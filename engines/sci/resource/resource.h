@@ -22,6 +22,7 @@
 #ifndef SCI_RESOURCE_RESOURCE_H
 #define SCI_RESOURCE_RESOURCE_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
@@ -62,6 +63,19 @@ enum ResourceStatus {
 	kResStatusLocked /**< Allocated and in use */
 };
 
+/**
+ * The LRU pools of the resources which are not locked. Each pool has its own
+ * budget, so that large resources such as audio don't push the views, pics
+ * and scripts of the current room out of the cache.
+ */
+enum ResourcePool {
+	kResourcePoolAudio = 0,
+	kResourcePoolGraphics, ///< Views, pics, palettes and cursors
+	kResourcePoolScript,
+	kResourcePoolOther,
+	kResourcePoolCount
+};
+
 /** Resource error codes. Should be in sync with s_errorDescriptions */
 enum ResourceErrorCodes {
 	SCI_ERROR_NONE = 0,
@@ -309,6 +323,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _prefetched; /**< Loaded by the prefetcher and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -380,6 +395,41 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	struct CacheStats {
+		uint32 hits;              ///< Requests of resources which were in memory
+		uint32 misses;            ///< Requests which had to load the resource
+		uint32 bytesLoaded;       ///< Bytes read and decompressed into resources
+		uint32 stallTime;         ///< Milliseconds spent loading requested resources
+		uint32 prefetched;        ///< Resources loaded by the prefetcher
+		uint32 prefetchHits;      ///< Prefetched resources which were requested later
+	};
+
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats();
+
+	/** Returns the budget and the current use of an LRU pool, in bytes. */
+	void getPoolMemory(ResourcePool pool, int &maxMemory, int &memory) const;
+
+	/**
+	 * Queues a resource to be loaded ahead of its use, when the engine is
+	 * idle. Nothing happens if the resource doesn't exist.
+	 */
+	void prefetchResource(const ResourceId &id);
+
+	/**
+	 * Records that the scripts use a resource while in the given room. When
+	 * the room changes, the resources used in the new room on the previous
+	 * visit and those of the room which followed it are queued for prefetch.
+	 */
+	void recordRoomResource(uint16 room, const ResourceId &id);
+
+	/**
+	 * Loads queued resources, as long as their pools have room for them,
+	 * until the given time has been reached.
+	 * @param untilTime	Value of OSystem::getMillis() at which to stop
+	 */
+	void runPrefetch(uint32 untilTime);
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -490,18 +540,27 @@ public:
 protected:
 	bool _detectionMode;
 
-	// Maximum number of bytes to allow being allocated for resources
-	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
-	// for resources which are not explicitly locked. However, a warning will be
-	// issued whenever this limit is exceeded.
-	int _maxMemoryLRU;
+	struct LRUPool {
+		// Maximum number of bytes to allow being allocated for resources
+		// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
+		// for resources which are not explicitly locked.
+		int maxMemory;
+		int memory; ///< Amount of resource bytes under LRU control
+		Common::List<Resource *> resources; ///< Last Resource Used list
+	};
 
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	typedef Common::List<ResourceSource *> SourcesList;
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
-	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	LRUPool _pools[kResourcePoolCount];
+	CacheStats _cacheStats;
+
+	Common::List<ResourceId> _prefetchQueue;
+	typedef Common::HashMap<uint16, Common::Array<ResourceId> > RoomResourcesMap;
+	RoomResourcesMap _roomResources; ///< Resources used by the scripts in each room
+	Common::HashMap<uint16, uint16> _nextRoom; ///< Room entered after each room
+	int _prefetchRoom; ///< Room of the last recorded resource, or -1
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -646,6 +705,12 @@ protected:
 
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
+	static ResourcePool getResourcePool(ResourceType type);
+	/** Empties the LRU pools, before the SCI version is known. */
+	void resetPools();
+	/** Sets the budgets of the LRU pools for the detected SCI version. */
+	void initPools();
+	void queueRoomResources(uint16 room);
 
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
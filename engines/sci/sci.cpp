@@ -967,6 +967,9 @@ void SciEngine::sleep(uint32 msecs) {
 			_gfxFrameout->updateScreen();
 		}
 #endif
+		// Use the idle time to load resources ahead of their use
+		_resMan->runPrefetch(wakeUpTime);
+
 		uint32 time = _system->getMillis();
 		if (time + 10 < wakeUpTime) {
 			_system->delayMillis(10);
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 
 #include "graphics/blit/blit-alpha.h"
+#include "graphics/blit/blit-fast.h"
 #include "graphics/pixelformat.h"
 
 #include <immintrin.h>
@@ -321,6 +322,72 @@ void BlendBlit::blitAVX2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_AVX2>(args, blendMode, alphaType);
 }
 
+/** Extract a component from 32-bit pixels and expand it to 8 bits like ColorComponent does. */
+template<int Bits, int Shift>
+static FORCEINLINE __m256i avx2_expandComponent(__m256i c) {
+	if (Bits == 1)
+		return _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_srli_epi32(c, Shift), _mm256_setzero_si256()), _mm256_set1_epi32(0xFF));
+
+	const __m256i v = _mm256_and_si256(_mm256_srli_epi32(c, Shift), _mm256_set1_epi32((1 << Bits) - 1));
+	if (Bits == 8)
+		return v;
+	return _mm256_or_si256(_mm256_slli_epi32(v, 8 - Bits), _mm256_srli_epi32(v, Bits >= 4 ? 2 * Bits - 8 : 0));
+}
+
+/** Reduce an 8-bit component and move it to its place in 32-bit pixels. */
+template<int Bits, int Shift>
+static FORCEINLINE __m256i avx2_packComponent(__m256i v) {
+	if (Bits == 0)
+		return _mm256_setzero_si256();
+	return _mm256_slli_epi32(_mm256_srli_epi32(v, 8 - Bits), Shift);
+}
+
+template<typename SrcFormat, typename DstFormat>
+static FORCEINLINE __m256i avx2_convertPixels(__m256i c) {
+	const __m256i a = (SrcFormat::kABits == 0) ? _mm256_set1_epi32(0xFF) : avx2_expandComponent<SrcFormat::kABits, SrcFormat::kAShift>(c);
+	const __m256i r = avx2_expandComponent<SrcFormat::kRBits, SrcFormat::kRShift>(c);
+	const __m256i g = avx2_expandComponent<SrcFormat::kGBits, SrcFormat::kGShift>(c);
+	const __m256i b = avx2_expandComponent<SrcFormat::kBBits, SrcFormat::kBShift>(c);
+
+	return _mm256_or_si256(_mm256_or_si256(avx2_packComponent<DstFormat::kABits, DstFormat::kAShift>(a),
+	                                       avx2_packComponent<DstFormat::kRBits, DstFormat::kRShift>(r)),
+	                       _mm256_or_si256(avx2_packComponent<DstFormat::kGBits, DstFormat::kGShift>(g),
+	                                       avx2_packComponent<DstFormat::kBBits, DstFormat::kBShift>(b)));
+}
+
+/** Convert sixteen pixels at a time, working on 32-bit lanes whatever the pixel sizes are. */
+template<typename SrcFormat, typename DstFormat>
+struct FastBlitConvertAVX2 {
+	enum { kBlock = 16 };
+
+	static inline void convertBlock(byte *dst, const byte *src) {
+		__m256i lo, hi;
+		if (SrcFormat::kBytesPerPixel == 2) {
+			lo = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+			hi = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + 16)));
+		} else {
+			lo = _mm256_loadu_si256((const __m256i *)src);
+			hi = _mm256_loadu_si256((const __m256i *)(src + 32));
+		}
+
+		lo = avx2_convertPixels<SrcFormat, DstFormat>(lo);
+		hi = avx2_convertPixels<SrcFormat, DstFormat>(hi);
+
+		if (DstFormat::kBytesPerPixel == 2) {
+			// The pack works within 128-bit lanes, which leaves the quarters out of order
+			const __m256i pixels = _mm256_packus_epi32(lo, hi);
+			_mm256_storeu_si256((__m256i *)dst, _mm256_permute4x64_epi64(pixels, _MM_SHUFFLE(3, 1, 2, 0)));
+		} else {
+			_mm256_storeu_si256((__m256i *)dst, lo);
+			_mm256_storeu_si256((__m256i *)(dst + 32), hi);
+		}
+	}
+};
+
+FastBlitFunc FastBlitConvert::lookupAVX2(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	return fastBlitConvertLookup<FastBlitConvertAVX2>(dstFmt, srcFmt);
+}
+
 } // End of namespace Graphics
 
 #if defined(__clang__)
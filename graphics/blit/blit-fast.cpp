@@ -19,8 +19,7 @@
  *
  */
 
-#include "graphics/blit.h"
-#include "graphics/pixelformat.h"
+#include "graphics/blit/blit-fast.h"
 #include "common/endian.h"
 #include "common/system.h"
 
@@ -103,14 +102,60 @@ static void fastBlit_XRGB1555_RGBA5551(byte *dst, const byte *src,
 	}
 }
 
+/** Convert one pixel like PixelFormat::colorToARGB() and PixelFormat::ARGBToColor() do. */
+template<typename SrcFormat, typename DstFormat>
+struct FastBlitConvertGeneric {
+	enum { kBlock = 1 };
+
+	static inline void convertBlock(byte *dst, const byte *src) {
+		const uint32 color = (SrcFormat::kBytesPerPixel == 2) ? *(const uint16 *)src : *(const uint32 *)src;
+
+		const uint32 a = (SrcFormat::kABits == 0) ? 0xFF : ColorComponent<SrcFormat::kABits>::expand(color >> SrcFormat::kAShift);
+		const uint32 r = ColorComponent<SrcFormat::kRBits>::expand(color >> SrcFormat::kRShift);
+		const uint32 g = ColorComponent<SrcFormat::kGBits>::expand(color >> SrcFormat::kGShift);
+		const uint32 b = ColorComponent<SrcFormat::kBBits>::expand(color >> SrcFormat::kBShift);
+
+		const uint32 result =
+			((a >> (8 - DstFormat::kABits)) << DstFormat::kAShift) |
+			((r >> (8 - DstFormat::kRBits)) << DstFormat::kRShift) |
+			((g >> (8 - DstFormat::kGBits)) << DstFormat::kGShift) |
+			((b >> (8 - DstFormat::kBBits)) << DstFormat::kBShift);
+
+		if (DstFormat::kBytesPerPixel == 2)
+			*(uint16 *)dst = result;
+		else
+			*(uint32 *)dst = result;
+	}
+};
+
 } // End of anonymous namespace
 
+FastBlitConvert::LookupFunc FastBlitConvert::lookupFunc = nullptr;
+bool FastBlitConvert::selected = false;
+
+void FastBlitConvert::selectLookupFunc() {
+	lookupFunc = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		lookupFunc = lookupNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		lookupFunc = lookupSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		lookupFunc = lookupAVX2;
+#endif
+	selected = true;
+}
+
+FastBlitFunc FastBlitConvert::lookupGeneric(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	return fastBlitConvertLookup<FastBlitConvertGeneric>(dstFmt, srcFmt);
+}
+
 // TODO: Add fast 24<->32bpp conversion
 // TODO: Add fast 16bpp RGB <-> 16bpp BGR conversion
-struct FastBlitLookup {
-	FastBlitFunc func;
-	Graphics::PixelFormat srcFmt, dstFmt;
-};
 
 static const FastBlitLookup fastBlitFuncs_4to4[] = {
 	// 32-bit byteswap
@@ -207,7 +252,15 @@ FastBlitFunc getFastBlitFunc(const PixelFormat &dstFmt, const PixelFormat &srcFm
 		}
 	}
 
-	return nullptr;
+	if (!FastBlitConvert::selected)
+		FastBlitConvert::selectLookupFunc();
+	if (FastBlitConvert::lookupFunc) {
+		FastBlitFunc func = FastBlitConvert::lookupFunc(dstFmt, srcFmt);
+		if (func)
+			return func;
+	}
+
+	return FastBlitConvert::lookupGeneric(dstFmt, srcFmt);
 }
 
 } // End of namespace Graphics
@@ -0,0 +1,207 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_BLIT_BLIT_FAST_H
+#define GRAPHICS_BLIT_BLIT_FAST_H
+
+#include "graphics/blit.h"
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * A pixel format known at compile time, with the same parameters as the
+ * PixelFormat constructor. Only formats of 2 or 4 bytes per pixel whose
+ * components have 0, 1 or at least 4 bits are used.
+ */
+template<int BytesPerPixel,
+         int RBits, int GBits, int BBits, int ABits,
+         int RShift, int GShift, int BShift, int AShift>
+struct FastBlitFormat {
+	enum {
+		kBytesPerPixel = BytesPerPixel,
+		kRBits = RBits, kGBits = GBits, kBBits = BBits, kABits = ABits,
+		kRShift = RShift, kGShift = GShift, kBShift = BShift, kAShift = AShift
+	};
+
+	static constexpr PixelFormat format() {
+		return PixelFormat(BytesPerPixel, RBits, GBits, BBits, ABits, RShift, GShift, BShift, AShift);
+	}
+};
+
+typedef FastBlitFormat<2, 5, 6, 5, 0, 11,  5,  0,  0> FastBlitRGB565;
+typedef FastBlitFormat<2, 5, 5, 5, 0, 10,  5,  0,  0> FastBlitXRGB1555;
+typedef FastBlitFormat<2, 5, 5, 5, 1, 10,  5,  0, 15> FastBlitARGB1555;
+typedef FastBlitFormat<2, 4, 4, 4, 4, 12,  8,  4,  0> FastBlitRGBA4444;
+typedef FastBlitFormat<4, 8, 8, 8, 0, 16,  8,  0,  0> FastBlitXRGB8888;
+typedef FastBlitFormat<4, 8, 8, 8, 8, 16,  8,  0, 24> FastBlitARGB8888;
+typedef FastBlitFormat<4, 8, 8, 8, 8,  0,  8, 16, 24> FastBlitABGR8888;
+typedef FastBlitFormat<4, 8, 8, 8, 8, 24, 16,  8,  0> FastBlitRGBA8888;
+typedef FastBlitFormat<4, 8, 8, 8, 8,  8, 16, 24,  0> FastBlitBGRA8888;
+
+struct FastBlitLookup {
+	FastBlitFunc func;
+	Graphics::PixelFormat srcFmt, dstFmt;
+};
+
+/**
+ * Conversions between common pixel formats, specialized at compile time
+ * for each pair of formats. They give exactly the pixels of the generic
+ * crossBlit() path, which decodes and encodes each pixel through the
+ * runtime PixelFormat.
+ *
+ * The SIMD conversions are selected at runtime and are looked up after
+ * the hand-written fast blit functions; the scalar ones come last.
+ */
+class FastBlitConvert {
+public:
+	typedef FastBlitFunc(*LookupFunc)(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+
+	/** Lookup of the SIMD conversions, or nullptr. */
+	static LookupFunc lookupFunc;
+	static bool selected;
+
+	static void selectLookupFunc();
+
+	static FastBlitFunc lookupGeneric(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+#ifdef SCUMMVM_NEON
+	static FastBlitFunc lookupNEON(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+#endif
+#ifdef SCUMMVM_SSE2
+	static FastBlitFunc lookupSSE2(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+#endif
+#ifdef SCUMMVM_AVX2
+	static FastBlitFunc lookupAVX2(const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+#endif
+};
+
+template<typename SrcFormat, typename DstFormat, typename Kernel>
+void fastBlitConvertRest(byte *dstRow, const byte *srcRow, const uint blocks, const uint rest) {
+	byte srcBlock[Kernel::kBlock * SrcFormat::kBytesPerPixel] = {};
+	byte dstBlock[Kernel::kBlock * DstFormat::kBytesPerPixel];
+
+	const uint x = blocks * Kernel::kBlock;
+	memcpy(srcBlock, srcRow + x * SrcFormat::kBytesPerPixel, rest * SrcFormat::kBytesPerPixel);
+	Kernel::convertBlock(dstBlock, srcBlock);
+	memcpy(dstRow + x * DstFormat::kBytesPerPixel, dstBlock, rest * DstFormat::kBytesPerPixel);
+}
+
+/**
+ * Convert a rectangle with a kernel converting blocks of Kernel::kBlock
+ * pixels. The pixels left over at the end of a row go through a copy of
+ * the row end padded to a whole block.
+ *
+ * Like crossBlit(), conversions to a larger pixel size go from bottom right
+ * to top left, so that a surface can be converted in place. Each block is
+ * read completely before it is written.
+ */
+template<typename SrcFormat, typename DstFormat, typename Kernel>
+void fastBlitConvertLogic(byte *dst, const byte *src,
+                          const uint dstPitch, const uint srcPitch,
+                          const uint w, const uint h) {
+	const uint srcBpp = SrcFormat::kBytesPerPixel;
+	const uint dstBpp = DstFormat::kBytesPerPixel;
+	const bool backward = dstBpp > srcBpp;
+	const uint blocks = w / Kernel::kBlock;
+	const uint rest = w % Kernel::kBlock;
+
+	for (uint i = 0; i < h; ++i) {
+		const uint y = backward ? h - 1 - i : i;
+		byte *dstRow = dst + y * dstPitch;
+		const byte *srcRow = src + y * srcPitch;
+
+		if (backward && rest)
+			fastBlitConvertRest<SrcFormat, DstFormat, Kernel>(dstRow, srcRow, blocks, rest);
+
+		for (uint b = 0; b < blocks; ++b) {
+			const uint x = (backward ? blocks - 1 - b : b) * Kernel::kBlock;
+			Kernel::convertBlock(dstRow + x * dstBpp, srcRow + x * srcBpp);
+		}
+
+		if (!backward && rest)
+			fastBlitConvertRest<SrcFormat, DstFormat, Kernel>(dstRow, srcRow, blocks, rest);
+	}
+}
+
+#define FAST_BLIT_CONVERSION(src, dst) \
+	{ fastBlitConvertLogic<FastBlit##src, FastBlit##dst, Kernel<FastBlit##src, FastBlit##dst> >, FastBlit##src::format(), FastBlit##dst::format() }
+
+/**
+ * Look up the conversion between two formats in the table of specialized
+ * pairs, instantiating the Kernel template for each of them.
+ */
+template<template<typename, typename> class Kernel>
+FastBlitFunc fastBlitConvertLookup(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	static const FastBlitLookup table[] = {
+		// 16-bit to 32-bit
+		FAST_BLIT_CONVERSION(RGB565,   XRGB8888),
+		FAST_BLIT_CONVERSION(RGB565,   ARGB8888),
+		FAST_BLIT_CONVERSION(RGB565,   ABGR8888),
+		FAST_BLIT_CONVERSION(RGB565,   RGBA8888),
+		FAST_BLIT_CONVERSION(XRGB1555, ARGB8888),
+		FAST_BLIT_CONVERSION(ARGB1555, ARGB8888),
+		FAST_BLIT_CONVERSION(RGBA4444, RGBA8888),
+
+		// 32-bit to 16-bit
+		FAST_BLIT_CONVERSION(XRGB8888, RGB565),
+		FAST_BLIT_CONVERSION(ARGB8888, RGB565),
+		FAST_BLIT_CONVERSION(ABGR8888, RGB565),
+		FAST_BLIT_CONVERSION(RGBA8888, RGB565),
+		FAST_BLIT_CONVERSION(ARGB8888, ARGB1555),
+		FAST_BLIT_CONVERSION(RGBA8888, RGBA4444),
+
+		// 16-bit to 16-bit
+		FAST_BLIT_CONVERSION(RGB565,   XRGB1555),
+		FAST_BLIT_CONVERSION(XRGB1555, RGB565),
+
+		// 32-bit to 32-bit
+		FAST_BLIT_CONVERSION(XRGB8888, ARGB8888),
+		FAST_BLIT_CONVERSION(ARGB8888, XRGB8888),
+		FAST_BLIT_CONVERSION(ARGB8888, ABGR8888),
+		FAST_BLIT_CONVERSION(ABGR8888, ARGB8888),
+		FAST_BLIT_CONVERSION(ARGB8888, RGBA8888),
+		FAST_BLIT_CONVERSION(RGBA8888, ARGB8888),
+		FAST_BLIT_CONVERSION(ABGR8888, RGBA8888),
+		FAST_BLIT_CONVERSION(RGBA8888, ABGR8888),
+		FAST_BLIT_CONVERSION(ARGB8888, BGRA8888),
+		FAST_BLIT_CONVERSION(BGRA8888, ARGB8888)
+	};
+
+	if (srcFmt.bytesPerPixel != 2 && srcFmt.bytesPerPixel != 4)
+		return nullptr;
+
+	for (size_t i = 0; i < ARRAYSIZE(table); i++) {
+		if (srcFmt != table[i].srcFmt)
+			continue;
+		if (dstFmt != table[i].dstFmt)
+			continue;
+
+		return table[i].func;
+	}
+
+	return nullptr;
+}
+
+#undef FAST_BLIT_CONVERSION
+
+} // End of namespace Graphics
+
+#endif
@@ -24,6 +24,7 @@
 #ifdef SCUMMVM_NEON
 
 #include "graphics/blit/blit-alpha.h"
+#include "graphics/blit/blit-fast.h"
 #include "graphics/pixelformat.h"
 
 #include <arm_neon.h>
@@ -376,6 +377,76 @@ void fastBlitNEON_XRGB1555_RGB565(byte *dst, const byte *src,
 	}
 }
 
+/** Shift right by a count which may be zero, which the immediate forms do not accept. */
+static inline uint32x4_t neon_shiftRight(uint32x4_t v, int count) {
+	return vshlq_u32(v, vdupq_n_s32(-count));
+}
+
+/** Extract a component from 32-bit pixels and expand it to 8 bits like ColorComponent does. */
+template<int Bits, int Shift>
+static inline uint32x4_t neon_expandComponent(uint32x4_t c) {
+	if (Bits == 1)
+		return vbicq_u32(vdupq_n_u32(0xFF), vceqq_u32(neon_shiftRight(c, Shift), vdupq_n_u32(0)));
+
+	const uint32x4_t v = vandq_u32(neon_shiftRight(c, Shift), vdupq_n_u32((1 << Bits) - 1));
+	if (Bits == 8)
+		return v;
+	return vorrq_u32(vshlq_u32(v, vdupq_n_s32(8 - Bits)), neon_shiftRight(v, Bits >= 4 ? 2 * Bits - 8 : 0));
+}
+
+/** Reduce an 8-bit component and move it to its place in 32-bit pixels. */
+template<int Bits, int Shift>
+static inline uint32x4_t neon_packComponent(uint32x4_t v) {
+	if (Bits == 0)
+		return vdupq_n_u32(0);
+	return vshlq_u32(neon_shiftRight(v, 8 - Bits), vdupq_n_s32(Shift));
+}
+
+template<typename SrcFormat, typename DstFormat>
+static inline uint32x4_t neon_convertPixels(uint32x4_t c) {
+	const uint32x4_t a = (SrcFormat::kABits == 0) ? vdupq_n_u32(0xFF) : neon_expandComponent<SrcFormat::kABits, SrcFormat::kAShift>(c);
+	const uint32x4_t r = neon_expandComponent<SrcFormat::kRBits, SrcFormat::kRShift>(c);
+	const uint32x4_t g = neon_expandComponent<SrcFormat::kGBits, SrcFormat::kGShift>(c);
+	const uint32x4_t b = neon_expandComponent<SrcFormat::kBBits, SrcFormat::kBShift>(c);
+
+	return vorrq_u32(vorrq_u32(neon_packComponent<DstFormat::kABits, DstFormat::kAShift>(a),
+	                           neon_packComponent<DstFormat::kRBits, DstFormat::kRShift>(r)),
+	                 vorrq_u32(neon_packComponent<DstFormat::kGBits, DstFormat::kGShift>(g),
+	                           neon_packComponent<DstFormat::kBBits, DstFormat::kBShift>(b)));
+}
+
+/** Convert eight pixels at a time, working on 32-bit lanes whatever the pixel sizes are. */
+template<typename SrcFormat, typename DstFormat>
+struct FastBlitConvertNEON {
+	enum { kBlock = 8 };
+
+	static inline void convertBlock(byte *dst, const byte *src) {
+		uint32x4_t lo, hi;
+		if (SrcFormat::kBytesPerPixel == 2) {
+			const uint16x8_t pixels = vld1q_u16((const uint16_t *)src);
+			lo = vmovl_u16(vget_low_u16(pixels));
+			hi = vmovl_u16(vget_high_u16(pixels));
+		} else {
+			lo = vld1q_u32((const uint32_t *)src);
+			hi = vld1q_u32((const uint32_t *)(src + 16));
+		}
+
+		lo = neon_convertPixels<SrcFormat, DstFormat>(lo);
+		hi = neon_convertPixels<SrcFormat, DstFormat>(hi);
+
+		if (DstFormat::kBytesPerPixel == 2) {
+			vst1q_u16((uint16_t *)dst, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+		} else {
+			vst1q_u32((uint32_t *)dst, lo);
+			vst1q_u32((uint32_t *)(dst + 16), hi);
+		}
+	}
+};
+
+FastBlitFunc FastBlitConvert::lookupNEON(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	return fastBlitConvertLookup<FastBlitConvertNEON>(dstFmt, srcFmt);
+}
+
 } // end of namespace Graphics
 
 #if !defined(__aarch64__) && !defined(__ARM_NEON)
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 
 #include "graphics/blit/blit-alpha.h"
+#include "graphics/blit/blit-fast.h"
 #include "graphics/pixelformat.h"
 
 #include <emmintrin.h>
@@ -326,6 +327,74 @@ void BlendBlit::blitSSE2(Args &args, const TSpriteBlendMode &blendMode, const Al
 	blitT<BlendBlitImpl_SSE2>(args, blendMode, alphaType);
 }
 
+/** Extract a component from 32-bit pixels and expand it to 8 bits like ColorComponent does. */
+template<int Bits, int Shift>
+static FORCEINLINE __m128i sse2_expandComponent(__m128i c) {
+	if (Bits == 1)
+		return _mm_andnot_si128(_mm_cmpeq_epi32(_mm_srli_epi32(c, Shift), _mm_setzero_si128()), _mm_set1_epi32(0xFF));
+
+	const __m128i v = _mm_and_si128(_mm_srli_epi32(c, Shift), _mm_set1_epi32((1 << Bits) - 1));
+	if (Bits == 8)
+		return v;
+	return _mm_or_si128(_mm_slli_epi32(v, 8 - Bits), _mm_srli_epi32(v, Bits >= 4 ? 2 * Bits - 8 : 0));
+}
+
+/** Reduce an 8-bit component and move it to its place in 32-bit pixels. */
+template<int Bits, int Shift>
+static FORCEINLINE __m128i sse2_packComponent(__m128i v) {
+	if (Bits == 0)
+		return _mm_setzero_si128();
+	return _mm_slli_epi32(_mm_srli_epi32(v, 8 - Bits), Shift);
+}
+
+template<typename SrcFormat, typename DstFormat>
+static FORCEINLINE __m128i sse2_convertPixels(__m128i c) {
+	const __m128i a = (SrcFormat::kABits == 0) ? _mm_set1_epi32(0xFF) : sse2_expandComponent<SrcFormat::kABits, SrcFormat::kAShift>(c);
+	const __m128i r = sse2_expandComponent<SrcFormat::kRBits, SrcFormat::kRShift>(c);
+	const __m128i g = sse2_expandComponent<SrcFormat::kGBits, SrcFormat::kGShift>(c);
+	const __m128i b = sse2_expandComponent<SrcFormat::kBBits, SrcFormat::kBShift>(c);
+
+	return _mm_or_si128(_mm_or_si128(sse2_packComponent<DstFormat::kABits, DstFormat::kAShift>(a),
+	                                 sse2_packComponent<DstFormat::kRBits, DstFormat::kRShift>(r)),
+	                    _mm_or_si128(sse2_packComponent<DstFormat::kGBits, DstFormat::kGShift>(g),
+	                                 sse2_packComponent<DstFormat::kBBits, DstFormat::kBShift>(b)));
+}
+
+/** Convert eight pixels at a time, working on 32-bit lanes whatever the pixel sizes are. */
+template<typename SrcFormat, typename DstFormat>
+struct FastBlitConvertSSE2 {
+	enum { kBlock = 8 };
+
+	static inline void convertBlock(byte *dst, const byte *src) {
+		__m128i lo, hi;
+		if (SrcFormat::kBytesPerPixel == 2) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)src);
+			lo = _mm_unpacklo_epi16(pixels, _mm_setzero_si128());
+			hi = _mm_unpackhi_epi16(pixels, _mm_setzero_si128());
+		} else {
+			lo = _mm_loadu_si128((const __m128i *)src);
+			hi = _mm_loadu_si128((const __m128i *)(src + 16));
+		}
+
+		lo = sse2_convertPixels<SrcFormat, DstFormat>(lo);
+		hi = sse2_convertPixels<SrcFormat, DstFormat>(hi);
+
+		if (DstFormat::kBytesPerPixel == 2) {
+			// Sign extend so that the saturating pack keeps all 16 bits
+			lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+			hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+			_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+		} else {
+			_mm_storeu_si128((__m128i *)dst, lo);
+			_mm_storeu_si128((__m128i *)(dst + 16), hi);
+		}
+	}
+};
+
+FastBlitFunc FastBlitConvert::lookupSSE2(const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	return fastBlitConvertLookup<FastBlitConvertSSE2>(dstFmt, srcFmt);
+}
+
 } // End of namespace Graphics
 
 #if !defined(__x86_64__)
@@ -24,6 +24,13 @@
 namespace Graphics {
 
 void DirtyRectList::merge() {
+	if (_count < kMinTileMergeRects)
+		mergePairs();
+	else
+		mergeTiles();
+}
+
+void DirtyRectList::mergePairs() {
 	Common::List<Common::Rect>::iterator rOuter, rInner;
 
 	// Process the dirty rect list to find any rects to merge
@@ -37,6 +44,7 @@ void DirtyRectList::merge() {
 
 				// remove the inner rect from the list
 				_dirtyRects.erase(rInner);
+				_count--;
 
 				// move back to beginning of list
 				rInner = rOuter;
@@ -45,6 +53,113 @@ void DirtyRectList::merge() {
 	}
 }
 
+/** Set the bits of the tiles first to last of a row of the bitmap. */
+static void setTiles(uint32 *row, int first, int last) {
+	for (int word = first >> 5; word <= last >> 5; word++) {
+		uint32 mask = 0xFFFFFFFF;
+		if (word == first >> 5)
+			mask &= 0xFFFFFFFF << (first & 31);
+		if (word == last >> 5)
+			mask &= 0xFFFFFFFF >> (31 - (last & 31));
+		row[word] |= mask;
+	}
+}
+
+/**
+ * Find the next span of dirty tiles of a row, from x on. On return, x is
+ * the end of the span.
+ */
+static bool findSpan(const uint32 *row, int columns, int &x, int &start) {
+	while (x < columns) {
+		const uint32 bits = row[x >> 5] >> (x & 31);
+		if (bits & 1)
+			break;
+		// Skip the clean tiles of the word at once
+		x = bits ? x + 1 : (x | 31) + 1;
+	}
+	if (x >= columns)
+		return false;
+
+	start = x;
+	while (x < columns && (row[x >> 5] & (1u << (x & 31))))
+		x++;
+	return true;
+}
+
+void DirtyRectList::mergeTiles() {
+	Common::List<Common::Rect>::const_iterator i;
+	Common::Rect bounds;
+	bool hasBounds = false;
+
+	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+		if (i->isEmpty())
+			continue;
+		if (hasBounds)
+			bounds.extend(*i);
+		else
+			bounds = *i;
+		hasBounds = true;
+	}
+
+	if (!hasBounds) {
+		clear();
+		return;
+	}
+
+	// Mark the tiles of the bounding box covered by the rects
+	const int columns = ((bounds.width() - 1) >> kTileShift) + 1;
+	const int rows = ((bounds.height() - 1) >> kTileShift) + 1;
+	const int words = (columns + 31) >> 5;
+
+	_tiles.resize(rows * words);
+	memset(_tiles.data(), 0, _tiles.size() * sizeof(uint32));
+	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+		if (i->isEmpty())
+			continue;
+
+		const int first = (i->left - bounds.left) >> kTileShift;
+		const int last = (i->right - 1 - bounds.left) >> kTileShift;
+		const int bottom = (i->bottom - 1 - bounds.top) >> kTileShift;
+		for (int y = (i->top - bounds.top) >> kTileShift; y <= bottom; y++)
+			setTiles(&_tiles[y * words], first, last);
+	}
+
+	clear();
+
+	// Extract the spans of each row. A span identical to one of the row
+	// above extends its rect, the rects which are not extended are done.
+	// Both lists of spans are sorted from left to right.
+	Common::Array<Common::Rect> open, next;
+	for (int y = 0; y <= rows; y++) {
+		uint o = 0;
+		int x = 0, start;
+
+		next.clear();
+		while (y < rows && findSpan(&_tiles[y * words], columns, x, start)) {
+			while (o < open.size() && open[o].left < start)
+				addTileRect(bounds, open[o++]);
+
+			if (o < open.size() && open[o].left == start && open[o].right == x) {
+				open[o].bottom = y + 1;
+				next.push_back(open[o++]);
+			} else {
+				next.push_back(Common::Rect(start, y, x, y + 1));
+			}
+		}
+
+		while (o < open.size())
+			addTileRect(bounds, open[o++]);
+		open.swap(next);
+	}
+}
+
+void DirtyRectList::addTileRect(const Common::Rect &bounds, const Common::Rect &tiles) {
+	push_back(Common::Rect(bounds.left + (tiles.left << kTileShift),
+	                       bounds.top + (tiles.top << kTileShift),
+	                       MIN<int>(bounds.left + (tiles.right << kTileShift), bounds.right),
+	                       MIN<int>(bounds.top + (tiles.bottom << kTileShift), bounds.bottom)));
+}
+
 bool DirtyRectList::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
 	destRect = src1;
 	destRect.extend(src2);
@@ -22,6 +22,7 @@
 #ifndef GRAPHICS_DIRTYRECTS_H
 #define GRAPHICS_DIRTYRECTS_H
 
+#include "common/array.h"
 #include "common/list.h"
 #include "common/rect.h"
 
@@ -39,24 +40,65 @@ namespace Graphics {
 /**
  * This class keeps track of any areas of a surface that are updated
  * by drawing calls.
+ *
+ * A few rectangles are merged pairwise. Beyond that, merging marks them in
+ * a bitmap of tiles covering their bounding box, and replaces them with the
+ * spans of dirty tiles, joined with the identical spans of the tile rows
+ * below. The cost is then bounded by the area of the rectangles and the
+ * size of the bitmap, the result does not overlap and only exceeds the
+ * original areas up to the tile borders.
  */
 class DirtyRectList {
 public:
 	typedef Common::List<Common::Rect>::const_iterator	const_iterator; /*!< Const-qualified list iterator. */
 
+	enum {
+		/** Number of rectangles from which merge() uses the tiles */
+		kMinTileMergeRects = 8,
+		/** Log2 of the size in pixels of the tiles */
+		kTileShift = 3
+	};
+
 protected:
 	/**
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
 
+	/**
+	 * Number of rectangles in the list, which Common::List does not keep
+	 */
+	uint _count;
+
+	/**
+	 * Bitmap of the dirty tiles, one bit per tile, kept between merges
+	 */
+	Common::Array<uint32> _tiles;
+
 protected:
 	/**
 	 * Returns the union of two dirty area rectangles
 	 */
 	bool unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2);
 
+	/**
+	 * Merges the overlapping rectangles pairwise
+	 */
+	void mergePairs();
+
+	/**
+	 * Merges the rectangles through the bitmap of tiles
+	 */
+	void mergeTiles();
+
+	/**
+	 * Adds a rectangle given in tiles of the bounding box, clipped to it
+	 */
+	void addTileRect(const Common::Rect &bounds, const Common::Rect &tiles);
+
 public:
+	DirtyRectList() : _count(0) {}
+
 	/**
 	 * Merges together overlapping dirty areas of the screen
 	 */
@@ -67,29 +109,34 @@ public:
 	 */
 	bool empty() const { return _dirtyRects.empty(); }
 
+	/**
+	 * Returns the number of dirty areas
+	 */
+	uint size() const { return _count; }
+
 	/**
 	 * Clear the current dirty rects list
 	 */
-	void clear() { _dirtyRects.clear(); }
+	void clear() { _dirtyRects.clear(); _count = 0; }
 
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
 	 * current frame
 	 */
 	template<class... TArgs>
-	void emplace_back(TArgs &&...args) { _dirtyRects.emplace_back(Common::forward<TArgs>(args)...); }
+	void emplace_back(TArgs &&...args) { _dirtyRects.emplace_back(Common::forward<TArgs>(args)...); _count++; }
 
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
 	 * current frame
 	 */
-	void push_back(const Common::Rect &r) { _dirtyRects.push_back(r); }
+	void push_back(const Common::Rect &r) { _dirtyRects.push_back(r); _count++; }
 
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
 	 * current frame
 	 */
-	void push_back(Common::Rect &&r) { _dirtyRects.push_back(Common::move(r)); }
+	void push_back(Common::Rect &&r) { _dirtyRects.push_back(Common::move(r)); _count++; }
 
 	/** Return a const iterator to the start of the list.
 	 *  This can be used, for example, to iterate from the first element
@@ -109,6 +109,46 @@ int getStringWidthImpl(const Font &font, const StringType &str) {
 	return space;
 }
 
+template<class SurfaceType, class StringType>
+bool drawCharRunImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int leftX, int rightX, uint32 color, bool allowCharClipping) {
+	// Collect the characters drawStringImpl would draw. They can only be
+	// drawn as a run when they follow each other in the string.
+	Common::U32String run;
+	int runX = 0;
+	bool gap = false;
+
+	typename StringType::unsigned_type last = 0;
+	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
+		const typename StringType::unsigned_type cur = *i;
+		x += font.getKerningOffset(last, cur);
+		last = cur;
+
+		Common::Rect charBox = font.getBoundingBox(cur);
+
+		if (!allowCharClipping) {
+			if (x + charBox.right > rightX)
+				break;
+		}
+
+		if (x + charBox.right >= leftX) {
+			if (gap)
+				return false;
+			if (run.empty())
+				runX = x;
+			run += (Common::u32char_type_t)cur;
+		} else if (!run.empty()) {
+			gap = true;
+		}
+
+		x += font.getCharWidth(cur);
+	}
+
+	if (run.empty())
+		return true;
+
+	return font.drawCharRun(dst, run, runX, y, color);
+}
+
 template<class SurfaceType, class StringType>
 void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool alpha, bool allowCharClipping) {
 	// The logic in getBoundingImpl is the same as we use here. In case we
@@ -124,6 +164,9 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	if (!alpha && font.hasCharRuns() && drawCharRunImpl(font, dst, str, x, y, leftX, rightX, color, allowCharClipping))
+		return;
+
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
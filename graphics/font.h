@@ -242,6 +242,31 @@ public:
 	virtual void drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const;
 	virtual void drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	/**
+	 * Check whether the font implements drawCharRun.
+	 */
+	virtual bool hasCharRuns() const { return false; }
+
+	/**
+	 * Draw a run of characters in one go.
+	 *
+	 * The characters are placed like drawString places them: each one
+	 * getCharWidth(chr) pixels after the previous one, adjusted by
+	 * getKerningOffset. Fonts that keep rendered strings around implement
+	 * this so that redrawing a string does not go through every character.
+	 *
+	 * @param dst   The surface to draw on.
+	 * @param run   The characters to draw.
+	 * @param x     The x coordinate where to draw the first character.
+	 * @param y     The y coordinate where to draw the characters.
+	 * @param color The color of the characters.
+	 *
+	 * @return False if the run was not drawn, in which case drawString
+	 *         draws the characters one by one.
+	 */
+	virtual bool drawCharRun(Surface *dst, const Common::U32String &run, int x, int y, uint32 color) const { return false; }
+	virtual bool drawCharRun(ManagedSurface *dst, const Common::U32String &run, int x, int y, uint32 color) const { return false; }
+
 	/** @overload */
 
 	/**
@@ -38,6 +38,8 @@
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
 #include "common/ptr.h"
 #include "common/compression/unzip.h"
 
@@ -186,6 +188,12 @@ public:
 	void drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	bool hasCharRuns() const override { return true; }
+	bool drawCharRun(Surface *dst, const Common::U32String &run, int x, int y, uint32 color) const override;
+	bool drawCharRun(ManagedSurface *dst, const Common::U32String &run, int x, int y, uint32 color) const override;
+
+	void getCacheStats(TTFCacheStats &stats) const;
+
 private:
 	bool _initialized;
 	FT_StreamRec_ _stream;
@@ -210,6 +218,66 @@ private:
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
+	/**
+	 * The glyph images are packed into pages of an atlas, shelf by shelf.
+	 * Only the last page created for regular glyphs takes new ones.
+	 */
+	enum {
+		kAtlasPageSize = 256
+	};
+
+	struct AtlasPage {
+		Surface surface;
+		int x, y;
+		int shelfHeight;
+	};
+
+	typedef Common::Array<AtlasPage> Atlas;
+	mutable Atlas _atlas;
+	mutable int _openAtlasPage;
+	void allocateGlyphImage(Surface &image, int w, int h) const;
+
+	/** Kerning offsets, keyed by the glyph indices of the pair. */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
+
+	/**
+	 * Coverage of a whole string, drawn like the coverage of a glyph. It
+	 * does not depend on the color or the destination, so it is keyed by
+	 * the characters only.
+	 */
+	struct CharRun {
+		Surface coverage;
+		int xOffset, yOffset;
+		/** The glyphs cover the same pixels, blending them at once would change the result. */
+		bool overlapping;
+	};
+
+	enum {
+		/** Memory the rendered strings of a font may use. */
+		kRunCacheSize = 256 * 1024
+	};
+
+	typedef Common::List<Common::U32String> RunOrder;
+
+	struct RunEntry {
+		CharRun run;
+		/** Position in _runOrder, the most recently drawn runs come first. */
+		RunOrder::iterator order;
+	};
+
+	typedef Common::HashMap<Common::U32String, RunEntry> RunCache;
+	mutable RunCache _runs;
+	mutable RunOrder _runOrder;
+	mutable uint32 _runBytes;
+	mutable uint32 _runHits, _runMisses;
+
+	const CharRun *getCharRun(const Common::U32String &str) const;
+	void renderCharRun(CharRun &run, const Common::U32String &str) const;
+	void evictCharRun() const;
+	const CharRun *drawCharRunIntern(Surface *dst, const Common::U32String &str, int x, int y, uint32 color,
+		const uint32 *transparentColor) const;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -217,6 +285,8 @@ private:
 	int computePointSizeFromHeaders(int height) const;
 	void drawCharIntern(Surface *dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor, bool alpha) const;
+	void drawCoverage(Surface *dst, const Surface &coverage, int x, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha) const;
 
 	FT_Int32 _loadFlags;
 	FT_Render_Mode _renderMode;
@@ -230,7 +300,7 @@ TTFFont::TTFFont()
 	: _initialized(false), _stream(), _face(), _ttfFile(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
 	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false),
-	  _disposeAfterUse(DisposeAfterUse::NO) {
+	  _disposeAfterUse(DisposeAfterUse::NO), _openAtlasPage(-1), _runBytes(0), _runHits(0), _runMisses(0) {
 }
 
 TTFFont::~TTFFont() {
@@ -241,8 +311,11 @@ TTFFont::~TTFFont() {
 			delete _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (Atlas::iterator i = _atlas.begin(), end = _atlas.end(); i != end; ++i)
+			i->surface.free();
+
+		for (RunCache::iterator i = _runs.begin(), end = _runs.end(); i != end; ++i)
+			i->_value.run.coverage.free();
 
 		_initialized = false;
 	}
@@ -596,9 +669,17 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
+	// Glyph indices of TrueType and OpenType fonts are 16-bit
+	const uint32 pair = (leftGlyph << 16) | (rightGlyph & 0xFFFF);
+	KerningCache::const_iterator kerningEntry = _kerning.find(pair);
+	if (kerningEntry != _kerning.end())
+		return kerningEntry->_value;
+
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	const int offset = kerningVector.x / 64;
+	_kerning[pair] = offset;
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
@@ -722,19 +803,20 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 		return;
 
 	const Glyph &glyph = glyphEntry->_value;
+	drawCoverage(dst, glyph.image, x + glyph.xOffset, y + glyph.yOffset, color, transparentColor, alpha);
+}
 
-	x += glyph.xOffset;
-	y += glyph.yOffset;
-
+void TTFFont::drawCoverage(Surface *dst, const Surface &coverage, int x, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha) const {
 	if (x > dst->w)
 		return;
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = coverage.w;
+	int h = coverage.h;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = (const uint8 *)coverage.getPixels();
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -750,7 +832,7 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * coverage.pitch;
 		h += y;
 		y = 0;
 	}
@@ -765,11 +847,11 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 
 	if (alpha) {
 		if (dst->format.bytesPerPixel == 1) {
-			renderAlphaGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint8>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format);
 		} else if (dst->format.bytesPerPixel == 2) {
-			renderAlphaGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint16>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format);
 		} else if (dst->format.bytesPerPixel == 4) {
-			renderAlphaGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint32>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format);
 		}
 	} else {
 		if (dst->format.isCLUT8()) {
@@ -788,14 +870,14 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 				}
 
 				dstPos += dst->pitch;
-				srcPos += glyph.image.pitch;
+				srcPos += coverage.pitch;
 			}
 		} else if (dst->format.bytesPerPixel == 1) {
-			renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint8>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 		} else if (dst->format.bytesPerPixel == 2) {
-			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 		} else if (dst->format.bytesPerPixel == 4) {
-			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 		}
 	}
 }
@@ -864,8 +946,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		bitmap = &_face->glyph->bitmap;
 	}
 
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		return false;
+	}
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	allocateGlyphImage(glyph.image, bitmap->width, bitmap->rows);
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -880,6 +966,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	case FT_PIXEL_MODE_MONO:
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			const uint8 *curSrc = src;
+			uint8 *curDst = dst;
 			uint8 mask = 0;
 
 			for (int x = 0; x < (int)bitmap->width; ++x) {
@@ -887,12 +974,13 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					*curDst = 255;
 
 				mask <<= 1;
-				++dst;
+				++curDst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -906,9 +994,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		break;
 
 	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
+		break;
 	}
 
 #if FAKE_BOLD == 1
@@ -920,6 +1006,50 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	return true;
 }
 
+void TTFFont::allocateGlyphImage(Surface &image, int w, int h) const {
+	if (!w || !h) {
+		image.init(w, h, w, nullptr, PixelFormat::createFormatCLUT8());
+		return;
+	}
+
+	AtlasPage *page = nullptr;
+
+	if (w > kAtlasPageSize || h > kAtlasPageSize) {
+		// Glyphs too large for the pages get a page of their own
+		_atlas.push_back(AtlasPage());
+		page = &_atlas.back();
+		page->surface.create(w, h, PixelFormat::createFormatCLUT8());
+		page->x = page->y = page->shelfHeight = 0;
+	} else {
+		if (_openAtlasPage >= 0) {
+			page = &_atlas[_openAtlasPage];
+
+			// Start a new shelf when the glyph does not fit on the current one
+			if (page->x + w > kAtlasPageSize) {
+				page->x = 0;
+				page->y += page->shelfHeight;
+				page->shelfHeight = 0;
+			}
+
+			if (page->y + h > kAtlasPageSize)
+				page = nullptr;
+		}
+
+		if (!page) {
+			_openAtlasPage = _atlas.size();
+			_atlas.push_back(AtlasPage());
+			page = &_atlas.back();
+			page->surface.create(kAtlasPageSize, kAtlasPageSize, PixelFormat::createFormatCLUT8());
+			page->x = page->y = page->shelfHeight = 0;
+		}
+	}
+
+	image.init(w, h, page->surface.pitch, page->surface.getBasePtr(page->x, page->y), PixelFormat::createFormatCLUT8());
+
+	page->x += w;
+	page->shelfHeight = MAX(page->shelfHeight, h);
+}
+
 void TTFFont::assureCached(uint32 chr) const {
 	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
 		return;
@@ -931,6 +1061,175 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 }
 
+bool TTFFont::drawCharRun(Surface *dst, const Common::U32String &run, int x, int y, uint32 color) const {
+	return drawCharRunIntern(dst, run, x, y, color, nullptr) != nullptr;
+}
+
+bool TTFFont::drawCharRun(ManagedSurface *dst, const Common::U32String &run, int x, int y, uint32 color) const {
+	const CharRun *charRun;
+	if (dst->hasTransparentColor()) {
+		uint32 transColor = dst->getTransparentColor();
+		charRun = drawCharRunIntern(dst->surfacePtr(), run, x, y, color, &transColor);
+	} else {
+		charRun = drawCharRunIntern(dst->surfacePtr(), run, x, y, color, nullptr);
+	}
+
+	if (!charRun)
+		return false;
+
+	if (charRun->coverage.getPixels()) {
+		Common::Rect runBox(charRun->coverage.w, charRun->coverage.h);
+		runBox.translate(x + charRun->xOffset, y + charRun->yOffset);
+		dst->addDirtyRect(runBox);
+	}
+
+	return true;
+}
+
+const TTFFont::CharRun *TTFFont::drawCharRunIntern(Surface *dst, const Common::U32String &str, int x, int y, uint32 color,
+		const uint32 *transparentColor) const {
+	const CharRun *run = getCharRun(str);
+	if (!run || run->overlapping)
+		return nullptr;
+
+	if (run->coverage.getPixels())
+		drawCoverage(dst, run->coverage, x + run->xOffset, y + run->yOffset, color, transparentColor, false);
+
+	return run;
+}
+
+const TTFFont::CharRun *TTFFont::getCharRun(const Common::U32String &str) const {
+	RunCache::iterator entry = _runs.find(str);
+	if (entry != _runs.end()) {
+		++_runHits;
+		_runOrder.erase(entry->_value.order);
+		_runOrder.push_front(str);
+		entry->_value.order = _runOrder.begin();
+		return &entry->_value.run;
+	}
+
+	++_runMisses;
+
+	RunEntry newEntry;
+	renderCharRun(newEntry.run, str);
+
+	const uint32 size = newEntry.run.coverage.w * newEntry.run.coverage.h;
+	if (size > kRunCacheSize) {
+		newEntry.run.coverage.free();
+		return nullptr;
+	}
+
+	while (_runBytes + size > kRunCacheSize)
+		evictCharRun();
+
+	_runBytes += size;
+	_runOrder.push_front(str);
+	newEntry.order = _runOrder.begin();
+
+	RunEntry &cached = _runs[str];
+	cached = newEntry;
+	return &cached.run;
+}
+
+void TTFFont::renderCharRun(CharRun &run, const Common::U32String &str) const {
+	run.xOffset = run.yOffset = 0;
+	run.overlapping = false;
+
+	// Place the glyphs like drawString does and find the area they cover
+	Common::Array<const Glyph *> glyphs;
+	Common::Array<Common::Point> positions;
+	Common::Rect bounds;
+
+	int x = 0;
+	uint32 last = 0;
+	for (Common::U32String::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
+		const uint32 cur = *i;
+		if (i != str.begin())
+			x += getKerningOffset(last, cur);
+		last = cur;
+
+		assureCached(cur);
+		GlyphCache::const_iterator glyphEntry = _glyphs.find(cur);
+		if (glyphEntry == _glyphs.end())
+			continue;
+
+		const Glyph &glyph = glyphEntry->_value;
+		if (glyph.image.getPixels()) {
+			const Common::Rect glyphBox(x + glyph.xOffset, glyph.yOffset, x + glyph.xOffset + glyph.image.w, glyph.yOffset + glyph.image.h);
+			if (glyphs.empty())
+				bounds = glyphBox;
+			else
+				bounds.extend(glyphBox);
+
+			glyphs.push_back(&glyph);
+			positions.push_back(Common::Point(glyphBox.left, glyphBox.top));
+		}
+
+		x += glyph.advance;
+	}
+
+	if (glyphs.empty())
+		return;
+
+	run.xOffset = bounds.left;
+	run.yOffset = bounds.top;
+	run.coverage.create(bounds.width(), bounds.height(), PixelFormat::createFormatCLUT8());
+
+	for (uint i = 0; i < glyphs.size(); ++i) {
+		const Surface &image = glyphs[i]->image;
+		for (int cy = 0; cy < image.h; ++cy) {
+			const uint8 *src = (const uint8 *)image.getBasePtr(0, cy);
+			uint8 *dst = (uint8 *)run.coverage.getBasePtr(positions[i].x - bounds.left, positions[i].y - bounds.top + cy);
+
+			for (int cx = 0; cx < image.w; ++cx) {
+				if (!src[cx])
+					continue;
+
+				if (dst[cx]) {
+					// There is no need to keep the coverage, the glyphs
+					// of this run are always drawn one by one
+					run.overlapping = true;
+					run.coverage.free();
+					return;
+				}
+
+				dst[cx] = src[cx];
+			}
+		}
+	}
+}
+
+void TTFFont::evictCharRun() const {
+	RunCache::iterator entry = _runs.find(_runOrder.back());
+	_runOrder.pop_back();
+
+	_runBytes -= entry->_value.run.coverage.w * entry->_value.run.coverage.h;
+	entry->_value.run.coverage.free();
+	_runs.erase(entry);
+}
+
+void TTFFont::getCacheStats(TTFCacheStats &stats) const {
+	stats.glyphs = _glyphs.size();
+	stats.atlasPages = _atlas.size();
+	stats.atlasBytes = 0;
+	for (Atlas::const_iterator i = _atlas.begin(), end = _atlas.end(); i != end; ++i)
+		stats.atlasBytes += i->surface.pitch * i->surface.h;
+	stats.kerningPairs = _kerning.size();
+	stats.runs = _runs.size();
+	stats.runBytes = _runBytes;
+	stats.runHits = _runHits;
+	stats.runMisses = _runMisses;
+}
+
+bool getTTFCacheStats(const Font *font, TTFCacheStats &stats) {
+	const TTFFont *ttfFont = dynamic_cast<const TTFFont *>(font);
+	if (!ttfFont)
+		return false;
+
+	ttfFont->getCacheStats(stats);
+	return true;
+}
+
 Font *loadTTFFont(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
 	TTFFont *font = new TTFFont();
 
@@ -142,6 +142,31 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint xdpi = 0, uint ydpi = 0,TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Statistics of the caches of a TTF font.
+ *
+ * The glyphs of a font are kept in an atlas, and the strings drawn with
+ * drawString in a cache of rendered strings, which drops the least recently
+ * drawn ones when it grows too large.
+ */
+struct TTFCacheStats {
+	uint glyphs;        ///< Number of glyphs in the atlas.
+	uint atlasPages;    ///< Number of pages of the atlas.
+	uint32 atlasBytes;  ///< Memory used by the atlas.
+	uint kerningPairs;  ///< Number of cached kerning offsets.
+	uint runs;          ///< Number of rendered strings.
+	uint32 runBytes;    ///< Memory used by the rendered strings.
+	uint32 runHits;     ///< Number of strings drawn from the cache.
+	uint32 runMisses;   ///< Number of strings that had to be rendered.
+};
+
+/**
+ * Query the cache statistics of a font loaded with loadTTFFont.
+ *
+ * @return False if the font is not a TTF font.
+ */
+bool getTTFCacheStats(const Font *font, TTFCacheStats &stats);
+
 void shutdownTTF();
 
 } // End of namespace Graphics
@@ -36,9 +36,22 @@ protected:
 						   uint8 *dstPtr, uint32 dstPitch,
 						   const uint8 *oldSrcPtr, uint32 oldSrcPitch,
 						   int width, int height, const uint8 *buffer, uint32 bufferPitch) override;
+	bool canScaleBands() const override { return true; }
 
 private:
 
+	/**
+	 * Scratch state of an anti-aliasing pass. Each pass has its own, so that
+	 * bands of rows can be scaled concurrently.
+	 */
+	struct PassState {
+		int16 *chosenGreyscale;        ///< pointer to chosen greyscale table
+		int16 *bptr;                   ///< too awkward to pass variables
+		int8 simSum;                   ///< sum of similarity matrix
+		int16 greyscaleDiffs[3][8];
+		int16 bplanes[3][9];
+	};
+
 	/**
 	 * Choose greyscale bitplane to use, return diff array.  Exit early and
 	 * return NULL for a block of solid color (all diffs zero).
@@ -64,7 +77,7 @@ private:
 	 * bitplanes.  The increase in image quality is well worth the speed hit.
 	 */
 	template<typename ColorMask>
-	int16 *chooseGreyscale(typename ColorMask::PixelType *pixels);
+	int16 *chooseGreyscale(PassState &state, typename ColorMask::PixelType *pixels);
 
 	/**
 	 * Calculate the distance between pixels in RGB space.  Greyscale isn't
@@ -73,7 +86,7 @@ private:
 	 * useful results.
 	 */
 	template<typename ColorMask>
-	int32 calcPixelDiffNosqrt(typename ColorMask::PixelType pixel1, typename ColorMask::PixelType pixel2);
+	int32 calcPixelDiffNosqrt(PassState &state, typename ColorMask::PixelType pixel1, typename ColorMask::PixelType pixel2);
 
 	/**
 	 * Create vectors of all delta grey values from center pixel, with magnitudes
@@ -88,7 +101,7 @@ private:
 	 * Don't replace any of the double math with integer-based approximations,
 	 * since everything I have tried has lead to slight mis-detection errors.
 	 */
-	int findPrincipleAxis(int16 *diffs, int16 *bplane,
+	int findPrincipleAxis(PassState &state, int16 *diffs, int16 *bplane,
 		int8 *sim,
 		int32 *return_angle);
 
@@ -96,7 +109,7 @@ private:
 	 * Check for mis-detected arrow patterns.  Return 1 (good), 0 (bad).
 	 */
 	template<typename Pixel>
-	int checkArrows(int best_dir, Pixel *pixels, int8 *sim, int half_flag);
+	int checkArrows(PassState &state, int best_dir, Pixel *pixels, int8 *sim, int half_flag);
 
 	/**
 	 * Take original direction, refine it by testing different pixel difference
@@ -106,14 +119,14 @@ private:
 	 * refinement algorithms.
 	 */
 	template<typename Pixel>
-	int refineDirection(char edge_type, Pixel *pixels, int16 *bptr,
+	int refineDirection(PassState &state, char edge_type, Pixel *pixels, int16 *bptr,
 		int8 *sim, double angle);
 
 	/**
 	 * "Chess Knight" patterns can be mis-detected, fix easy cases.
 	 */
 	template<typename Pixel>
-	int fixKnights(int sub_type, Pixel *pixels, int8 *sim);
+	int fixKnights(PassState &state, int sub_type, Pixel *pixels, int8 *sim);
 
 	/**
 	 * Initialize various lookup tables
@@ -125,7 +138,7 @@ private:
 	 * Fill pixel grid with or without interpolation, using the detected edge
 	 */
 	template<typename ColorMask>
-	void antiAliasGrid2x(uint8 *dptr, int dstPitch,
+	void antiAliasGrid2x(PassState &state, uint8 *dptr, int dstPitch,
 		typename ColorMask::PixelType *pixels, int sub_type, int16 *bptr,
 		int8 *sim,
 		int interpolate_2x);
@@ -134,7 +147,7 @@ private:
 	 * Fill pixel grid without interpolation, using the detected edge
 	 */
 	template<typename ColorMask>
-	void antiAliasGridClean3x(uint8 *dptr, int dstPitch,
+	void antiAliasGridClean3x(PassState &state, uint8 *dptr, int dstPitch,
 		typename ColorMask::PixelType *pixels, int sub_type, int16 *bptr);
 
 	/**
@@ -162,11 +175,6 @@ private:
 
 	int16 _rgbTable[65536][3];       ///< table lookup for RGB
 	int16 _greyscaleTable[3][65536]; ///< greyscale tables
-	int16 *_chosenGreyscale;               ///< pointer to chosen greyscale table
-	int16 *_bptr;                          ///< too awkward to pass variables
-	int8 _simSum;                          ///< sum of similarity matrix
-	int16 _greyscaleDiffs[3][8];
-	int16 _bplanes[3][9];
 };
 
 
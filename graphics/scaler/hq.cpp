@@ -19,9 +19,13 @@
  */
 
 #include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq_intern.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 
+#include "common/array.h"
+#include "common/system.h"
+
 // RGB-to-YUV lookup table
 
 #ifdef USE_NASM
@@ -173,7 +177,7 @@ void HQScaler::initLUT(Graphics::PixelFormat format) {
 #define PIXEL11_90	*(q+1+nextlineDst) = interpolate_2_3_3(w5, w6, w8);
 #define PIXEL11_100	*(q+1+nextlineDst) = interpolate_14_1_1(w5, w6, w8);
 
-#define YUV(x)	(sizeof(Pixel) == 2 ? RGBtoYUV[w ## x] : ConvertYUV<ColorMask>(w ## x, RGBtoYUV))
+#define YUV(x)	yuv ## x
 
 /**
  * Convert 32 bit RGB values to Yuv
@@ -193,13 +197,107 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+HQPatterns::RowFunc HQPatterns::rowFunc = nullptr;
+bool HQPatterns::selected = false;
+
+void HQPatterns::selectRowFunc() {
+	rowFunc = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		rowFunc = rowNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		rowFunc = rowSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		rowFunc = rowAVX2;
+#endif
+	selected = true;
+}
+
+/**
+ * Rolling YUV values of the rows around the current one, and the patterns
+ * of its pixels. Equal pixels have equal YUV values, which never differ, so
+ * the patterns only depend on the YUV values.
+ */
+template<typename ColorMask>
+class HQPatternRows {
+	typedef typename ColorMask::PixelType Pixel;
+
+public:
+	HQPatternRows(const Pixel *p, uint32 nextlineSrc, int width, const uint32 *RGBtoYUV, HQPatterns::RowFunc rowFunc) :
+		_nextlineSrc(nextlineSrc), _width(width), _RGBtoYUV(RGBtoYUV), _rowFunc(rowFunc),
+		_yuv(3 * (width + 2)), _patterns(width) {
+		// Each row starts with the pixel on the left of the rect
+		_above = &_yuv[1];
+		_row = _above + width + 2;
+		_below = _row + width + 2;
+		convertRow(_above, p - nextlineSrc);
+		convertRow(_row, p);
+	}
+
+	/** Compute the patterns of the row starting at p. */
+	void nextRow(const Pixel *p) {
+		convertRow(_below, p + _nextlineSrc);
+
+		int x = _rowFunc ? _rowFunc(_patterns.data(), _above, _row, _below, _width) : 0;
+		for (; x < _width; x++) {
+			const uint32 yuv5 = _row[x];
+			int pattern = 0;
+			if (diffYUV(yuv5, _above[x - 1])) pattern |= 0x0001;
+			if (diffYUV(yuv5, _above[x]))     pattern |= 0x0002;
+			if (diffYUV(yuv5, _above[x + 1])) pattern |= 0x0004;
+			if (diffYUV(yuv5, _row[x - 1]))   pattern |= 0x0008;
+			if (diffYUV(yuv5, _row[x + 1]))   pattern |= 0x0010;
+			if (diffYUV(yuv5, _below[x - 1])) pattern |= 0x0020;
+			if (diffYUV(yuv5, _below[x]))     pattern |= 0x0040;
+			if (diffYUV(yuv5, _below[x + 1])) pattern |= 0x0080;
+			_patterns[x] = pattern;
+		}
+	}
+
+	/** Move to the next row, once the current one has been scaled. */
+	void advance() {
+		uint32 *above = _above;
+		_above = _row;
+		_row = _below;
+		_below = above;
+	}
+
+	const uint8 *patterns() const { return _patterns.data(); }
+	const uint32 *above() const { return _above; }
+	const uint32 *row() const { return _row; }
+	const uint32 *below() const { return _below; }
+
+private:
+	void convertRow(uint32 *yuv, const Pixel *p) const {
+		for (int x = -1; x <= _width; x++) {
+			if (sizeof(Pixel) == 2)
+				yuv[x] = _RGBtoYUV[p[x]];
+			else
+				yuv[x] = ConvertYUV<ColorMask>(p[x], _RGBtoYUV);
+		}
+	}
+
+	const uint32 _nextlineSrc;
+	const int _width;
+	const uint32 *_RGBtoYUV;
+	HQPatterns::RowFunc _rowFunc;
+
+	Common::Array<uint32> _yuv;
+	Common::Array<uint8> _patterns;
+	uint32 *_above, *_row, *_below;
+};
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQPatterns::RowFunc patternFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -221,7 +319,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQPatternRows<ColorMask> rows(p, nextlineSrc, width, RGBtoYUV, patternFunc);
+	const uint8 *patterns = rows.patterns();
+
 	while (height--) {
+		rows.nextRow(p);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -238,16 +341,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int x = width - tmpWidth - 1;
+			const int pattern = patterns[x];
+			const uint32 yuv2 = rows.above()[x];
+			const uint32 yuv4 = rows.row()[x - 1];
+			const uint32 yuv6 = rows.row()[x + 1];
+			const uint32 yuv8 = rows.below()[x];
 
 			switch (pattern) {
 			case 0:
@@ -2051,6 +2150,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 
 			q += 2;
 		}
+		rows.advance();
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 2;
 	}
@@ -2116,7 +2216,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQPatterns::RowFunc patternFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -2139,7 +2239,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	HQPatternRows<ColorMask> rows(p, nextlineSrc, width, RGBtoYUV, patternFunc);
+	const uint8 *patterns = rows.patterns();
+
 	while (height--) {
+		rows.nextRow(p);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -2156,16 +2261,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int x = width - tmpWidth - 1;
+			const int pattern = patterns[x];
+			const uint32 yuv2 = rows.above()[x];
+			const uint32 yuv4 = rows.row()[x - 1];
+			const uint32 yuv6 = rows.row()[x + 1];
+			const uint32 yuv8 = rows.below()[x];
 
 			switch (pattern) {
 			case 0:
@@ -4942,6 +5043,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 
 			q += 3;
 		}
+		rows.advance();
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 3;
 	}
@@ -4954,6 +5056,10 @@ HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 	_RGBtoYUV(nullptr) {
 	_factor = 2;
 
+	if (!HQPatterns::selected)
+		HQPatterns::selectRowFunc();
+	_patternFunc = HQPatterns::rowFunc;
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4987,19 +5093,19 @@ void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 }
 
 void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 }
 #endif
 
@@ -5007,15 +5113,15 @@ void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	}
 }
 
@@ -5023,15 +5129,15 @@ void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _patternFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _patternFunc);
 	}
 }
 
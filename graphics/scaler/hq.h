@@ -22,6 +22,7 @@
 #define GRAPHICS_SCALER_HQ_H
 
 #include "graphics/scalerplugin.h"
+#include "graphics/scaler/hq_intern.h"
 
 #ifdef USE_NASM
 struct hqx_parameters;
@@ -36,6 +37,9 @@ public:
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+#ifndef USE_NASM
+	bool canScaleBands() const override { return true; }
+#endif
 
 	void initLUT(Graphics::PixelFormat format);
 	inline void HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
@@ -44,6 +48,8 @@ protected:
 	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 
 	uint32 *_RGBtoYUV;
+	/** SIMD kernel computing the patterns of the C++ versions, or nullptr */
+	HQPatterns::RowFunc _patternFunc;
 #ifdef USE_NASM
 	hqx_parameters *_hqx_params;
 #endif
@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+/** Return bit in the lanes of the pixels which differ from their neighbour, see sse2_diff. */
+static FORCEINLINE __m256i avx2_diff(__m256i yuv, const uint32 *neighbour, __m256i thresholds, int bit) {
+	const __m256i n = _mm256_loadu_si256((const __m256i *)neighbour);
+	const __m256i absDiff = _mm256_or_si256(_mm256_subs_epu8(yuv, n), _mm256_subs_epu8(n, yuv));
+	const __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(absDiff, thresholds), _mm256_setzero_si256());
+	return _mm256_andnot_si256(same, _mm256_set1_epi32(bit));
+}
+
+/** Compute the patterns of eight pixels, in the low bytes of the lanes. */
+static FORCEINLINE __m256i avx2_patterns(const uint32 *above, const uint32 *row, const uint32 *below, __m256i thresholds) {
+	const __m256i yuv = _mm256_loadu_si256((const __m256i *)row);
+	__m256i pattern = avx2_diff(yuv, above - 1, thresholds, 0x01);
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, above, thresholds, 0x02));
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, above + 1, thresholds, 0x04));
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, row - 1, thresholds, 0x08));
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, row + 1, thresholds, 0x10));
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, below - 1, thresholds, 0x20));
+	pattern = _mm256_or_si256(pattern, avx2_diff(yuv, below, thresholds, 0x40));
+	return _mm256_or_si256(pattern, avx2_diff(yuv, below + 1, thresholds, 0x80));
+}
+
+int HQPatterns::rowAVX2(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width) {
+	const __m256i thresholds = _mm256_set1_epi32(kHQYUVThresholds);
+	// The packs work within 128-bit lanes, which leaves the groups of
+	// four patterns in the order 0, 2, 0, 2, 1, 3, 1, 3
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		const __m256i lo = avx2_patterns(above + x, row + x, below + x, thresholds);
+		const __m256i hi = avx2_patterns(above + x + 8, row + x + 8, below + x + 8, thresholds);
+		const __m256i words = _mm256_packs_epi32(lo, hi);
+		const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(words, words), order);
+		_mm_storeu_si128((__m128i *)(patterns + x), _mm256_castsi256_si128(bytes));
+	}
+
+	return x;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_SCALER_HQ_INTERN_H
+#define GRAPHICS_SCALER_HQ_INTERN_H
+
+#include "common/scummsys.h"
+
+/**
+ * SIMD kernels computing the patterns of the HQ scalers.
+ *
+ * The pattern of a pixel has one bit per neighbour, in the order w1, w2,
+ * w3, w4, w6, w7, w8 and w9, which is set when the YUV values of the pixel
+ * and of the neighbour differ by more than the thresholds of diffYUV. The
+ * kernels compare the three channels of several pixels at once and handle
+ * the pixels of a row in blocks, the caller computes the remaining ones.
+ */
+class HQPatterns {
+public:
+	/**
+	 * @param patterns  Receives the patterns of the pixels of the row.
+	 * @param above     YUV values of the row above, from index -1 to width.
+	 * @param row       YUV values of the row, from index -1 to width.
+	 * @param below     YUV values of the row below, from index -1 to width.
+	 * @param width     Number of pixels of the row.
+	 * @return The number of patterns computed from the start of the row.
+	 */
+	typedef int(*RowFunc)(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width);
+
+	/** The best kernel supported by the CPU, or nullptr. */
+	static RowFunc rowFunc;
+	static bool selected;
+
+	static void selectRowFunc();
+
+#ifdef SCUMMVM_NEON
+	static int rowNEON(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width);
+#endif
+#ifdef SCUMMVM_SSE2
+	static int rowSSE2(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width);
+#endif
+#ifdef SCUMMVM_AVX2
+	static int rowAVX2(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width);
+#endif
+};
+
+/**
+ * The thresholds of diffYUV, one byte per channel of a YUV value: V in the
+ * low byte, then U and Y.
+ */
+enum {
+	kHQYUVThresholds = 0x00300706
+};
+
+#endif
@@ -0,0 +1,86 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/hq_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+/** Return bit in the lanes of the pixels which differ from their neighbour. */
+static inline uint32x4_t neon_diff(uint8x16_t yuv, const uint32 *neighbour, uint8x16_t thresholds, uint32x4_t bit) {
+	const uint8x16_t n = vld1q_u8((const uint8 *)neighbour);
+	const uint32x4_t over = vreinterpretq_u32_u8(vcgtq_u8(vabdq_u8(yuv, n), thresholds));
+	return vandq_u32(vtstq_u32(over, over), bit);
+}
+
+/** Compute the patterns of four pixels, in the low bytes of the lanes. */
+static inline uint32x4_t neon_patterns(const uint32 *above, const uint32 *row, const uint32 *below, uint8x16_t thresholds) {
+	const uint8x16_t yuv = vld1q_u8((const uint8 *)row);
+	uint32x4_t pattern = neon_diff(yuv, above - 1, thresholds, vdupq_n_u32(0x01));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, above, thresholds, vdupq_n_u32(0x02)));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, above + 1, thresholds, vdupq_n_u32(0x04)));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, row - 1, thresholds, vdupq_n_u32(0x08)));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, row + 1, thresholds, vdupq_n_u32(0x10)));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, below - 1, thresholds, vdupq_n_u32(0x20)));
+	pattern = vorrq_u32(pattern, neon_diff(yuv, below, thresholds, vdupq_n_u32(0x40)));
+	return vorrq_u32(pattern, neon_diff(yuv, below + 1, thresholds, vdupq_n_u32(0x80)));
+}
+
+int HQPatterns::rowNEON(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width) {
+	const uint8x16_t thresholds = vreinterpretq_u8_u32(vdupq_n_u32(kHQYUVThresholds));
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const uint32x4_t lo = neon_patterns(above + x, row + x, below + x, thresholds);
+		const uint32x4_t hi = neon_patterns(above + x + 4, row + x + 4, below + x + 4, thresholds);
+		const uint16x8_t words = vcombine_u16(vmovn_u32(lo), vmovn_u32(hi));
+		vst1_u8(patterns + x, vmovn_u16(words));
+	}
+
+	return x;
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+/**
+ * Return bit in the lanes of the pixels which differ from their neighbour.
+ * The absolute differences of the channels are taken with saturating
+ * subtractions, what is left after subtracting the thresholds is non zero
+ * when one of them is exceeded.
+ */
+static FORCEINLINE __m128i sse2_diff(__m128i yuv, const uint32 *neighbour, __m128i thresholds, int bit) {
+	const __m128i n = _mm_loadu_si128((const __m128i *)neighbour);
+	const __m128i absDiff = _mm_or_si128(_mm_subs_epu8(yuv, n), _mm_subs_epu8(n, yuv));
+	const __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(absDiff, thresholds), _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+
+/** Compute the patterns of four pixels, in the low bytes of the lanes. */
+static FORCEINLINE __m128i sse2_patterns(const uint32 *above, const uint32 *row, const uint32 *below, __m128i thresholds) {
+	const __m128i yuv = _mm_loadu_si128((const __m128i *)row);
+	__m128i pattern = sse2_diff(yuv, above - 1, thresholds, 0x01);
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, above, thresholds, 0x02));
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, above + 1, thresholds, 0x04));
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, row - 1, thresholds, 0x08));
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, row + 1, thresholds, 0x10));
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, below - 1, thresholds, 0x20));
+	pattern = _mm_or_si128(pattern, sse2_diff(yuv, below, thresholds, 0x40));
+	return _mm_or_si128(pattern, sse2_diff(yuv, below + 1, thresholds, 0x80));
+}
+
+int HQPatterns::rowSSE2(uint8 *patterns, const uint32 *above, const uint32 *row, const uint32 *below, int width) {
+	const __m128i thresholds = _mm_set1_epi32(kHQYUVThresholds);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const __m128i lo = sse2_patterns(above + x, row + x, below + x, thresholds);
+		const __m128i hi = sse2_patterns(above + x + 4, row + x + 4, below + x + 4, thresholds);
+		const __m128i words = _mm_packs_epi32(lo, hi);
+		_mm_storel_epi64((__m128i *)(patterns + x), _mm_packus_epi16(words, words));
+	}
+
+	return x;
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
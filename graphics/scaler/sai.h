@@ -31,6 +31,7 @@ public:
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+	bool canScaleBands() const override { return true; }
 };
 
 class SuperSAIScaler : public Scaler {
@@ -41,6 +42,7 @@ public:
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+	bool canScaleBands() const override { return true; }
 };
 
 class SuperEagleScaler : public Scaler {
@@ -51,6 +53,7 @@ public:
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+	bool canScaleBands() const override { return true; }
 };
 
 #endif
@@ -50,6 +50,8 @@ public:
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
+	// The intermediate rows of Scale4x make its edge pixels depend on the band
+	bool canScaleBands() const override { return _factor != 4; }
 };
 
 #endif
@@ -20,7 +20,17 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/jobsystem.h"
+
 namespace {
+
+enum {
+	/** Minimum number of rows of a band scaled on its own. */
+	kMinBandRows = 8,
+	/** Minimum number of source pixels of a band, smaller bands are not worth a job. */
+	kMinBandPixels = 8 * 1024
+};
+
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
  * source to the destination.
@@ -53,7 +63,25 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 			Normal1x<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 		}
 	} else {
-		scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		const int bandRows = MAX<int>(kMinBandRows, kMinBandPixels / MAX(width, 1));
+		const int bandCount = height / bandRows;
+
+		if (bandCount > 1 && canScaleBands() && JobMan.isThreaded()) {
+			// The bands are spread evenly, so that none is smaller than
+			// bandRows. Reading around a band only touches the source, so
+			// the extra pixels scalers look at do not need any overlap.
+			JobMan.parallelFor(0, bandCount, 1, [&](int firstBand, int lastBand) {
+				const int first = firstBand * height / bandCount;
+				const int last = lastBand * height / bandCount;
+				scaleIntern(srcPtr + first * srcPitch, srcPitch,
+				            dstPtr + first * _factor * dstPitch, dstPitch,
+				            width, last - first, x, y + first);
+			});
+		} else {
+			scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		}
+
+		finishScale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 	}
 }
 
@@ -111,6 +139,14 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	            _oldSrc + offset, srcPitch,
 	            width, height,
 	            (uint8 *)_bufferedOutput.getBasePtr(x * _factor, y * _factor), _bufferedOutput.pitch);
+}
+
+void SourceScaler::finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+						 uint32 dstPitch, int width, int height, int x, int y) {
+	if (!_enable)
+		return;
+
+	int offset = (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
 
 	// Update the destination buffer
 	byte *buffer = (byte *)_bufferedOutput.getBasePtr(x * _factor, y * _factor);
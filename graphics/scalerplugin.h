@@ -33,6 +33,10 @@ public:
 	/**
 	 * Scale a rect.
 	 *
+	 * Scalers which allow it (see canScaleBands) scale large rects in bands
+	 * of rows on the threads of the job system. The result is the same as
+	 * the one of scaling the rect at once.
+	 *
 	 * @param srcPtr   Pointer to the source buffer.
 	 * @param srcPitch The number of bytes in a scanline of the source.
 	 * @param dstPtr   Pointer to the destination buffer.
@@ -101,6 +105,22 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) = 0;
 
+	/**
+	 * Whether scaleIntern can be called concurrently on bands of rows of
+	 * a rect. This requires that it keeps no state between calls, reads
+	 * only the source around the band and writes only the destination rows
+	 * of the band.
+	 */
+	virtual bool canScaleBands() const { return false; }
+
+	/**
+	 * Called once all the bands of a rect have been scaled.
+	 *
+	 * @see scale
+	 */
+	virtual void finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+	                         uint32 dstPitch, int width, int height, int x, int y) {}
+
 	uint _factor;
 	Graphics::PixelFormat _format;
 };
@@ -127,6 +147,13 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) final;
 
+	/**
+	 * Copy the scaled rect to the buffered output and update the old source,
+	 * once internScale has been called on all its bands.
+	 */
+	virtual void finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+	                         uint32 dstPitch, int width, int height, int x, int y) final;
+
 	/**
 	 * Scalers must implement this function. It will be called by oldSrcScale.
 	 * If by comparing the src and oldsrc images it is discovered that no change
@@ -27,6 +27,8 @@
 
 #include "common/singleton.h"
 #include "common/array.h"
+#include "common/jobsystem.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/tinygl.h"
 #include "graphics/tinygl/zgl.h"
@@ -359,6 +361,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	_drawCallAllocator[1].initialize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
+	// Without a backend, there are no worker threads to rasterize with
+	_tiledRasterizationEnabled = g_system && JobMan.isThreaded();
 }
 
 void GLContext::deinit() {
@@ -371,6 +375,7 @@ void GLContext::deinit() {
 	free_texture(default_texture);
 	endSharedState();
 	gl_free(vertex);
+	deinitTiles();
 	delete fb;
 }
 
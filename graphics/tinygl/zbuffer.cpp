@@ -50,6 +50,8 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	else
 		_sbuf = nullptr;
 
+	_ownsBuffers = true;
+
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
 
@@ -58,13 +60,43 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_clippingEnabled = false;
 }
 
+FrameBuffer::FrameBuffer(const FrameBuffer *target) {
+	shareBuffers(target);
+	_ownsBuffers = false;
+
+	_currentTexture = nullptr;
+	_textureEnv = nullptr;
+
+	_clippingEnabled = false;
+}
+
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
+
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+void FrameBuffer::shareBuffers(const FrameBuffer *target) {
+	_pbufWidth = target->_pbufWidth;
+	_pbufHeight = target->_pbufHeight;
+	_pbufFormat = target->_pbufFormat;
+	_pbufBpp = target->_pbufBpp;
+	_pbufPitch = target->_pbufPitch;
+
+	_pbuf = target->_pbuf;
+	_zbuf = target->_zbuf;
+	_sbuf = target->_sbuf;
+	_offscreenBuffer = target->_offscreenBuffer;
+
+	_enableStencil = target->_enableStencil;
+	_textureSize = target->_textureSize;
+	_textureSizeMask = target->_textureSizeMask;
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
@@ -107,8 +107,19 @@ struct ZBufferPoint {
 
 struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
+	/**
+	 * Create a frame buffer drawing to the buffers of target, with a rendering
+	 * state of its own. The buffers stay owned by target.
+	 */
+	explicit FrameBuffer(const FrameBuffer *target);
 	~FrameBuffer();
 
+	/**
+	 * Draw to the buffers currently selected by target, which may have
+	 * changed since the frame buffer was created.
+	 */
+	void shareBuffers(const FrameBuffer *target);
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -826,6 +837,7 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _ownsBuffers;
 
 	bool _enableStencil;
 	int _textureSize;
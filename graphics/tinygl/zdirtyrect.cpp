@@ -24,6 +24,7 @@
 #include "graphics/tinygl/gl.h"
 
 #include "common/debug.h"
+#include "common/jobsystem.h"
 
 namespace TinyGL {
 
@@ -207,12 +208,20 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (auto &drawCall : _drawCallsQueue) {
-			Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+		if (canRasterizeInTiles()) {
+			Common::Array<Common::Rect> regions;
 			for (auto &rect : rectangles) {
-				Common::Rect dirtyRegion = rect.rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					drawCall->execute(true, &dirtyRegion);
+				regions.push_back(rect.rectangle);
+			}
+			executeDrawCallsInTiles(&regions);
+		} else {
+			for (auto &drawCall : _drawCallsQueue) {
+				Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+				for (auto &rect : rectangles) {
+					Common::Rect dirtyRegion = rect.rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						drawCall->execute(true, &dirtyRegion);
+					}
 				}
 			}
 		}
@@ -252,8 +261,15 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
+	if (canRasterizeInTiles()) {
+		executeDrawCallsInTiles(nullptr);
+	} else {
+		for (const auto &drawCall : _drawCallsQueue) {
+			drawCall->execute(true);
+		}
+	}
+
 	for (const auto &drawCall : _drawCallsQueue) {
-		drawCall->execute(true);
 		delete drawCall;
 	}
 
@@ -264,6 +280,108 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	_drawCallAllocator[_currentAllocatorIndex].reset();
 }
 
+bool GLContext::canRasterizeInTiles() const {
+	// Selection and profiling update state shared by the whole context
+	return _tiledRasterizationEnabled && render_mode != TGL_SELECT && !_profilingEnabled;
+}
+
+void GLContext::initTiles() {
+	int width = fb->getPixelBufferWidth();
+	int height = fb->getPixelBufferHeight();
+
+	for (int y = 0; y < height; y += TILE_SIZE) {
+		for (int x = 0; x < width; x += TILE_SIZE) {
+			GLTile tile;
+			tile.rect = Common::Rect(x, y, MIN(x + TILE_SIZE, width), MIN(y + TILE_SIZE, height));
+			tile.context = new GLContext();
+			tile.context->_textureSize = _textureSize;
+			tile.context->fb = new FrameBuffer(fb);
+			tile.context->fb->setTextureEnvironment(&tile.context->_texEnv);
+			_tiles.push_back(tile);
+		}
+	}
+}
+
+void GLContext::deinitTiles() {
+	for (auto &tile : _tiles) {
+		delete tile.context->fb;
+		delete tile.context;
+	}
+	_tiles.clear();
+}
+
+void GLContext::executeDrawCallsInTiles(const Common::Array<Common::Rect> *regions) {
+	if (_tiles.empty())
+		initTiles();
+
+	// Besides the state recorded in the draw calls, the rasterization uses
+	// the buffers and some state of the context at the time of presenting.
+	for (auto &tile : _tiles) {
+		GLContext *c = tile.context;
+		c->fb->shareBuffers(fb);
+		c->current_cull_face = current_cull_face;
+		c->vertex_n = vertex_n;
+		c->render_mode = render_mode;
+	}
+
+	Common::List<DrawCall *>::const_iterator it = _drawCallsQueue.begin();
+	while (it != _drawCallsQueue.end()) {
+		// Blits and clears are executed on this thread, between the runs of
+		// consecutive rasterizations.
+		if ((*it)->getType() != DrawCall::DrawCall_Rasterization) {
+			if (!regions) {
+				(*it)->execute(true);
+			} else {
+				Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+				for (const auto &region : *regions) {
+					Common::Rect dirtyRegion = region;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						(*it)->execute(true, &dirtyRegion);
+					}
+				}
+			}
+			++it;
+			continue;
+		}
+
+		Common::List<DrawCall *>::const_iterator first = it;
+		while (it != _drawCallsQueue.end() && (*it)->getType() == DrawCall::DrawCall_Rasterization) {
+			++it;
+		}
+		rasterizeInTiles(first, it, regions);
+	}
+}
+
+void GLContext::rasterizeInTiles(Common::List<DrawCall *>::const_iterator first, Common::List<DrawCall *>::const_iterator last,
+                                 const Common::Array<Common::Rect> *regions) {
+	// Every tile runs all its draw calls in order on a single thread and is
+	// clipped to its own pixels, so the depth and stencil buffers are shared
+	// without locking and each pixel is drawn as by a serial rasterization.
+	JobMan.parallelFor(0, _tiles.size(), 1, [&](int firstTile, int lastTile) {
+		for (int i = firstTile; i < lastTile; i++) {
+			GLTile &tile = _tiles[i];
+			for (Common::List<DrawCall *>::const_iterator it = first; it != last; ++it) {
+				const RasterizationDrawCall *drawCall = (const RasterizationDrawCall *)*it;
+				Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+				if (!drawCallRegion.intersects(tile.rect))
+					continue;
+
+				if (!regions) {
+					drawCall->executeInTile(tile, &tile.rect);
+					continue;
+				}
+
+				for (const auto &region : *regions) {
+					Common::Rect clippingRectangle = region.findIntersectingRect(tile.rect);
+					if (clippingRectangle.intersects(drawCallRegion)) {
+						drawCall->executeInTile(tile, &clippingRectangle);
+					}
+				}
+			}
+		}
+	});
+}
+
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
@@ -307,7 +425,8 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
 	_state = captureState();
-	if (c->_enableDirtyRectangles) {
+	// The tiled rasterization bins the draw calls by their dirty region
+	if (c->_enableDirtyRectangles || c->_tiledRasterizationEnabled) {
 		computeDirtyRegion();
 	}
 }
@@ -352,12 +471,34 @@ void RasterizationDrawCall::execute(bool restoreState, const Common::Rect *clipp
 	if (restoreState) {
 		backupState = captureState();
 	}
-	applyState(_state, clippingRectangle);
+	applyState(c, _state, clippingRectangle);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	rasterize(c, _vertex);
+
+	c->vertex = prevVertex;
+	c->vertex_cnt = prevVertexCount;
+
+	if (restoreState) {
+		applyState(c, backupState, nullptr);
+	}
+}
+
+void RasterizationDrawCall::executeInTile(GLTile &tile, const Common::Rect *clippingRectangle) const {
+	// Strips and quads are rasterized by modifying the vertices, so each
+	// tile works on a copy of them.
+	if (tile.vertices.size() < (uint)_vertexCount)
+		tile.vertices.resize(_vertexCount);
+	memcpy(tile.vertices.data(), _vertex, sizeof(GLVertex) * _vertexCount);
+
+	applyState(tile.context, _state, clippingRectangle);
+	rasterize(tile.context, tile.vertices.data());
+}
+
+void RasterizationDrawCall::rasterize(GLContext *c, GLVertex *vertex) const {
+	c->vertex = vertex;
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
@@ -436,13 +577,6 @@ void RasterizationDrawCall::execute(bool restoreState, const Common::Rect *clipp
 	default:
 		error("glBegin: type %x not handled", c->begin_type);
 	}
-
-	c->vertex = prevVertex;
-	c->vertex_cnt = prevVertexCount;
-
-	if (restoreState) {
-		applyState(backupState, nullptr);
-	}
 }
 
 RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
@@ -503,8 +637,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state, const Common::Rect *clippingRectangle) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state, const Common::Rect *clippingRectangle) const {
 	c->fb->setupScissor(state.enableScissor, state.scissor, clippingRectangle);
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
@@ -37,6 +37,7 @@ void *allocateFrame(int size);
 struct GLContext;
 struct GLVertex;
 struct GLTexture;
+struct GLTile;
 
 struct GLTextureEnvArgument {
 	GLTextureEnvArgument();
@@ -123,6 +124,8 @@ public:
 	virtual ~RasterizationDrawCall() { }
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const;
+	// Rasterize with the context of a tile, leaving the recorded vertices untouched.
+	void executeInTile(GLTile &tile, const Common::Rect *clippingRectangle) const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -131,6 +134,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	void rasterize(GLContext *c, GLVertex *vertex) const;
 	typedef void (*gl_draw_triangle_func_ptr)(GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	GLVertex *_vertex;
@@ -192,7 +196,7 @@ private:
 	RasterizationState _state;
 
 	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state, const Common::Rect *clippingRectangle) const;
+	void applyState(GLContext *c, const RasterizationState &state, const Common::Rect *clippingRectangle) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
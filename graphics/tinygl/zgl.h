@@ -76,6 +76,9 @@ enum {
 #define MAX_DISPLAY_LISTS 1024
 #define OP_BUFFER_MAX_SIZE 512
 
+// width and height of the tiles of the tiled rasterization
+#define TILE_SIZE 128
+
 #define TGL_OFFSET_FILL    0x1
 #define TGL_OFFSET_LINE    0x2
 #define TGL_OFFSET_POINT   0x4
@@ -278,6 +281,16 @@ struct GLContext;
 
 typedef void (*gl_draw_triangle_func)(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
 
+// A screen tile of the tiled rasterization. Its context and frame buffer
+// draw to the buffers of the main context, but hold their own rendering
+// state, so that each tile can be rasterized by a different thread.
+struct GLTile {
+	Common::Rect rect;
+	GLContext *context;
+	// Copy of the vertices of the draw call being rasterized
+	Common::Array<GLVertex> vertices;
+};
+
 // display context
 
 struct GLContext {
@@ -472,6 +485,10 @@ struct GLContext {
 	bool _debugRectsEnabled;
 	bool _profilingEnabled;
 
+	// Tiled rasterization
+	bool _tiledRasterizationEnabled;
+	Common::Array<GLTile> _tiles;
+
 	void gl_vertex_transform(GLVertex *v);
 	void gl_calc_fog_factor(GLVertex *v);
 
@@ -529,6 +546,13 @@ public:
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
 
+	bool canRasterizeInTiles() const;
+	void initTiles();
+	void deinitTiles();
+	void executeDrawCallsInTiles(const Common::Array<Common::Rect> *regions);
+	void rasterizeInTiles(Common::List<DrawCall *>::const_iterator first, Common::List<DrawCall *>::const_iterator last,
+	                      const Common::Array<Common::Rect> *regions);
+
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
 	GLSpecBuf *specbuf_get_buffer(const int shininess_i, const float shininess);
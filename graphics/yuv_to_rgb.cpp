@@ -82,8 +82,10 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -99,15 +101,17 @@ public:
 	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
 	const int16 *getColorTable() const { return _colorTab; }
 	const byte *getClipTable() const { return _clipTable; }
+	const YUVToRGBRowFormat &getRowFormat() const { return _rowFormat; }
 
 private:
 	Graphics::PixelFormat _format;
 	YUVToRGBManager::LuminanceScale _scale;
+	YUVToRGBRowFormat _rowFormat;
 	int16 _colorTab[4 * 256]; // 2048 bytes
 	byte _clipTable[3 * 768];
 };
 
-YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
+YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) : _rowFormat(format, scale) {
 	_format = format;
 	_scale = scale;
 
@@ -181,6 +185,48 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 	}
 }
 
+YUVToRGBRowFormat::YUVToRGBRowFormat(const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	itu = (scale == YUVToRGBManager::kScaleITU);
+	bytesPerPixel = format.bytesPerPixel;
+	rLoss = format.rLoss;
+	gLoss = format.gLoss;
+	bLoss = format.bLoss;
+	aLoss = format.aLoss;
+	rShift = format.rShift;
+	gShift = format.gShift;
+	bShift = format.bShift;
+	aShift = format.aShift;
+	aMask = (0xFF >> format.aLoss) << format.aShift;
+}
+
+YUVToRGBRow::RowFunc YUVToRGBRow::row444 = nullptr;
+YUVToRGBRow::RowFunc YUVToRGBRow::row422 = nullptr;
+bool YUVToRGBRow::selected = false;
+
+void YUVToRGBRow::selectRowFuncs() {
+	row444 = nullptr;
+	row422 = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		row444 = row444NEON;
+		row422 = row422NEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		row444 = row444SSE2;
+		row422 = row422SSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		row444 = row444AVX2;
+		row422 = row422AVX2;
+	}
+#endif
+	selected = true;
+}
+
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
 }
@@ -198,6 +244,12 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+static YUVToRGBRow::RowFunc getRowFunc(bool halfChroma) {
+	if (!YUVToRGBRow::selected)
+		YUVToRGBRow::selectRowFuncs();
+	return halfChroma ? YUVToRGBRow::row422 : YUVToRGBRow::row444;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
@@ -246,6 +298,26 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	YUVToRGBRow::RowFunc rowFunc = getRowFunc(false);
+	if (rowFunc) {
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h++) {
+			const int done = rowFunc(dstPtr, ySrc, uSrc, vSrc, nullptr, yWidth, lookup->getRowFormat());
+			if (done < yWidth) {
+				if (dst->format.bytesPerPixel == 2)
+					convertYUV444ToRGB<uint16>(dstPtr + done * 2, dst->pitch, lookup, ySrc + done, uSrc + done, vSrc + done, yWidth - done, 1, yPitch, uvPitch);
+				else
+					convertYUV444ToRGB<uint32>(dstPtr + done * 4, dst->pitch, lookup, ySrc + done, uSrc + done, vSrc + done, yWidth - done, 1, yPitch, uvPitch);
+			}
+
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -303,6 +375,26 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	YUVToRGBRow::RowFunc rowFunc = getRowFunc(true);
+	if (rowFunc) {
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h++) {
+			const int done = rowFunc(dstPtr, ySrc, uSrc, vSrc, nullptr, yWidth, lookup->getRowFormat());
+			if (done < yWidth) {
+				if (dst->format.bytesPerPixel == 2)
+					convertYUV422ToRGB<uint16>(dstPtr + done * 2, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 1, yPitch, uvPitch);
+				else
+					convertYUV422ToRGB<uint32>(dstPtr + done * 4, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 1, yPitch, uvPitch);
+			}
+
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -347,7 +439,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -364,6 +456,28 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	YUVToRGBRow::RowFunc rowFunc = getRowFunc(true);
+	if (rowFunc) {
+		// Each chroma row is shared by two rows of pixels
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h += 2) {
+			int done = rowFunc(dstPtr, ySrc, uSrc, vSrc, nullptr, yWidth, lookup->getRowFormat());
+			done = MIN(done, rowFunc(dstPtr + dst->pitch, ySrc + yPitch, uSrc, vSrc, nullptr, yWidth, lookup->getRowFormat()));
+			if (done < yWidth) {
+				if (dst->format.bytesPerPixel == 2)
+					convertYUV420ToRGB<uint16>(dstPtr + done * 2, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 2, yPitch, uvPitch);
+				else
+					convertYUV420ToRGB<uint32>(dstPtr + done * 4, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, 2, yPitch, uvPitch);
+			}
+
+			dstPtr += dst->pitch * 2;
+			ySrc += yPitch * 2;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -415,7 +529,7 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		aSrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
@@ -433,6 +547,29 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	YUVToRGBRow::RowFunc rowFunc = getRowFunc(true);
+	if (rowFunc) {
+		// Each chroma row is shared by two rows of pixels
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int h = 0; h < yHeight; h += 2) {
+			int done = rowFunc(dstPtr, ySrc, uSrc, vSrc, aSrc, yWidth, lookup->getRowFormat());
+			done = MIN(done, rowFunc(dstPtr + dst->pitch, ySrc + yPitch, uSrc, vSrc, aSrc + yPitch, yWidth, lookup->getRowFormat()));
+			if (done < yWidth) {
+				if (dst->format.bytesPerPixel == 2)
+					convertYUVA420ToRGBA<uint16>(dstPtr + done * 2, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, aSrc + done, yWidth - done, 2, yPitch, uvPitch);
+				else
+					convertYUVA420ToRGBA<uint32>(dstPtr + done * 4, dst->pitch, lookup, ySrc + done, uSrc + done / 2, vSrc + done / 2, aSrc + done, yWidth - done, 2, yPitch, uvPitch);
+			}
+
+			dstPtr += dst->pitch * 2;
+			ySrc += yPitch * 2;
+			aSrc += yPitch * 2;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -505,6 +642,24 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			DO_YUV410_PIXEL();
 		}
 
+		// The last pixels interpolate towards the extra chroma column
+		if (yWidth & 3) {
+			int xDiff = 0;
+			int yDiff = y & 3;
+			int index = (y >> 2) * uvPitch + quarterWidth;
+
+			byte u, v;
+			int16 cr_r, crb_g, cb_b;
+			const byte *L;
+
+			READ_QUAD(uSrc, u);
+			READ_QUAD(vSrc, v);
+
+			for (int x = 0; x < (yWidth & 3); x++) {
+				DO_YUV410_PIXEL();
+			}
+		}
+
 		dstPtr += dstPitch - yWidth * sizeof(PixelInt);
 		ySrc += yPitch - yWidth;
 	}
@@ -514,16 +669,73 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
 
+/**
+ * Interpolate a row of 410 chroma to full resolution, like DO_INTERPOLATION
+ * does: the vertical interpolation of two neighbouring columns is shared by
+ * the four pixels between them. The loops are simple enough for the
+ * compiler to vectorize.
+ */
+static const int kYUV410ChunkSize = 256;
+
+static void interpolateYUV410Row(byte *dst, const byte *src, int uvPitch, int yDiff, int width) {
+	int16 columns[kYUV410ChunkSize / 4 + 1];
+	// A partial group of pixels at the end is filled like a whole one
+	const int count = (width + 3) >> 2;
+	assert(count < (int)ARRAYSIZE(columns));
+
+	for (int x = 0; x <= count; x++)
+		columns[x] = src[x] * (4 - yDiff) + src[x + uvPitch] * yDiff;
+
+	for (int x = 0; x < count; x++) {
+		const int left = columns[x] << 2;
+		const int step = columns[x + 1] - columns[x];
+		dst[x * 4 + 0] = left >> 4;
+		dst[x * 4 + 1] = (left + step) >> 4;
+		dst[x * 4 + 2] = (left + step * 2) >> 4;
+		dst[x * 4 + 3] = (left + step * 3) >> 4;
+	}
+}
+
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	YUVToRGBRow::RowFunc rowFunc = getRowFunc(false);
+	if (rowFunc) {
+		// Interpolate the chroma of a chunk of pixels, then convert them as 444
+		byte uChunk[kYUV410ChunkSize], vChunk[kYUV410ChunkSize];
+
+		byte *dstPtr = (byte *)dst->getPixels();
+		for (int y = 0; y < yHeight; y++) {
+			const byte *uRow = uSrc + (y >> 2) * uvPitch;
+			const byte *vRow = vSrc + (y >> 2) * uvPitch;
+
+			for (int x = 0; x < yWidth; x += kYUV410ChunkSize) {
+				const int width = MIN(kYUV410ChunkSize, yWidth - x);
+				byte *chunkDst = dstPtr + x * dst->format.bytesPerPixel;
+				interpolateYUV410Row(uChunk, uRow + (x >> 2), uvPitch, y & 3, width);
+				interpolateYUV410Row(vChunk, vRow + (x >> 2), uvPitch, y & 3, width);
+
+				const int done = rowFunc(chunkDst, ySrc + x, uChunk, vChunk, nullptr, width, lookup->getRowFormat());
+				if (done < width) {
+					if (dst->format.bytesPerPixel == 2)
+						convertYUV444ToRGB<uint16>(chunkDst + done * 2, dst->pitch, lookup, ySrc + x + done, uChunk + done, vChunk + done, width - done, 1, yPitch, kYUV410ChunkSize);
+					else
+						convertYUV444ToRGB<uint32>(chunkDst + done * 4, dst->pitch, lookup, ySrc + x + done, uChunk + done, vChunk + done, width - done, 1, yPitch, kYUV410ChunkSize);
+				}
+			}
+
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
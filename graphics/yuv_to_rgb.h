@@ -128,7 +128,7 @@ public:
 	 * @param ySrc    the source of the y component
 	 * @param uSrc    the source of the u component
 	 * @param vSrc    the source of the v component
-	 * @param yWidth  the width of the y surface (must be divisible by 4)
+	 * @param yWidth  the width of the y surface
 	 * @param yHeight the height of the y surface (must be divisible by 4)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
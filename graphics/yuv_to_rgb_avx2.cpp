@@ -0,0 +1,183 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+/** Shift counts and masks of the output format, ready for the shift instructions. */
+struct AVX2RowFormat {
+	explicit AVX2RowFormat(const YUVToRGBRowFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		aMask16 = _mm256_set1_epi16((int16)format.aMask);
+		aMask32 = _mm256_set1_epi32(format.aMask);
+	}
+
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	__m256i aMask16, aMask32;
+};
+
+/** Compute what sixteen pairs of chroma samples add to the luminance of each channel. */
+static FORCEINLINE void avx2_chromaTerms(__m256i u, __m256i v, __m256i &r, __m256i &g, __m256i &b) {
+	const __m256i bias = _mm256_set1_epi16(128);
+	const __m256i du = _mm256_sub_epi16(u, bias);
+	const __m256i dv = _mm256_sub_epi16(v, bias);
+	const __m256i au = _mm256_abs_epi16(du);
+	const __m256i av = _mm256_abs_epi16(dv);
+
+	// _mm256_sign_epi16 also zeroes the terms of a zero difference, which
+	// are zero anyway
+	r = _mm256_sign_epi16(_mm256_add_epi16(av, _mm256_mulhi_epu16(av, _mm256_set1_epi16((int16)kYUVToRGBCrR))), dv);
+	b = _mm256_sign_epi16(_mm256_add_epi16(au, _mm256_mulhi_epu16(au, _mm256_set1_epi16((int16)kYUVToRGBCbB))), du);
+	const __m256i gv = _mm256_sign_epi16(_mm256_mulhi_epu16(av, _mm256_set1_epi16((int16)kYUVToRGBCrG)), dv);
+	const __m256i gu = _mm256_sign_epi16(_mm256_mulhi_epu16(au, _mm256_set1_epi16((int16)kYUVToRGBCbG)), du);
+	g = _mm256_sub_epi16(_mm256_setzero_si256(), _mm256_add_epi16(gv, gu));
+}
+
+/** Clip a channel value to the luminance range and scale it to [0, 255]. */
+template<bool kITU>
+static FORCEINLINE __m256i avx2_clip(__m256i x) {
+	if (kITU) {
+		const __m256i low = _mm256_set1_epi16(16);
+		x = _mm256_sub_epi16(_mm256_min_epi16(_mm256_max_epi16(x, low), _mm256_set1_epi16(235)), low);
+		return _mm256_add_epi16(x, _mm256_mulhi_epu16(x, _mm256_set1_epi16(kYUVToRGBITUScale)));
+	}
+
+	return _mm256_min_epi16(_mm256_max_epi16(x, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+}
+
+/** Widen the first or last eight channel values to 32 bits and shift them into place. */
+static FORCEINLINE __m256i avx2_place32(__m128i x, __m128i shift) {
+	return _mm256_sll_epi32(_mm256_cvtepu16_epi32(x), shift);
+}
+
+/** Convert and store sixteen pixels. */
+template<int kBpp, bool kITU, bool kAlpha>
+static FORCEINLINE void avx2_putPixels(byte *dst, __m256i y, __m256i a, __m256i cr, __m256i cg, __m256i cb, const AVX2RowFormat &format) {
+	const __m256i r = _mm256_srl_epi16(avx2_clip<kITU>(_mm256_add_epi16(y, cr)), format.rLoss);
+	const __m256i g = _mm256_srl_epi16(avx2_clip<kITU>(_mm256_add_epi16(y, cg)), format.gLoss);
+	const __m256i b = _mm256_srl_epi16(avx2_clip<kITU>(_mm256_add_epi16(y, cb)), format.bLoss);
+	if (kAlpha)
+		a = _mm256_srl_epi16(a, format.aLoss);
+
+	if (kBpp == 2) {
+		__m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_sll_epi16(r, format.rShift), _mm256_sll_epi16(g, format.gShift)), _mm256_sll_epi16(b, format.bShift));
+		pixels = _mm256_or_si256(pixels, kAlpha ? _mm256_sll_epi16(a, format.aShift) : format.aMask16);
+		_mm256_storeu_si256((__m256i *)dst, pixels);
+	} else {
+		__m256i lo = _mm256_or_si256(_mm256_or_si256(avx2_place32(_mm256_castsi256_si128(r), format.rShift), avx2_place32(_mm256_castsi256_si128(g), format.gShift)), avx2_place32(_mm256_castsi256_si128(b), format.bShift));
+		__m256i hi = _mm256_or_si256(_mm256_or_si256(avx2_place32(_mm256_extracti128_si256(r, 1), format.rShift), avx2_place32(_mm256_extracti128_si256(g, 1), format.gShift)), avx2_place32(_mm256_extracti128_si256(b, 1), format.bShift));
+		lo = _mm256_or_si256(lo, kAlpha ? avx2_place32(_mm256_castsi256_si128(a), format.aShift) : format.aMask32);
+		hi = _mm256_or_si256(hi, kAlpha ? avx2_place32(_mm256_extracti128_si256(a, 1), format.aShift) : format.aMask32);
+		_mm256_storeu_si256((__m256i *)dst, lo);
+		_mm256_storeu_si256((__m256i *)(dst + 32), hi);
+	}
+}
+
+/** Load sixteen bytes as 16-bit values. */
+static FORCEINLINE __m256i avx2_load16(const byte *src) {
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)src));
+}
+
+/** Duplicate each of the first or last eight values of a vector, in order. */
+static FORCEINLINE void avx2_double(__m256i x, __m256i &lo, __m256i &hi) {
+	// Unpacking works per 128-bit lane, so put the quarters in the right lanes first
+	x = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0));
+	lo = _mm256_unpacklo_epi16(x, x);
+	hi = _mm256_unpackhi_epi16(x, x);
+}
+
+/** Convert the row in blocks of thirty-two pixels. */
+template<bool kHalfChroma, int kBpp, bool kITU, bool kAlpha>
+static int avx2_row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &rowFormat) {
+	const AVX2RowFormat format(rowFormat);
+	const __m256i zero = _mm256_setzero_si256();
+
+	int x = 0;
+	for (; x + 32 <= width; x += 32, dst += 32 * kBpp) {
+		__m256i rLo, gLo, bLo, rHi, gHi, bHi;
+
+		if (kHalfChroma) {
+			__m256i r, g, b;
+			avx2_chromaTerms(avx2_load16(uSrc + x / 2), avx2_load16(vSrc + x / 2), r, g, b);
+			avx2_double(r, rLo, rHi);
+			avx2_double(g, gLo, gHi);
+			avx2_double(b, bLo, bHi);
+		} else {
+			avx2_chromaTerms(avx2_load16(uSrc + x), avx2_load16(vSrc + x), rLo, gLo, bLo);
+			avx2_chromaTerms(avx2_load16(uSrc + x + 16), avx2_load16(vSrc + x + 16), rHi, gHi, bHi);
+		}
+
+		avx2_putPixels<kBpp, kITU, kAlpha>(dst, avx2_load16(ySrc + x), kAlpha ? avx2_load16(aSrc + x) : zero, rLo, gLo, bLo, format);
+		avx2_putPixels<kBpp, kITU, kAlpha>(dst + 16 * kBpp, avx2_load16(ySrc + x + 16), kAlpha ? avx2_load16(aSrc + x + 16) : zero, rHi, gHi, bHi, format);
+	}
+
+	return x;
+}
+
+template<bool kHalfChroma>
+static YUVToRGBRow::RowFunc avx2_rowFunc(const YUVToRGBRowFormat &format, bool alpha) {
+	if (format.bytesPerPixel == 2) {
+		if (format.itu)
+			return alpha ? avx2_row<kHalfChroma, 2, true, true> : avx2_row<kHalfChroma, 2, true, false>;
+		return alpha ? avx2_row<kHalfChroma, 2, false, true> : avx2_row<kHalfChroma, 2, false, false>;
+	}
+
+	if (format.itu)
+		return alpha ? avx2_row<kHalfChroma, 4, true, true> : avx2_row<kHalfChroma, 4, true, false>;
+	return alpha ? avx2_row<kHalfChroma, 4, false, true> : avx2_row<kHalfChroma, 4, false, false>;
+}
+
+int YUVToRGBRow::row444AVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return avx2_rowFunc<false>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+int YUVToRGBRow::row422AVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return avx2_rowFunc<true>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+/**
+ * Output format of the row converters, derived from the pixel format and
+ * the luminance scale of a conversion.
+ */
+struct YUVToRGBRowFormat {
+	YUVToRGBRowFormat(const PixelFormat &format, YUVToRGBManager::LuminanceScale scale);
+
+	bool itu;
+	byte bytesPerPixel;
+	byte rLoss, gLoss, bLoss, aLoss;
+	byte rShift, gShift, bShift, aShift;
+	/** Alpha bits of an opaque pixel */
+	uint32 aMask;
+};
+
+/**
+ * SIMD row converters of the YUV to RGB conversion.
+ *
+ * Instead of going through the lookup tables, the chroma terms and the
+ * clipping to the luminance range are computed in fixed point, which gives
+ * exactly the same pixels as the tables. The converters are selected at
+ * runtime; when none is available, the lookup tables are used.
+ *
+ * Each converter handles the pixels of a row in blocks and returns how
+ * many it converted, the caller converts the remaining ones.
+ */
+class YUVToRGBRow {
+public:
+	/**
+	 * @param dst       Destination pixels.
+	 * @param ySrc      Luminance, width values.
+	 * @param uSrc      Blue chroma, one value per pixel or per pair of pixels.
+	 * @param vSrc      Red chroma, one value per pixel or per pair of pixels.
+	 * @param aSrc      Alpha, width values, or nullptr for opaque pixels.
+	 * @param width     Number of pixels, a multiple of 2 for halved chroma.
+	 * @param format    The output format.
+	 * @return The number of pixels converted from the start of the row.
+	 */
+	typedef int(*RowFunc)(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+
+	/** Converter for full resolution chroma, or nullptr. */
+	static RowFunc row444;
+	/** Converter for chroma halved horizontally, or nullptr. */
+	static RowFunc row422;
+	static bool selected;
+
+	static void selectRowFuncs();
+
+#ifdef SCUMMVM_NEON
+	static int row444NEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+	static int row422NEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+#endif
+#ifdef SCUMMVM_SSE2
+	static int row444SSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+	static int row422SSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+#endif
+#ifdef SCUMMVM_AVX2
+	static int row444AVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+	static int row422AVX2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format);
+#endif
+};
+
+/**
+ * Fixed point constants of the row converters. The chroma factors of the
+ * lookup tables are split into an integral part and a 0.16 fraction, the
+ * products truncate towards zero like the float to int16 casts of the
+ * tables do. kYUVToRGBITUScale is the fraction of 255 / 219 - 1 rounded up,
+ * which gives the integer quotient of the table for all values of the ITU
+ * range.
+ */
+enum {
+	kYUVToRGBCrR = 26302, // 0.419 / 0.299 - 1
+	kYUVToRGBCrG = 46766, // 0.299 / 0.419
+	kYUVToRGBCbG = 22571, // 0.114 / 0.331
+	kYUVToRGBCbB = 50686, // 0.587 / 0.331 - 1
+	kYUVToRGBITUScale = 10774
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,209 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+/** Shift counts and masks of the output format. Right shifts are negative counts. */
+struct NEONRowFormat {
+	explicit NEONRowFormat(const YUVToRGBRowFormat &format) {
+		rLoss = vdupq_n_s16(-format.rLoss);
+		gLoss = vdupq_n_s16(-format.gLoss);
+		bLoss = vdupq_n_s16(-format.bLoss);
+		aLoss = vdupq_n_s16(-format.aLoss);
+		rShift16 = vdupq_n_s16(format.rShift);
+		gShift16 = vdupq_n_s16(format.gShift);
+		bShift16 = vdupq_n_s16(format.bShift);
+		aShift16 = vdupq_n_s16(format.aShift);
+		rShift32 = vdupq_n_s32(format.rShift);
+		gShift32 = vdupq_n_s32(format.gShift);
+		bShift32 = vdupq_n_s32(format.bShift);
+		aShift32 = vdupq_n_s32(format.aShift);
+		aMask16 = vdupq_n_u16((uint16)format.aMask);
+		aMask32 = vdupq_n_u32(format.aMask);
+	}
+
+	int16x8_t rLoss, gLoss, bLoss, aLoss;
+	int16x8_t rShift16, gShift16, bShift16, aShift16;
+	int32x4_t rShift32, gShift32, bShift32, aShift32;
+	uint16x8_t aMask16;
+	uint32x4_t aMask32;
+};
+
+/** Multiply by the sign of a chroma difference, given as a mask. */
+static inline int16x8_t neon_applySign(int16x8_t x, int16x8_t sign) {
+	return vsubq_s16(veorq_s16(x, sign), sign);
+}
+
+/** The high halves of the unsigned products of x and c. */
+static inline int16x8_t neon_mulhi(int16x8_t x, uint16 c) {
+	const uint16x8_t ux = vreinterpretq_u16_s16(x);
+	const uint32x4_t lo = vmull_n_u16(vget_low_u16(ux), c);
+	const uint32x4_t hi = vmull_n_u16(vget_high_u16(ux), c);
+	return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+}
+
+/** Compute what eight pairs of chroma samples add to the luminance of each channel. */
+static inline void neon_chromaTerms(int16x8_t u, int16x8_t v, int16x8_t &r, int16x8_t &g, int16x8_t &b) {
+	const int16x8_t bias = vdupq_n_s16(128);
+	const int16x8_t du = vsubq_s16(u, bias);
+	const int16x8_t dv = vsubq_s16(v, bias);
+	const int16x8_t su = vshrq_n_s16(du, 15);
+	const int16x8_t sv = vshrq_n_s16(dv, 15);
+	const int16x8_t au = vabsq_s16(du);
+	const int16x8_t av = vabsq_s16(dv);
+
+	r = neon_applySign(vaddq_s16(av, neon_mulhi(av, kYUVToRGBCrR)), sv);
+	b = neon_applySign(vaddq_s16(au, neon_mulhi(au, kYUVToRGBCbB)), su);
+	const int16x8_t gv = neon_applySign(neon_mulhi(av, kYUVToRGBCrG), sv);
+	const int16x8_t gu = neon_applySign(neon_mulhi(au, kYUVToRGBCbG), su);
+	g = vnegq_s16(vaddq_s16(gv, gu));
+}
+
+/** Clip a channel value to the luminance range and scale it to [0, 255]. */
+template<bool kITU>
+static inline uint16x8_t neon_clip(int16x8_t x) {
+	if (kITU) {
+		const int16x8_t low = vdupq_n_s16(16);
+		x = vsubq_s16(vminq_s16(vmaxq_s16(x, low), vdupq_n_s16(235)), low);
+		return vreinterpretq_u16_s16(vaddq_s16(x, neon_mulhi(x, kYUVToRGBITUScale)));
+	}
+
+	return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(x, vdupq_n_s16(0)), vdupq_n_s16(255)));
+}
+
+/** Convert and store eight pixels. */
+template<int kBpp, bool kITU, bool kAlpha>
+static inline void neon_putPixels(byte *dst, int16x8_t y, uint16x8_t a, int16x8_t cr, int16x8_t cg, int16x8_t cb, const NEONRowFormat &format) {
+	const uint16x8_t r = vshlq_u16(neon_clip<kITU>(vaddq_s16(y, cr)), format.rLoss);
+	const uint16x8_t g = vshlq_u16(neon_clip<kITU>(vaddq_s16(y, cg)), format.gLoss);
+	const uint16x8_t b = vshlq_u16(neon_clip<kITU>(vaddq_s16(y, cb)), format.bLoss);
+	if (kAlpha)
+		a = vshlq_u16(a, format.aLoss);
+
+	if (kBpp == 2) {
+		uint16x8_t pixels = vorrq_u16(vorrq_u16(vshlq_u16(r, format.rShift16), vshlq_u16(g, format.gShift16)), vshlq_u16(b, format.bShift16));
+		pixels = vorrq_u16(pixels, kAlpha ? vshlq_u16(a, format.aShift16) : format.aMask16);
+		vst1q_u16((uint16_t *)dst, pixels);
+	} else {
+		uint32x4_t lo = vorrq_u32(vorrq_u32(vshlq_u32(vmovl_u16(vget_low_u16(r)), format.rShift32), vshlq_u32(vmovl_u16(vget_low_u16(g)), format.gShift32)), vshlq_u32(vmovl_u16(vget_low_u16(b)), format.bShift32));
+		uint32x4_t hi = vorrq_u32(vorrq_u32(vshlq_u32(vmovl_u16(vget_high_u16(r)), format.rShift32), vshlq_u32(vmovl_u16(vget_high_u16(g)), format.gShift32)), vshlq_u32(vmovl_u16(vget_high_u16(b)), format.bShift32));
+		lo = vorrq_u32(lo, kAlpha ? vshlq_u32(vmovl_u16(vget_low_u16(a)), format.aShift32) : format.aMask32);
+		hi = vorrq_u32(hi, kAlpha ? vshlq_u32(vmovl_u16(vget_high_u16(a)), format.aShift32) : format.aMask32);
+		vst1q_u32((uint32_t *)dst, lo);
+		vst1q_u32((uint32_t *)(dst + 16), hi);
+	}
+}
+
+static inline int16x8_t neon_widen(uint8x8_t x) {
+	return vreinterpretq_s16_u16(vmovl_u8(x));
+}
+
+/** Convert the row in blocks of sixteen pixels. */
+template<bool kHalfChroma, int kBpp, bool kITU, bool kAlpha>
+static int neon_row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &rowFormat) {
+	const NEONRowFormat format(rowFormat);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16, dst += 16 * kBpp) {
+		const uint8x16_t y = vld1q_u8(ySrc + x);
+		const uint8x16_t a = kAlpha ? vld1q_u8(aSrc + x) : vdupq_n_u8(0);
+		int16x8_t rLo, gLo, bLo, rHi, gHi, bHi;
+
+		if (kHalfChroma) {
+			int16x8_t r, g, b;
+			neon_chromaTerms(neon_widen(vld1_u8(uSrc + x / 2)), neon_widen(vld1_u8(vSrc + x / 2)), r, g, b);
+			const int16x8x2_t rr = vzipq_s16(r, r);
+			const int16x8x2_t gg = vzipq_s16(g, g);
+			const int16x8x2_t bb = vzipq_s16(b, b);
+			rLo = rr.val[0];
+			gLo = gg.val[0];
+			bLo = bb.val[0];
+			rHi = rr.val[1];
+			gHi = gg.val[1];
+			bHi = bb.val[1];
+		} else {
+			const uint8x16_t u = vld1q_u8(uSrc + x);
+			const uint8x16_t v = vld1q_u8(vSrc + x);
+			neon_chromaTerms(neon_widen(vget_low_u8(u)), neon_widen(vget_low_u8(v)), rLo, gLo, bLo);
+			neon_chromaTerms(neon_widen(vget_high_u8(u)), neon_widen(vget_high_u8(v)), rHi, gHi, bHi);
+		}
+
+		neon_putPixels<kBpp, kITU, kAlpha>(dst, neon_widen(vget_low_u8(y)), vmovl_u8(vget_low_u8(a)), rLo, gLo, bLo, format);
+		neon_putPixels<kBpp, kITU, kAlpha>(dst + 8 * kBpp, neon_widen(vget_high_u8(y)), vmovl_u8(vget_high_u8(a)), rHi, gHi, bHi, format);
+	}
+
+	return x;
+}
+
+template<bool kHalfChroma>
+static YUVToRGBRow::RowFunc neon_rowFunc(const YUVToRGBRowFormat &format, bool alpha) {
+	if (format.bytesPerPixel == 2) {
+		if (format.itu)
+			return alpha ? neon_row<kHalfChroma, 2, true, true> : neon_row<kHalfChroma, 2, true, false>;
+		return alpha ? neon_row<kHalfChroma, 2, false, true> : neon_row<kHalfChroma, 2, false, false>;
+	}
+
+	if (format.itu)
+		return alpha ? neon_row<kHalfChroma, 4, true, true> : neon_row<kHalfChroma, 4, true, false>;
+	return alpha ? neon_row<kHalfChroma, 4, false, true> : neon_row<kHalfChroma, 4, false, false>;
+}
+
+int YUVToRGBRow::row444NEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return neon_rowFunc<false>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+int YUVToRGBRow::row422NEON(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return neon_rowFunc<true>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,188 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+/** Shift counts and masks of the output format, ready for the shift instructions. */
+struct SSE2RowFormat {
+	explicit SSE2RowFormat(const YUVToRGBRowFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		aMask16 = _mm_set1_epi16((int16)format.aMask);
+		aMask32 = _mm_set1_epi32(format.aMask);
+	}
+
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	__m128i aMask16, aMask32;
+};
+
+/** Multiply by the sign of a chroma difference, given as a mask. */
+static FORCEINLINE __m128i sse2_applySign(__m128i x, __m128i sign) {
+	return _mm_sub_epi16(_mm_xor_si128(x, sign), sign);
+}
+
+/** Compute what eight pairs of chroma samples add to the luminance of each channel. */
+static FORCEINLINE void sse2_chromaTerms(__m128i u, __m128i v, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i bias = _mm_set1_epi16(128);
+	const __m128i du = _mm_sub_epi16(u, bias);
+	const __m128i dv = _mm_sub_epi16(v, bias);
+	const __m128i su = _mm_srai_epi16(du, 15);
+	const __m128i sv = _mm_srai_epi16(dv, 15);
+	const __m128i au = sse2_applySign(du, su);
+	const __m128i av = sse2_applySign(dv, sv);
+
+	r = sse2_applySign(_mm_add_epi16(av, _mm_mulhi_epu16(av, _mm_set1_epi16((int16)kYUVToRGBCrR))), sv);
+	b = sse2_applySign(_mm_add_epi16(au, _mm_mulhi_epu16(au, _mm_set1_epi16((int16)kYUVToRGBCbB))), su);
+	const __m128i gv = sse2_applySign(_mm_mulhi_epu16(av, _mm_set1_epi16((int16)kYUVToRGBCrG)), sv);
+	const __m128i gu = sse2_applySign(_mm_mulhi_epu16(au, _mm_set1_epi16((int16)kYUVToRGBCbG)), su);
+	g = _mm_sub_epi16(_mm_setzero_si128(), _mm_add_epi16(gv, gu));
+}
+
+/** Clip a channel value to the luminance range and scale it to [0, 255]. */
+template<bool kITU>
+static FORCEINLINE __m128i sse2_clip(__m128i x) {
+	if (kITU) {
+		const __m128i low = _mm_set1_epi16(16);
+		x = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(x, low), _mm_set1_epi16(235)), low);
+		return _mm_add_epi16(x, _mm_mulhi_epu16(x, _mm_set1_epi16(kYUVToRGBITUScale)));
+	}
+
+	return _mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+/** Convert and store eight pixels. */
+template<int kBpp, bool kITU, bool kAlpha>
+static FORCEINLINE void sse2_putPixels(byte *dst, __m128i y, __m128i a, __m128i cr, __m128i cg, __m128i cb, const SSE2RowFormat &format) {
+	const __m128i r = _mm_srl_epi16(sse2_clip<kITU>(_mm_add_epi16(y, cr)), format.rLoss);
+	const __m128i g = _mm_srl_epi16(sse2_clip<kITU>(_mm_add_epi16(y, cg)), format.gLoss);
+	const __m128i b = _mm_srl_epi16(sse2_clip<kITU>(_mm_add_epi16(y, cb)), format.bLoss);
+	if (kAlpha)
+		a = _mm_srl_epi16(a, format.aLoss);
+
+	if (kBpp == 2) {
+		__m128i pixels = _mm_or_si128(_mm_or_si128(_mm_sll_epi16(r, format.rShift), _mm_sll_epi16(g, format.gShift)), _mm_sll_epi16(b, format.bShift));
+		pixels = _mm_or_si128(pixels, kAlpha ? _mm_sll_epi16(a, format.aShift) : format.aMask16);
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else {
+		const __m128i zero = _mm_setzero_si128();
+		__m128i lo = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), format.rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), format.gShift)), _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), format.bShift));
+		__m128i hi = _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), format.rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), format.gShift)), _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), format.bShift));
+		lo = _mm_or_si128(lo, kAlpha ? _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), format.aShift) : format.aMask32);
+		hi = _mm_or_si128(hi, kAlpha ? _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), format.aShift) : format.aMask32);
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 16), hi);
+	}
+}
+
+/** Convert the row in blocks of sixteen pixels. */
+template<bool kHalfChroma, int kBpp, bool kITU, bool kAlpha>
+static int sse2_row(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &rowFormat) {
+	const SSE2RowFormat format(rowFormat);
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16, dst += 16 * kBpp) {
+		const __m128i y = _mm_loadu_si128((const __m128i *)(ySrc + x));
+		const __m128i a = kAlpha ? _mm_loadu_si128((const __m128i *)(aSrc + x)) : zero;
+		__m128i rLo, gLo, bLo, rHi, gHi, bHi;
+
+		if (kHalfChroma) {
+			const __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(uSrc + x / 2)), zero);
+			const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(vSrc + x / 2)), zero);
+			__m128i r, g, b;
+			sse2_chromaTerms(u, v, r, g, b);
+			rLo = _mm_unpacklo_epi16(r, r);
+			gLo = _mm_unpacklo_epi16(g, g);
+			bLo = _mm_unpacklo_epi16(b, b);
+			rHi = _mm_unpackhi_epi16(r, r);
+			gHi = _mm_unpackhi_epi16(g, g);
+			bHi = _mm_unpackhi_epi16(b, b);
+		} else {
+			const __m128i u = _mm_loadu_si128((const __m128i *)(uSrc + x));
+			const __m128i v = _mm_loadu_si128((const __m128i *)(vSrc + x));
+			sse2_chromaTerms(_mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero), rLo, gLo, bLo);
+			sse2_chromaTerms(_mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero), rHi, gHi, bHi);
+		}
+
+		sse2_putPixels<kBpp, kITU, kAlpha>(dst, _mm_unpacklo_epi8(y, zero), _mm_unpacklo_epi8(a, zero), rLo, gLo, bLo, format);
+		sse2_putPixels<kBpp, kITU, kAlpha>(dst + 8 * kBpp, _mm_unpackhi_epi8(y, zero), _mm_unpackhi_epi8(a, zero), rHi, gHi, bHi, format);
+	}
+
+	return x;
+}
+
+template<bool kHalfChroma>
+static YUVToRGBRow::RowFunc sse2_rowFunc(const YUVToRGBRowFormat &format, bool alpha) {
+	if (format.bytesPerPixel == 2) {
+		if (format.itu)
+			return alpha ? sse2_row<kHalfChroma, 2, true, true> : sse2_row<kHalfChroma, 2, true, false>;
+		return alpha ? sse2_row<kHalfChroma, 2, false, true> : sse2_row<kHalfChroma, 2, false, false>;
+	}
+
+	if (format.itu)
+		return alpha ? sse2_row<kHalfChroma, 4, true, true> : sse2_row<kHalfChroma, 4, true, false>;
+	return alpha ? sse2_row<kHalfChroma, 4, false, true> : sse2_row<kHalfChroma, 4, false, false>;
+}
+
+int YUVToRGBRow::row444SSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return sse2_rowFunc<false>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+int YUVToRGBRow::row422SSE2(byte *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, const YUVToRGBRowFormat &format) {
+	return sse2_rowFunc<true>(format, aSrc != nullptr)(dst, ySrc, uSrc, vSrc, aSrc, width, format);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
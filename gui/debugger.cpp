@@ -34,6 +34,7 @@
 #include "common/stream.h"
 #endif
 
+#include "engines/advancedDetector.h"
 #include "engines/engine.h"
 
 #include "gui/debugger.h"
@@ -72,6 +73,7 @@ Debugger::Debugger() {
 #ifndef DISABLE_MD5
 	registerCmd("md5",				WRAP_METHOD(Debugger, cmdMd5));
 	registerCmd("md5mac",			WRAP_METHOD(Debugger, cmdMd5Mac));
+	registerCmd("md5cache",			WRAP_METHOD(Debugger, cmdMd5Cache));
 #endif
 	registerCmd("clear",			WRAP_METHOD(Debugger, cmdClearLog));
 	registerCmd("cls",			WRAP_METHOD(Debugger, cmdClearLog)); // alias
@@ -756,6 +758,17 @@ bool Debugger::cmdMd5Mac(int argc, const char **argv) {
 	}
 	return true;
 }
+
+bool Debugger::cmdMd5Cache(int argc, const char **argv) {
+	const uint hits = ADCacheMan.getPersistentCacheHits();
+	const uint misses = ADCacheMan.getPersistentCacheMisses();
+	const uint lookups = hits + misses;
+
+	debugPrintf("Persistent MD5 cache lookups during detection: %u\n", lookups);
+	if (lookups)
+		debugPrintf("Hits: %u (%.1f%%), misses: %u\n", hits, 100.0 * hits / lookups, misses);
+	return true;
+}
 #endif
 
 bool Debugger::cmdDebugLevel(int argc, const char **argv) {
@@ -74,6 +74,12 @@ public:
 	 */
 	bool isActive() const { return _isActive; }
 
+	/**
+	 * Return true if the debugger has been attached and will activate
+	 * once its frame countdown has passed.
+	 */
+	bool isAttached() const { return _frameCountdown > 0; }
+
 protected:
 	typedef Common::Functor1<const char *, bool> defaultCommand;
 	typedef Common::Functor2<int, const char **, bool> Debuglet;
@@ -270,6 +276,7 @@ protected:
 #ifndef DISABLE_MD5
 	bool cmdMd5(int argc, const char **argv);
 	bool cmdMd5Mac(int argc, const char **argv);
+	bool cmdMd5Cache(int argc, const char **argv);
 #endif
 	bool cmdDebugLevel(int argc, const char **argv);
 	bool cmdDebugFlagsList(int argc, const char **argv);
@@ -23,6 +23,7 @@
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/ptr.h"
 #include "common/system.h"
 #include "common/taskbar.h"
 #include "common/translation.h"
@@ -61,6 +62,8 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	_dirsScanned(0),
 	_oldGamesCount(0),
 	_dirTotal(0),
+	_prehash(false),
+	_scanStartTime(0),
 	_okButton(nullptr),
 	_dirProgressText(nullptr),
 	_gameProgressText(nullptr) {
@@ -68,7 +71,16 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	Common::U32StringArray l;
 
 	// The dir we start our scan at
-	_scanStack.push(startDir);
+	_scanStack.push(new ScanDir(startDir));
+
+	// Keep a couple of directories per worker scanned in advance, if the
+	// backend allows using the file system from several threads
+	if (JobMan.isThreaded() && Common::FSNode::isThreadSafe()) {
+		for (uint i = 0; i < JobMan.getWorkerCount() * 2; i++)
+			_idleGroups.push_back(new Common::JobGroup());
+
+		_prehash = ADCacheMan.preparePrehash();
+	}
 
 	// Removed for now... Why would you put a title on mass add dialog called "Mass Add Dialog"?
 	// new StaticTextWidget(this, "massadddialog_caption", "Mass Add Dialog");
@@ -109,6 +121,39 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	}
 }
 
+MassAddDialog::~MassAddDialog() {
+	while (!_scanStack.empty()) {
+		ScanDir *scanDir = _scanStack.pop();
+		if (scanDir->group)
+			scanDir->group->wait();
+		delete scanDir;
+	}
+
+	for (auto &group : _idleGroups)
+		delete group;
+}
+
+void MassAddDialog::scanDirectory(void *param) {
+	ScanDir *scanDir = (ScanDir *)param;
+	scanDir->listed = scanDir->dir.getChildren(scanDir->files, Common::FSNode::kListAll);
+	if (scanDir->listed && scanDir->prehash)
+		ADCacheMan.prehashFiles(scanDir->files, scanDir->hashedFiles);
+}
+
+void MassAddDialog::queueScans() {
+	// The stack is scanned from the top, so this keeps the order of the
+	// results the same as when scanning each directory on demand.
+	for (uint i = 0; i < _scanStack.size() && !_idleGroups.empty(); i++) {
+		ScanDir *scanDir = _scanStack[_scanStack.size() - 1 - i];
+		if (!scanDir->group) {
+			scanDir->group = _idleGroups.back();
+			_idleGroups.pop_back();
+			scanDir->prehash = _prehash;
+			JobMan.submit(&scanDirectory, scanDir, scanDir->group);
+		}
+	}
+}
+
 struct GameTargetLess {
 	bool operator()(const DetectedGame &x, const DetectedGame &y) const {
 		return x.preferredTarget.compareToIgnoreCase(y.preferredTarget) < 0;
@@ -188,16 +233,34 @@ void MassAddDialog::handleTickle() {
 		return;	// We have finished scanning
 
 	uint32 t = g_system->getMillis();
+	if (!_scanStartTime)
+		_scanStartTime = t;
+
+	queueScans();
 
 	// Perform a breadth-first scan of the filesystem.
 	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
+		Common::ScopedPtr<ScanDir> scanDir(_scanStack.pop());
+
+		if (scanDir->group) {
+			scanDir->group->wait();
+			_idleGroups.push_back(scanDir->group);
+		} else {
+			scanDir->listed = scanDir->dir.getChildren(scanDir->files, Common::FSNode::kListAll);
+		}
 
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+		if (!scanDir->listed) {
 			continue;
 		}
 
+		// The files hashed by the job are found in the persistent cache by
+		// the detectors. They are added here so that the cache is filled in
+		// the order of the scan.
+		ADCacheMan.addPrehashedFiles(scanDir->hashedFiles);
+
+		const Common::FSNode &dir = scanDir->dir;
+		const Common::FSList &files = scanDir->files;
+
 		// Run the detector on the dir
 		DetectionResults detectionResults = EngineMan.detectGames(files, (ADGF_WARNING | ADGF_UNSUPPORTED | ADGF_ADDON), true);
 
@@ -258,7 +321,7 @@ void MassAddDialog::handleTickle() {
 		// Recurse into all subdirs
 		for (const auto &file : files) {
 			if (file.isDirectory()) {
-				_scanStack.push(file);
+				_scanStack.push(new ScanDir(file));
 
 				_dirTotal++;
 			}
@@ -266,6 +329,8 @@ void MassAddDialog::handleTickle() {
 
 		_dirsScanned++;
 
+		queueScans();
+
 #if defined(USE_TASKBAR)
 		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
 		g_system->getTaskbarManager()->setCount(_games.size());
@@ -277,6 +342,9 @@ void MassAddDialog::handleTickle() {
 	Common::U32String buf;
 
 	if (_scanStack.empty()) {
+		// Make sure all MD5s computed during the scan are stored
+		ADCacheMan.savePersistentCache(true);
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
@@ -287,7 +355,11 @@ void MassAddDialog::handleTickle() {
 		_gameProgressText->setLabel(buf);
 
 	} else {
-		buf = Common::U32String::format(_("Scanned %d directories ..."), _dirsScanned);
+		uint32 elapsed = g_system->getMillis() - _scanStartTime;
+		if (elapsed >= 1000)
+			buf = Common::U32String::format(_("Scanned %d directories (%d per second) ..."), _dirsScanned, (int)((uint64)_dirsScanned * 1000 / elapsed));
+		else
+			buf = Common::U32String::format(_("Scanned %d directories ..."), _dirsScanned);
 		_dirProgressText->setLabel(buf);
 
 		buf = Common::U32String::format(_("Discovered %d new games, ignored %d previously added games ..."), _games.size(), _oldGamesCount);
@@ -24,8 +24,10 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
+#include "engines/advancedDetector.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
+#include "common/jobsystem.h"
 #include "common/stack.h"
 #include "common/str.h"
 
@@ -37,6 +39,7 @@ class MassAddListWidget;
 class MassAddDialog : public Dialog {
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -49,11 +52,33 @@ public:
 	}
 
 private:
-	Common::Stack<Common::FSNode>  _scanStack;
+	/**
+	 * A directory waiting to be scanned. When worker threads are available,
+	 * the directories on top of the stack are listed, and the files the
+	 * detectors will hash are hashed, ahead of time. The detectors then run
+	 * on the main thread while the workers walk the file system.
+	 */
+	struct ScanDir {
+		ScanDir(const Common::FSNode &node) : dir(node), group(nullptr), listed(false), prehash(false) {}
+
+		Common::FSNode dir;
+		Common::FSList files;
+		AdvancedDetectorCacheManager::PrehashedFileList hashedFiles;
+		/** Group of the job scanning this directory, or nullptr if it was not queued. */
+		Common::JobGroup *group;
+		bool listed;
+		bool prehash;
+	};
+
+	Common::Stack<ScanDir *>  _scanStack;
 	DetectedGames _games;
 
 	void updateGameList();
 
+	/** Submit scanning jobs for the directories that will be scanned next. */
+	void queueScans();
+	static void scanDirectory(void *param);
+
 	/**
 	 * Map each path occurring in the config file to the target(s) using that path.
 	 * Used to detect whether a potential new target is already present in the
@@ -66,6 +91,11 @@ private:
 	int _oldGamesCount;
 	int _dirTotal;
 
+	/** Groups for the scanning jobs that are not in use, which bounds the jobs in flight. */
+	Common::Array<Common::JobGroup *> _idleGroups;
+	bool _prehash;
+	uint32 _scanStartTime;
+
 	Widget *_okButton;
 	StaticTextWidget *_dirProgressText;
 	StaticTextWidget *_gameProgressText;
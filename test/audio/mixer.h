@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/rate_intern.h"
+
+#include "../system/null_osystem.h"
+
+class TrackedAudioStream : public Audio::AudioStream {
+public:
+	TrackedAudioStream(bool *deleted) : _deleted(deleted) { *_deleted = false; }
+	~TrackedAudioStream() { *_deleted = true; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		memset(buffer, 0, numSamples * sizeof(int16));
+		return numSamples;
+	}
+	bool isStereo() const override { return false; }
+	int getRate() const override { return 22050; }
+	bool endOfData() const override { return false; }
+
+private:
+	bool *_deleted;
+};
+
+class MixerTestSuite : public CxxTest::TestSuite
+{
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		// The null backend does not report CPU features
+		Audio::RateMixer::mixFunc = Audio::RateMixer::mixGeneric;
+
+		_mixer = new Audio::MixerImpl(44100, true, 1024);
+		_mixer->setReady(true);
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		delete _mixer;
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_stop_handle_deletes_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::SoundHandle mixed, queued;
+
+		// One channel is installed by a mix, the other one is still queued
+		play(Audio::Mixer::kSFXSoundType, &mixed, &_deleted, -1, false);
+		mix();
+		play(Audio::Mixer::kSFXSoundType, &queued, &_otherDeleted, -1, false);
+
+		_mixer->stopHandle(mixed);
+		TS_ASSERT(_deleted);
+		TS_ASSERT(!_mixer->isSoundHandleActive(mixed));
+
+		_mixer->stopHandle(queued);
+		TS_ASSERT(_otherDeleted);
+		TS_ASSERT(!_mixer->isSoundHandleActive(queued));
+#endif
+	}
+
+	void test_stop_id_deletes_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		play(Audio::Mixer::kSFXSoundType, nullptr, &_deleted, 7, false);
+		play(Audio::Mixer::kSFXSoundType, nullptr, &_otherDeleted, 8, false);
+
+		_mixer->stopID(7);
+		TS_ASSERT(_deleted);
+		TS_ASSERT(!_otherDeleted);
+		TS_ASSERT(!_mixer->isSoundIDActive(7));
+		TS_ASSERT(_mixer->isSoundIDActive(8));
+
+		// The remaining channel is still mixed
+		mix();
+		TS_ASSERT(!_otherDeleted);
+#endif
+	}
+
+	void test_stop_all_keeps_permanent() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::SoundHandle permanent;
+
+		play(Audio::Mixer::kSFXSoundType, nullptr, &_deleted, -1, false);
+		play(Audio::Mixer::kMusicSoundType, &permanent, &_otherDeleted, -1, true);
+		mix();
+
+		_mixer->stopAll();
+		TS_ASSERT(_deleted);
+		TS_ASSERT(!_otherDeleted);
+		TS_ASSERT(_mixer->isSoundHandleActive(permanent));
+
+		delete _mixer;
+		_mixer = nullptr;
+		TS_ASSERT(_otherDeleted);
+#endif
+	}
+
+	void test_pause_handle_stops_clock() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Audio::SoundHandle handle;
+
+		// Give the channel a time stamp the elapsed time is computed from
+		g_system->delayMillis(5);
+		play(Audio::Mixer::kSFXSoundType, &handle, &_deleted, -1, false);
+		mix();
+
+		// No mix runs between the pause and the queries
+		_mixer->pauseHandle(handle, true);
+		const uint32 paused = _mixer->getSoundElapsedTime(handle);
+		g_system->delayMillis(20);
+		TS_ASSERT_EQUALS(_mixer->getSoundElapsedTime(handle), paused);
+
+		_mixer->pauseHandle(handle, false);
+		g_system->delayMillis(20);
+		TS_ASSERT_LESS_THAN_EQUALS(paused + 20, _mixer->getSoundElapsedTime(handle));
+
+		_mixer->stopHandle(handle);
+		TS_ASSERT(_deleted);
+		TS_ASSERT(!_mixer->isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(_mixer->getSoundElapsedTime(handle), 0U);
+#endif
+	}
+
+private:
+	Audio::MixerImpl *_mixer;
+	// Members rather than locals, since the mixer may outlive the test body
+	bool _deleted, _otherDeleted;
+
+	void play(Audio::Mixer::SoundType type, Audio::SoundHandle *handle, bool *deleted, int id, bool permanent) {
+		_mixer->playStream(type, handle, new TrackedAudioStream(deleted), id, Audio::Mixer::kMaxChannelVolume, 0,
+		                   DisposeAfterUse::YES, permanent, false);
+	}
+
+	void mix() {
+		byte samples[1024 * 4];
+		_mixer->mixCallback(samples, sizeof(samples));
+	}
+};
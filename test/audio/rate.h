@@ -0,0 +1,229 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate_intern.h"
+#include "audio/decoders/raw.h"
+#include "common/config-manager.h"
+#include "common/jobsystem.h"
+
+#include "../system/null_osystem.h"
+
+class RateMixerTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+
+	Audio::st_sample_t nextSample() {
+		_seed = _seed * 1103515245 + 12345;
+		return (Audio::st_sample_t)(_seed >> 16);
+	}
+
+	void checkMixFunc(Audio::RateMixer::MixFunc func) {
+		_seed = 1;
+
+		const uint frames = 1027;
+		Audio::st_sample_t in[frames * 2], expected[frames * 2], result[frames * 2];
+		const Audio::st_volume_t volumes[] = { 0, 1, 77, 255, 256 };
+
+		for (int stereo = 0; stereo < 2; stereo++) {
+		for (int reverse = 0; reverse < 2; reverse++) {
+		for (uint v = 0; v < ARRAYSIZE(volumes); v++) {
+			for (uint i = 0; i < frames * 2; i++) {
+				in[i] = nextSample();
+				// Include values close to the limits to exercise saturation
+				expected[i] = result[i] = i % 3 ? nextSample() : (Audio::st_sample_t)(i & 1 ? 32767 : -32768);
+			}
+
+			Audio::st_volume_t volL = volumes[v];
+			Audio::st_volume_t volR = volumes[ARRAYSIZE(volumes) - 1 - v];
+			Audio::RateMixer::mixGeneric(expected, in, frames, volL, volR, stereo, reverse);
+			func(result, in, frames, volL, volR, stereo, reverse);
+
+			TS_ASSERT_EQUALS(memcmp(expected, result, sizeof(expected)), 0);
+		}
+		}
+		}
+	}
+
+	void checkDotFunc(Audio::RateFilter::DotFunc func) {
+		_seed = 2;
+
+		int16 samples[128], coefs[128];
+		for (uint taps = 8; taps <= ARRAYSIZE(samples); taps += 8) {
+			for (uint i = 0; i < taps; i++) {
+				samples[i] = nextSample();
+				coefs[i] = nextSample() / 4;
+			}
+
+			TS_ASSERT_EQUALS(func(samples, coefs, taps), Audio::RateFilter::dotGeneric(samples, coefs, taps));
+		}
+	}
+
+public:
+	void test_mix_simd() {
+#ifdef SCUMMVM_NEON
+		checkMixFunc(Audio::RateMixer::mixNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkMixFunc(Audio::RateMixer::mixSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkMixFunc(Audio::RateMixer::mixAVX2);
+#endif
+	}
+
+	void test_dot_simd() {
+#ifdef SCUMMVM_NEON
+		checkDotFunc(Audio::RateFilter::dotNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkDotFunc(Audio::RateFilter::dotSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkDotFunc(Audio::RateFilter::dotAVX2);
+#endif
+	}
+
+	void test_sinc_converter() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		ConfMan.setInt("resampling_quality", 2, Common::ConfigManager::kTransientDomain);
+
+		// The null backend does not report CPU features
+		Audio::RateMixer::mixFunc = Audio::RateMixer::mixGeneric;
+		Audio::RateFilter::dotFunc = Audio::RateFilter::dotGeneric;
+
+		const uint inRates[] = { 11025, 22050, 48000, 44100 };
+		const uint outRates[] = { 48000, 44100, 22050, 44101 };
+		const uint inFrames = 4410;
+
+		for (uint r = 0; r < ARRAYSIZE(inRates); r++) {
+			// A constant input comes out unchanged, after the filter settled
+			int16 *data = (int16 *)malloc(inFrames * sizeof(int16));
+			for (uint i = 0; i < inFrames; i++)
+				data[i] = 10000;
+
+			byte flags = Audio::FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+			flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+			Audio::AudioStream *stream = Audio::makeRawStream((const byte *)data, inFrames * sizeof(int16), inRates[r], flags);
+			Audio::RateConverter *converter = Audio::makeRateConverter(inRates[r], outRates[r], false, true, false);
+
+			const uint expectedFrames = (uint)((uint64)inFrames * outRates[r] / inRates[r]);
+			int16 *out = new int16[(expectedFrames + 64) * 2];
+			memset(out, 0, (expectedFrames + 64) * 2 * sizeof(int16));
+
+			uint frames = 0;
+			while (!stream->endOfData() || converter->needsDraining()) {
+				const int n = converter->convert(*stream, out + frames * 2, MIN<uint>(100, expectedFrames + 64 - frames), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				if (n == 0)
+					break;
+				frames += n;
+			}
+
+			TS_ASSERT_LESS_THAN_EQUALS(expectedFrames - 2, frames);
+			TS_ASSERT_LESS_THAN_EQUALS(frames, expectedFrames + 2);
+			for (uint i = frames / 4; i < frames * 3 / 4; i++) {
+				TS_ASSERT_LESS_THAN_EQUALS(ABS(out[i * 2] - 10000), 1);
+				TS_ASSERT_EQUALS(out[i * 2], out[i * 2 + 1]);
+			}
+
+			delete[] out;
+			delete converter;
+			delete stream;
+		}
+
+		ConfMan.removeKey("resampling_quality", Common::ConfigManager::kTransientDomain);
+		Audio::SincFilterManager::destroy();
+		Common::JobSystem::destroy();
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_sinc_filter_bank_selection() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Audio::SincFilterBankSet *set = Audio::SincFilterManager::instance().getFilterBanks(16);
+		TS_ASSERT_EQUALS(Audio::SincFilterManager::instance().getFilterBanks(16), set);
+
+		// Upsampling keeps the full band
+		TS_ASSERT_EQUALS(set->select(1, 1), &set->banks[0]);
+		TS_ASSERT_EQUALS(set->select(147, 320), &set->banks[0]);
+		TS_ASSERT_EQUALS(set->banks[0].taps, 16u);
+
+		// Downsampling uses the highest cutoff below the ratio
+		const uint ratios[][2] = { { 160, 147 }, { 320, 147 }, { 3, 1 }, { 100, 1 } };
+		for (uint r = 0; r < ARRAYSIZE(ratios); r++) {
+			const Audio::SincFilterBank *bank = set->select(ratios[r][0], ratios[r][1]);
+			const uint level = bank - set->banks;
+			TS_ASSERT_LESS_THAN(level, (uint)Audio::SincFilterBankSet::kLevels);
+			if (level + 1 < Audio::SincFilterBankSet::kLevels) {
+				TS_ASSERT_LESS_THAN_EQUALS(set->cutoffs[level] * ratios[r][0], (double)ratios[r][1]);
+				TS_ASSERT(level == 0 || set->cutoffs[level - 1] * ratios[r][0] > ratios[r][1]);
+			}
+			TS_ASSERT_EQUALS(bank->taps % 8, 0u);
+		}
+
+		Audio::SincFilterManager::destroy();
+		Common::JobSystem::destroy();
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_sinc_converter_rate_change() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		ConfMan.setInt("resampling_quality", 1, Common::ConfigManager::kTransientDomain);
+
+		// The null backend does not report CPU features
+		Audio::RateMixer::mixFunc = Audio::RateMixer::mixGeneric;
+		Audio::RateFilter::dotFunc = Audio::RateFilter::dotGeneric;
+
+		const uint inFrames = 44100;
+		int16 *data = (int16 *)malloc(inFrames * sizeof(int16));
+		for (uint i = 0; i < inFrames; i++)
+			data[i] = -5000;
+
+		byte flags = Audio::FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+		flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+		Audio::AudioStream *stream = Audio::makeRawStream((const byte *)data, inFrames * sizeof(int16), 22050, flags);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 44100, false, true, false);
+
+		// A pitch slide through up- and downsampling ratios
+		int16 out[200 * 2];
+		const uint rates[] = { 22050, 30000, 44100, 60000, 88200, 130000, 44100 };
+		for (uint r = 0; r < ARRAYSIZE(rates); r++) {
+			converter->setInputRate(rates[r]);
+			for (uint block = 0; block < 8; block++) {
+				memset(out, 0, sizeof(out));
+				const int n = converter->convert(*stream, out, 200, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				TS_ASSERT_EQUALS(n, 200);
+
+				// Only the first blocks after a change show the transition
+				if (block < 4)
+					continue;
+				for (int i = 0; i < n; i++)
+					TS_ASSERT_LESS_THAN_EQUALS(ABS(out[i * 2] + 5000), 2);
+			}
+		}
+
+		delete converter;
+		delete stream;
+
+		ConfMan.removeKey("resampling_quality", Common::ConfigManager::kTransientDomain);
+		Audio::SincFilterManager::destroy();
+		Common::JobSystem::destroy();
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+class DeflateTestSuite : public CxxTest::TestSuite {
+public:
+	void test_seekable_deflate() {
+#ifdef USE_ZLIB
+		// Compressible data with some variation
+		const uint32 size = 1024 * 1024 + 123;
+		Common::Array<byte> data(size);
+		uint32 seed = 12345;
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (i / 100) % 7 + ((seed >> 24) & 3);
+		}
+
+		// Compress with a gzip header and trailer, which are then skipped
+		// to get raw deflate data
+		Common::MemoryWriteStreamDynamic *memStream = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzStream = Common::wrapCompressedWriteStream(memStream);
+		gzStream->write(data.data(), size);
+		gzStream->finalize();
+		byte *compressed = memStream->getData();
+		uint32 compressedSize = memStream->size();
+		delete gzStream;
+
+		Common::MemoryReadStream *deflated = new Common::MemoryReadStream(compressed + 10, compressedSize - 18);
+		Common::ScopedPtr<Common::SeekableReadStream> stream(Common::wrapSeekableDeflateReadStream(deflated, DisposeAfterUse::YES, size, 64 * 1024));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int64)size);
+
+		// Read everything in odd sized chunks
+		Common::Array<byte> buffer(size);
+		uint32 pos = 0;
+		while (pos < size) {
+			uint32 len = MIN<uint32>(size - pos, 3001);
+			TS_ASSERT_EQUALS(stream->read(&buffer[pos], len), len);
+			pos += len;
+		}
+		TS_ASSERT(memcmp(buffer.data(), data.data(), size) == 0);
+
+		// Jump around, backward and forward
+		const uint32 offsets[] = { 5, 900000, 65536, 65535, 700000, 131072 * 3 + 17, size - 10, 0, 500000 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			byte chunk[10];
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->pos(), (int64)offsets[i]);
+			TS_ASSERT_EQUALS(stream->read(chunk, sizeof(chunk)), sizeof(chunk));
+			TS_ASSERT(memcmp(chunk, &data[offsets[i]], sizeof(chunk)) == 0);
+		}
+
+		stream.reset();
+		free(compressed);
+#endif
+	}
+};
@@ -0,0 +1,169 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/compression/deflate.h"
+#include "common/compression/unzip.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+class UnzipTestSuite : public CxxTest::TestSuite {
+#ifdef USE_ZLIB
+	struct Member {
+		const char *name;
+		uint16 method;
+		Common::Array<byte> data;
+		Common::Array<byte> compressed;
+		uint32 offset;
+	};
+
+	static void fillData(Common::Array<byte> &data, uint32 size, uint32 seed) {
+		// Compressible data with some variation
+		data.resize(size);
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = (i / 100) % 7 + ((seed >> 24) & 3);
+		}
+	}
+
+	static void deflate(Member &member) {
+		// Compress with a gzip header and trailer, which are then skipped
+		// to get raw deflate data
+		Common::MemoryWriteStreamDynamic *memStream = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::WriteStream *gzStream = Common::wrapCompressedWriteStream(memStream);
+		gzStream->write(member.data.data(), member.data.size());
+		gzStream->finalize();
+		member.compressed.resize(memStream->size() - 18);
+		memcpy(member.compressed.data(), memStream->getData() + 10, member.compressed.size());
+		delete gzStream;
+	}
+
+	static void writeFileInfo(Common::WriteStream &out, const Member &member) {
+		Common::CRC32 crc;
+		out.writeUint16LE(20);                  // Version needed
+		out.writeUint16LE(0);                   // Flags
+		out.writeUint16LE(member.method);
+		out.writeUint16LE(0);                   // Time
+		out.writeUint16LE(0);                   // Date
+		out.writeUint32LE(crc.crcFast(member.data.data(), member.data.size()));
+		out.writeUint32LE(member.compressed.size());
+		out.writeUint32LE(member.data.size());
+		out.writeUint16LE(strlen(member.name));
+		out.writeUint16LE(0);                   // Extra field
+	}
+
+	/** Build a ZIP archive of the members in memory. */
+	static Common::SeekableReadStream *createZip(Common::Array<Member> &members) {
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+
+		for (auto &member : members) {
+			member.offset = out.pos();
+			out.writeUint32LE(0x04034b50);
+			writeFileInfo(out, member);
+			out.writeString(member.name);
+			out.write(member.compressed.data(), member.compressed.size());
+		}
+
+		const uint32 centralDirOffset = out.pos();
+		for (const auto &member : members) {
+			out.writeUint32LE(0x02014b50);
+			out.writeUint16LE(20);              // Version made by
+			writeFileInfo(out, member);
+			out.writeUint16LE(0);               // Comment
+			out.writeUint16LE(0);               // Disk number
+			out.writeUint16LE(0);               // Internal attributes
+			out.writeUint32LE(0);               // External attributes
+			out.writeUint32LE(member.offset);
+			out.writeString(member.name);
+		}
+		const uint32 centralDirSize = out.pos() - centralDirOffset;
+
+		out.writeUint32LE(0x06054b50);
+		out.writeUint16LE(0);                   // Disk number
+		out.writeUint16LE(0);                   // Disk of the central directory
+		out.writeUint16LE(members.size());
+		out.writeUint16LE(members.size());
+		out.writeUint32LE(centralDirSize);
+		out.writeUint32LE(centralDirOffset);
+		out.writeUint16LE(0);                   // Comment
+
+		return new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+	}
+
+	static void checkRead(Common::SeekableReadStream &stream, const Common::Array<byte> &data, uint32 offset, uint32 size) {
+		Common::Array<byte> buffer(size);
+		TS_ASSERT(stream.seek(offset));
+		TS_ASSERT_EQUALS(stream.pos(), (int64)offset);
+		TS_ASSERT_EQUALS(stream.read(buffer.data(), size), size);
+		TS_ASSERT(memcmp(buffer.data(), &data[offset], size) == 0);
+	}
+#endif
+
+public:
+	void test_streamed_members() {
+#ifdef USE_ZLIB
+		// Both members are large enough to be streamed, and the deflated one
+		// spans a few checkpoints
+		Common::Array<Member> members(3);
+		members[0].name = "stored.bin";
+		members[0].method = 0;
+		fillData(members[0].data, 300 * 1024 + 7, 1);
+		members[0].compressed = members[0].data;
+		members[1].name = "deflated.bin";
+		members[1].method = 8;
+		fillData(members[1].data, 2560 * 1024 + 77, 2);
+		deflate(members[1]);
+		members[2].name = "small.bin";
+		members[2].method = 8;
+		fillData(members[2].data, 1000, 3);
+		deflate(members[2]);
+
+		Common::Archive *archive = Common::makeZipArchive(createZip(members));
+		TS_ASSERT(archive);
+		if (!archive)
+			return;
+
+		Common::ScopedPtr<Common::SeekableReadStream> small(archive->createReadStreamForMember("small.bin"));
+		TS_ASSERT(small);
+		if (small)
+			checkRead(*small, members[2].data, 0, members[2].data.size());
+
+		Common::ScopedPtr<Common::SeekableReadStream> stored(archive->createReadStreamForMember("stored.bin"));
+		Common::ScopedPtr<Common::SeekableReadStream> deflated(archive->createReadStreamForMember("deflated.bin"));
+		TS_ASSERT(stored);
+		TS_ASSERT(deflated);
+
+		// The members keep the archive data alive
+		delete archive;
+		if (!stored || !deflated)
+			return;
+
+		TS_ASSERT_EQUALS(stored->size(), (int64)members[0].data.size());
+		TS_ASSERT_EQUALS(deflated->size(), (int64)members[1].data.size());
+
+		// Read both members interleaved, as they share the archive stream
+		const uint32 chunk = 4001;
+		Common::Array<byte> buffer(chunk);
+		for (uint32 pos = 0; pos < members[1].data.size(); pos += chunk) {
+			const uint32 len = MIN<uint32>(chunk, members[1].data.size() - pos);
+			TS_ASSERT_EQUALS(deflated->read(buffer.data(), len), len);
+			TS_ASSERT(memcmp(buffer.data(), &members[1].data[pos], len) == 0);
+
+			if (pos < members[0].data.size()) {
+				const uint32 storedLen = MIN<uint32>(chunk, members[0].data.size() - pos);
+				TS_ASSERT_EQUALS(stored->read(buffer.data(), storedLen), storedLen);
+				TS_ASSERT(memcmp(buffer.data(), &members[0].data[pos], storedLen) == 0);
+			}
+		}
+		TS_ASSERT_EQUALS(stored->pos(), stored->size());
+
+		// Jump backward and forward across the checkpoints
+		const uint32 offsets[] = { 5, 2000000, 1048576, 1048575, 1500000, 2621400, 0, 700000, 2097152 + 17 };
+		for (uint i = 0; i < ARRAYSIZE(offsets); i++) {
+			checkRead(*deflated, members[1].data, offsets[i], 100);
+			checkRead(*stored, members[0].data, offsets[i] % (members[0].data.size() - 100), 100);
+		}
+#endif
+	}
+};
@@ -2,6 +2,16 @@
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
 
 class HashMapTestSuite : public CxxTest::TestSuite
 {
@@ -231,4 +241,150 @@ class HashMapTestSuite : public CxxTest::TestSuite
 }
 
 	// TODO: Add test cases for iterators, find, ...
+
+	void test_flat_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT_EQUALS(container.getVal(1), 42);
+		TS_ASSERT_EQUALS(container.getValOrDefault(3, -1), -1);
+		TS_ASSERT_EQUALS(container.size(), 3u);
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("FOO"));
+		TS_ASSERT(!container2.contains("bar"));
+		Common::String val;
+		TS_ASSERT(container2.tryGetVal("Quux", val));
+		TS_ASSERT_EQUALS(val, "blub");
+	}
+
+	void test_flat_iterator_erase() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 100; i++)
+			container[i] = i * 2;
+
+		// Erasing while iterating must visit every element exactly once
+		int visited = 0;
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			TS_ASSERT_EQUALS(i->_value, i->_key * 2);
+			if (i->_key & 1)
+				container.erase(i);
+			visited++;
+		}
+		TS_ASSERT_EQUALS(visited, 100);
+		TS_ASSERT_EQUALS(container.size(), 50u);
+
+		const Common::FlatHashMap<int, int> copy(container);
+		int found = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = copy.begin(); i != copy.end(); ++i) {
+			TS_ASSERT(!(i->_key & 1));
+			found++;
+		}
+		TS_ASSERT_EQUALS(found, 50);
+		TS_ASSERT(copy.find(3) == copy.end());
+		TS_ASSERT(copy.find(4) != copy.end());
+	}
+
+	void test_flat_matches_hashmap() {
+		// Run the same random operations on both maps, including many
+		// colliding keys, and compare the results
+		Common::HashMap<uint, uint> reference;
+		Common::FlatHashMap<uint, uint> flat;
+		uint32 seed = 1;
+
+		for (int i = 0; i < 20000; i++) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = ((seed >> 16) % 1000) * 4096;
+			if (seed & 0x100) {
+				reference[key] = i;
+				flat[key] = i;
+			} else {
+				reference.erase(key);
+				flat.erase(key);
+			}
+
+			TS_ASSERT_EQUALS(reference.size(), flat.size());
+		}
+
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i) {
+			TS_ASSERT(flat.contains(i->_key));
+			TS_ASSERT_EQUALS(flat.getVal(i->_key), i->_value);
+		}
+	}
+
+	template<class Map, class Key>
+	uint32 benchmarkInsert(Map &map, const Common::Array<Key> &keys, int iters) {
+		const uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			map.clear();
+			for (uint i = 0; i < keys.size(); i++)
+				map[keys[i]] = i;
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<class Map, class Key>
+	uint32 benchmarkLookup(const Map &map, const Common::Array<Key> &keys, int iters, uint &sum) {
+		const uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			for (uint i = 0; i < keys.size(); i++)
+				sum += map.getValOrDefault(keys[i], 0);
+		}
+		return g_system->getMillis() - start;
+	}
+
+	void test_flat_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 1;
+#endif
+
+		Common::Array<uint> intKeys;
+		Common::Array<Common::String> stringKeys;
+		for (uint i = 0; i < 10000; i++) {
+			intKeys.push_back(i * 7919);
+			stringKeys.push_back(Common::String::format("resource.%03u/%u", i % 1000, i));
+		}
+
+		uint intSum = 0, flatIntSum = 0, stringSum = 0, flatStringSum = 0;
+
+		Common::HashMap<uint, uint> intMap;
+		Common::FlatHashMap<uint, uint> flatIntMap;
+		const uint32 intInsert = benchmarkInsert(intMap, intKeys, iters);
+		const uint32 flatIntInsert = benchmarkInsert(flatIntMap, intKeys, iters);
+		const uint32 intLookup = benchmarkLookup(intMap, intKeys, iters, intSum);
+		const uint32 flatIntLookup = benchmarkLookup(flatIntMap, intKeys, iters, flatIntSum);
+
+		Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> stringUintMap;
+		Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> flatStringUintMap;
+		const uint32 stringInsert = benchmarkInsert(stringUintMap, stringKeys, iters);
+		const uint32 flatStringInsert = benchmarkInsert(flatStringUintMap, stringKeys, iters);
+		const uint32 stringLookup = benchmarkLookup(stringUintMap, stringKeys, iters, stringSum);
+		const uint32 flatStringLookup = benchmarkLookup(flatStringUintMap, stringKeys, iters, flatStringSum);
+
+		TS_ASSERT_EQUALS(intSum, flatIntSum);
+		TS_ASSERT_EQUALS(stringSum, flatStringSum);
+
+		debug("HashMap<uint> insert/lookup time for %d iters (in milliseconds): %u/%u\n", iters, intInsert, intLookup);
+		debug("FlatHashMap<uint> insert/lookup time for %d iters (in milliseconds): %u/%u\n", iters, flatIntInsert, flatIntLookup);
+		debug("HashMap<String> insert/lookup time for %d iters (in milliseconds): %u/%u\n", iters, stringInsert, stringLookup);
+		debug("FlatHashMap<String> insert/lookup time for %d iters (in milliseconds): %u/%u\n", iters, flatStringInsert, flatStringLookup);
+
+		Common::uninstall_null_g_system();
+#endif
+	}
 };
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/jobsystem.h"
+#include "common/system.h"
+#include "../system/null_osystem.h"
+
+static void incrementJob(void *param) {
+	(*(int *)param)++;
+}
+
+class JobSystemTestSuite : public CxxTest::TestSuite
+{
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::JobSystem::destroy();
+		ConfMan.removeKey("worker_threads", Common::ConfigManager::kApplicationDomain);
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_submit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		int counters[16] = { 0 };
+		Common::JobGroup group;
+		for (int i = 0; i < 16; i++)
+			JobMan.submit(&incrementJob, &counters[i], &group);
+		group.wait();
+
+		TS_ASSERT(group.isDone());
+		for (int i = 0; i < 16; i++)
+			TS_ASSERT_EQUALS(counters[i], 1);
+#endif
+	}
+
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		int rows[100] = { 0 };
+		JobMan.parallelFor(0, 100, 8, [&rows](int first, int last) {
+			for (int y = first; y < last; y++)
+				rows[y] += y;
+		});
+
+		for (int y = 0; y < 100; y++)
+			TS_ASSERT_EQUALS(rows[y], y);
+
+		// Empty ranges must not call the function
+		bool called = false;
+		JobMan.parallelFor(5, 5, 1, [&called](int, int) { called = true; });
+		TS_ASSERT(!called);
+#endif
+	}
+
+	void test_async() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::JobFuture<int> future = JobMan.async<int>([]() { return 6 * 7; });
+		TS_ASSERT(future.isValid());
+		TS_ASSERT_EQUALS(future.get(), 42);
+		TS_ASSERT(future.isReady());
+#endif
+	}
+
+	void test_async_threaded() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ConfMan.setInt("worker_threads", 2, Common::ConfigManager::kApplicationDomain);
+		if (!JobMan.isThreaded())
+			return;
+
+		Common::JobFuture<int> future = JobMan.async<int>([]() { return 6 * 7; });
+		TS_ASSERT_EQUALS(future.get(), 42);
+		TS_ASSERT(future.isReady());
+#endif
+	}
+
+	void test_async_dropped_future() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ConfMan.setInt("worker_threads", 2, Common::ConfigManager::kApplicationDomain);
+		if (!JobMan.isThreaded())
+			return;
+
+		// The future is dropped while a worker runs the job, so the job is
+		// left holding the only reference to the shared state
+		static volatile bool started, released, finished;
+		started = released = finished = false;
+		{
+			Common::JobFuture<int> future = JobMan.async<int>([]() {
+				started = true;
+				while (!released)
+					g_system->delayMillis(1);
+				finished = true;
+				return 1;
+			});
+			while (!started)
+				g_system->delayMillis(1);
+		}
+		released = true;
+
+		// Joins the workers, after running any job that is still queued
+		Common::JobSystem::destroy();
+		TS_ASSERT(finished);
+#endif
+	}
+};
@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/stream.h"
+#include "../system/null_osystem.h"
+
+class MappedReadStreamTestSuite : public CxxTest::TestSuite {
+private:
+	// Large enough to be mapped, and not a multiple of the page size
+	enum { kFileSize = 128 * 1024 + 3 };
+
+	static const char *getFileName() { return "mappedreadstream.tmp"; }
+	static byte getFileByte(uint32 offset) { return (byte)(offset * 7 + (offset >> 8)); }
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::SeekableWriteStream *out = Common::FSNode(getFileName()).createWriteStream();
+		TS_ASSERT(out);
+		if (!out)
+			return;
+		for (uint32 i = 0; i < kFileSize; i++)
+			out->writeByte(getFileByte(i));
+		delete out;
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::remove_test_file(getFileName());
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_read_stream_is_not_mapped() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::SeekableReadStream *stream = Common::FSNode(getFileName()).createReadStream();
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->getView(0, 16), (const byte *)nullptr);
+		delete stream;
+#endif
+	}
+
+	void test_read_and_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::SeekableReadStream *stream = Common::FSNode(getFileName()).createMappedReadStream();
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), kFileSize);
+
+		byte buffer[256];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		for (uint32 i = 0; i < sizeof(buffer); i++)
+			TS_ASSERT_EQUALS(buffer[i], getFileByte(i));
+
+		TS_ASSERT(stream->seek(70000));
+		TS_ASSERT_EQUALS(stream->readByte(), getFileByte(70000));
+		TS_ASSERT(stream->seek(-1, SEEK_END));
+		TS_ASSERT_EQUALS(stream->readByte(), getFileByte(kFileSize - 1));
+		TS_ASSERT(!stream->eos());
+
+		// A short read at the end sets the end-of-stream flag
+		TS_ASSERT(stream->seek(-2, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buffer, 4), 2u);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT_EQUALS(buffer[1], getFileByte(kFileSize - 1));
+
+		// Sub-streams read the same data
+		TS_ASSERT(stream->seek(1000));
+		Common::SeekableReadStream *sub = stream->readStream(300);
+		TS_ASSERT_EQUALS(stream->pos(), 1300);
+		TS_ASSERT_EQUALS(sub->size(), 300);
+		TS_ASSERT(sub->seek(299));
+		TS_ASSERT_EQUALS(sub->readByte(), getFileByte(1299));
+		delete sub;
+
+		delete stream;
+#endif
+	}
+
+	void test_view_bounds() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::SeekableReadStream *stream = Common::FSNode(getFileName()).createMappedReadStream();
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		const byte *view = stream->getView(0, kFileSize);
+		TS_ASSERT(view);
+		if (view) {
+			TS_ASSERT_EQUALS(view[0], getFileByte(0));
+			TS_ASSERT_EQUALS(view[kFileSize - 1], getFileByte(kFileSize - 1));
+			TS_ASSERT_EQUALS(stream->getView(kFileSize - 5, 5), view + kFileSize - 5);
+			TS_ASSERT_EQUALS(stream->getView(kFileSize, 0), view + kFileSize);
+		}
+
+		TS_ASSERT_EQUALS(stream->getView(kFileSize - 5, 6), (const byte *)nullptr);
+		TS_ASSERT_EQUALS(stream->getView(kFileSize + 1, 0), (const byte *)nullptr);
+		TS_ASSERT_EQUALS(stream->getView(-1, 1), (const byte *)nullptr);
+
+		// Views do not move the stream, and sub-streams share the mapping
+		TS_ASSERT_EQUALS(stream->pos(), 0);
+		TS_ASSERT(stream->seek(4096));
+		Common::SeekableReadStream *sub = stream->readStream(100);
+		if (view)
+			TS_ASSERT_EQUALS(sub->getView(0, 100), view + 4096);
+		TS_ASSERT_EQUALS(sub->getView(1, 100), (const byte *)nullptr);
+
+		// The mapping outlives the stream it came from
+		delete stream;
+		TS_ASSERT_EQUALS(sub->readByte(), getFileByte(4096));
+		delete sub;
+#endif
+	}
+
+	void test_file_open_mapped() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		// Files found through SearchMan are mapped through their archive member
+		SearchMan.addDirectory("mappedreadstream", Common::FSNode("."));
+
+		Common::File file;
+		TS_ASSERT(file.openMapped(getFileName()));
+		if (file.isOpen()) {
+			const byte *view = file.getView(0, kFileSize);
+			TS_ASSERT(view);
+			if (view)
+				TS_ASSERT_EQUALS(view[70000], getFileByte(70000));
+			file.close();
+		}
+
+		TS_ASSERT(!file.openMapped("mappedreadstream.missing"));
+		SearchMan.remove("mappedreadstream");
+#endif
+	}
+};
@@ -104,4 +104,20 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_view() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		ms.seek(3);
+		TS_ASSERT_EQUALS(ms.getView(0, 7), contents);
+		TS_ASSERT_EQUALS(ms.getView(2, 3), contents + 2);
+		TS_ASSERT_EQUALS(ms.getView(7, 0), contents + 7);
+		TS_ASSERT_EQUALS(ms.getView(5, 3), (const byte *)nullptr);
+		TS_ASSERT_EQUALS(ms.getView(-1, 1), (const byte *)nullptr);
+
+		// Views do not move the stream
+		TS_ASSERT_EQUALS(ms.pos(), 3);
+		TS_ASSERT_EQUALS(ms.readByte(), 4);
+	}
 };
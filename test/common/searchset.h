@@ -0,0 +1,123 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+/**
+ * An archive holding files whose contents are a single byte.
+ */
+class TestByteArchive : public Common::Archive {
+public:
+	void addFile(const char *name, byte value) {
+		_files[Common::Path(name)] = value;
+	}
+
+	bool hasFile(const Common::Path &path) const override {
+		return _files.contains(path);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		for (const auto &file : _files)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(file._key, *this)));
+		return _files.size();
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return Common::ArchiveMemberPtr();
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		byte *data = (byte *)malloc(1);
+		*data = _files.getVal(path);
+		return new Common::MemoryReadStream(data, 1, DisposeAfterUse::YES);
+	}
+
+private:
+	Common::HashMap<Common::Path, byte, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> _files;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	int readByte(const Common::SearchSet &set, const char *name) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(Common::Path(name));
+		if (!stream)
+			return -1;
+		int value = stream->readByte();
+		delete stream;
+		return value;
+	}
+
+	void fillSet(Common::SearchSet &set) {
+		TestByteArchive *low = new TestByteArchive();
+		low->addFile("common.dat", 1);
+		low->addFile("low.dat", 1);
+		low->addFile("data/file.bin", 1);
+
+		TestByteArchive *high = new TestByteArchive();
+		high->addFile("COMMON.DAT", 2);
+		high->addFile("high.dat", 2);
+
+		TestByteArchive *same = new TestByteArchive();
+		same->addFile("common.dat", 3);
+		same->addFile("high.dat", 3);
+
+		set.add("low", low, -1);
+		set.add("high", high, 1);
+		set.add("same", same, 1);
+	}
+
+	void checkLookups(Common::SearchSet &set) {
+		TS_ASSERT_EQUALS(readByte(set, "common.dat"), 2);
+		TS_ASSERT_EQUALS(readByte(set, "Common.Dat"), 2);
+		TS_ASSERT_EQUALS(readByte(set, "high.dat"), 2);
+		TS_ASSERT_EQUALS(readByte(set, "low.dat"), 1);
+		TS_ASSERT_EQUALS(readByte(set, "DATA/file.bin"), 1);
+		TS_ASSERT_EQUALS(readByte(set, "missing.dat"), -1);
+		TS_ASSERT(set.hasFile("LOW.DAT"));
+		TS_ASSERT(!set.hasFile("missing.dat"));
+		TS_ASSERT(set.getMember("high.dat"));
+
+		// Same priority: insertion order prevails
+		set.remove("high");
+		TS_ASSERT_EQUALS(readByte(set, "common.dat"), 3);
+		TS_ASSERT_EQUALS(readByte(set, "high.dat"), 3);
+
+		set.setPriority("low", 2);
+		TS_ASSERT_EQUALS(readByte(set, "common.dat"), 1);
+		TS_ASSERT_EQUALS(readByte(set, "high.dat"), 3);
+
+		set.remove("same");
+		TS_ASSERT(!set.hasFile("high.dat"));
+	}
+
+public:
+	void test_lookup() {
+		Common::SearchSet set;
+		fillSet(set);
+		checkLookups(set);
+	}
+
+	void test_indexed_lookup() {
+		Common::SearchSet set;
+		set.setIndexed(true);
+		fillSet(set);
+		TS_ASSERT_EQUALS(set.getIndexSize(), 4u);
+		checkLookups(set);
+		TS_ASSERT_EQUALS(set.getIndexSize(), 3u);
+
+		const Common::SearchSet::IndexStats &stats = set.getIndexStats();
+		TS_ASSERT_EQUALS(stats.lookups, stats.hits + stats.misses);
+		TS_ASSERT_EQUALS(stats.misses, 3u);
+	}
+
+	void test_index_enabled_later() {
+		Common::SearchSet set;
+		fillSet(set);
+		set.setIndexed(true);
+		TS_ASSERT_EQUALS(set.getIndexSize(), 4u);
+		checkLookups(set);
+	}
+};
@@ -70,4 +70,15 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_view() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::SeekableSubReadStream ssrs(&ms, 1, 9);
+
+		TS_ASSERT_EQUALS(ssrs.getView(0, 8), contents + 1);
+		TS_ASSERT_EQUALS(ssrs.getView(4, 2), contents + 5);
+		TS_ASSERT_EQUALS(ssrs.getView(4, 5), (const byte *)nullptr);
+	}
 };
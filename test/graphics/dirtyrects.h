@@ -0,0 +1,225 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/dirtyrects.h"
+
+class DirtyRectListTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 200;
+	static const int kHeight = 120;
+
+	/** Count how many of the rects cover each pixel. */
+	static void rasterize(const Graphics::DirtyRectList &list, Common::Array<int> &coverage) {
+		coverage.resize(kWidth * kHeight);
+		for (uint i = 0; i < coverage.size(); i++)
+			coverage[i] = 0;
+		for (Graphics::DirtyRectList::const_iterator r = list.begin(); r != list.end(); ++r) {
+			for (int y = r->top; y < r->bottom; y++)
+				for (int x = r->left; x < r->right; x++)
+					coverage[y * kWidth + x]++;
+		}
+	}
+
+	static uint count(const Graphics::DirtyRectList &list) {
+		uint n = 0;
+		for (Graphics::DirtyRectList::const_iterator r = list.begin(); r != list.end(); ++r)
+			n++;
+		return n;
+	}
+
+	static bool contains(const Graphics::DirtyRectList &list, const Common::Rect &rect) {
+		for (Graphics::DirtyRectList::const_iterator r = list.begin(); r != list.end(); ++r) {
+			if (*r == rect)
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Merge the rects, and check that the result covers every dirty pixel
+	 * once, and otherwise only pixels of tiles holding dirty pixels.
+	 */
+	static void checkTileMerge(Graphics::DirtyRectList &list, const Common::Array<Common::Rect> &rects) {
+		const int tileShift = Graphics::DirtyRectList::kTileShift;
+		Common::Rect bounds = rects[0];
+		for (uint i = 0; i < rects.size(); i++) {
+			bounds.extend(rects[i]);
+			list.push_back(rects[i]);
+		}
+		list.merge();
+		TS_ASSERT_EQUALS(list.size(), count(list));
+
+		Common::Array<bool> dirty(kWidth * kHeight, false), dirtyTiles(kWidth * kHeight, false);
+		for (uint i = 0; i < rects.size(); i++) {
+			for (int y = rects[i].top; y < rects[i].bottom; y++) {
+				for (int x = rects[i].left; x < rects[i].right; x++) {
+					dirty[y * kWidth + x] = true;
+					dirtyTiles[((y - bounds.top) >> tileShift) * kWidth + ((x - bounds.left) >> tileShift)] = true;
+				}
+			}
+		}
+
+		Common::Array<int> coverage;
+		rasterize(list, coverage);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				const int covered = coverage[y * kWidth + x];
+				if (dirty[y * kWidth + x]) {
+					TS_ASSERT_EQUALS(covered, 1);
+				} else if (covered) {
+					TS_ASSERT(bounds.contains(x, y));
+					TS_ASSERT(dirtyTiles[((y - bounds.top) >> tileShift) * kWidth + ((x - bounds.left) >> tileShift)]);
+				}
+				TS_ASSERT_LESS_THAN_EQUALS(covered, 1);
+			}
+		}
+	}
+
+public:
+	void test_merge_pairs() {
+		Graphics::DirtyRectList list;
+		list.push_back(Common::Rect(0, 0, 10, 10));
+		list.push_back(Common::Rect(5, 5, 20, 20));
+		list.push_back(Common::Rect(50, 50, 60, 60));
+		list.merge();
+
+		TS_ASSERT_EQUALS(list.size(), 2u);
+		TS_ASSERT_EQUALS(count(list), 2u);
+		TS_ASSERT(*list.begin() == Common::Rect(0, 0, 20, 20));
+	}
+
+	void test_merge_tiles() {
+		const int tileSize = 1 << Graphics::DirtyRectList::kTileShift;
+		Graphics::DirtyRectList list;
+		Common::Array<Common::Rect> rects;
+		uint32 seed = 1;
+
+		for (int i = 0; i < 300; i++) {
+			seed = seed * 1103515245 + 12345;
+			const int x = 10 + (seed >> 8) % (kWidth - 30);
+			const int y = 10 + (seed >> 16) % (kHeight - 30);
+			const int w = 1 + (seed >> 24) % 13;
+			const int h = 1 + (seed >> 4) % 9;
+			rects.push_back(Common::Rect(x, y, x + w, y + h));
+			list.push_back(rects.back());
+		}
+		list.merge();
+
+		TS_ASSERT_EQUALS(list.size(), count(list));
+		TS_ASSERT_LESS_THAN(list.size(), rects.size() / 2);
+
+		Common::Array<int> coverage;
+		rasterize(list, coverage);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				bool dirty = false, nearDirty = false;
+				for (uint i = 0; i < rects.size(); i++) {
+					const Common::Rect &r = rects[i];
+					dirty |= r.contains(x, y);
+					nearDirty |= x >= r.left - tileSize && x < r.right + tileSize &&
+					             y >= r.top - tileSize && y < r.bottom + tileSize;
+				}
+
+				// Everything dirty is covered once, and nothing far from
+				// the dirty areas is
+				if (dirty) {
+					TS_ASSERT_EQUALS(coverage[y * kWidth + x], 1);
+				} else if (!nearDirty) {
+					TS_ASSERT_EQUALS(coverage[y * kWidth + x], 0);
+				}
+				TS_ASSERT_LESS_THAN_EQUALS(coverage[y * kWidth + x], 1);
+			}
+		}
+	}
+
+	void test_merge_tiles_joins_rows() {
+		Graphics::DirtyRectList list;
+		for (int y = 0; y < 64; y += 2)
+			for (int x = 0; x < 64; x += 4)
+				list.push_back(Common::Rect(x + 3, y + 5, x + 6, y + 7));
+		list.merge();
+
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT(*list.begin() == Common::Rect(3, 5, 66, 69));
+	}
+
+	void test_merge_pairs_keeps_adjacent() {
+		// Rects sharing an edge do not intersect
+		Graphics::DirtyRectList list;
+		list.push_back(Common::Rect(0, 0, 8, 8));
+		list.push_back(Common::Rect(8, 0, 16, 8));
+		list.push_back(Common::Rect(0, 8, 8, 16));
+		list.merge();
+
+		TS_ASSERT_EQUALS(list.size(), 3u);
+	}
+
+	void test_merge_tiles_overlap_at_tile_edges() {
+		const int tileSize = 1 << Graphics::DirtyRectList::kTileShift;
+		const int left = 4, top = 6;
+		Graphics::DirtyRectList list;
+		Common::Array<Common::Rect> rects;
+
+		// Pairs of overlapping rects around tile corners, each pair in its
+		// own block of 2x2 tiles. The first rect starts the tiles.
+		rects.push_back(Common::Rect(left, top, left + 1, top + 1));
+		for (int k = 0; k < 8; k++) {
+			const int x = left + tileSize + 3 * tileSize * k;
+			const int y = top + tileSize * (k % 3 + 1);
+			rects.push_back(Common::Rect(x - 3, y - 2, x + 2, y + 3));
+			rects.push_back(Common::Rect(x - 1, y - 4, x + 4, y + 1));
+		}
+		checkTileMerge(list, rects);
+
+		TS_ASSERT_EQUALS(list.size(), 8u);
+		for (int k = 0; k < 8; k++) {
+			const int x = left + 3 * tileSize * k;
+			const int y = top + tileSize * (k % 3);
+			// The tiles of the last rows and columns are clipped to the rects
+			const int right = MIN(x + 2 * tileSize, left + tileSize + 3 * tileSize * 7 + 4);
+			const int bottom = MIN(y + 2 * tileSize, top + tileSize * 3 + 3);
+			TS_ASSERT(contains(list, Common::Rect(x, y, right, bottom)));
+		}
+	}
+
+	void test_merge_tiles_adjacent_at_tile_edges() {
+		const int tileSize = 1 << Graphics::DirtyRectList::kTileShift;
+		const int left = 5, top = 3;
+		Graphics::DirtyRectList list;
+		Common::Array<Common::Rect> rects;
+
+		// Whole tiles sharing their edges are joined into one rect
+		for (int y = 0; y < 2; y++) {
+			for (int x = 0; x < 8; x++) {
+				rects.push_back(Common::Rect(left + x * tileSize, top + y * tileSize,
+				                             left + (x + 1) * tileSize, top + (y + 1) * tileSize));
+			}
+		}
+		checkTileMerge(list, rects);
+
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT(*list.begin() == Common::Rect(left, top, left + 8 * tileSize, top + 2 * tileSize));
+	}
+
+	void test_merge_tiles_keeps_tile_gaps() {
+		const int tileSize = 1 << Graphics::DirtyRectList::kTileShift;
+		const int left = 2, top = 9;
+		Graphics::DirtyRectList list;
+		Common::Array<Common::Rect> rects;
+
+		// Whole tiles one tile apart stay as they are, and the rects ending
+		// one pixel short of the next tile do not reach into it
+		for (int x = 0; x < 8; x++) {
+			rects.push_back(Common::Rect(left + 2 * x * tileSize, top,
+			                             left + (2 * x + 1) * tileSize, top + tileSize));
+			rects.push_back(Common::Rect(left + 2 * x * tileSize, top + 2 * tileSize,
+			                             left + (2 * x + 1) * tileSize - 1, top + 3 * tileSize - 1));
+		}
+		checkTileMerge(list, rects);
+
+		TS_ASSERT_EQUALS(list.size(), 16u);
+		for (int x = 0; x < 8; x++) {
+			TS_ASSERT(contains(list, Common::Rect(left + 2 * x * tileSize, top,
+			                                      left + (2 * x + 1) * tileSize, top + tileSize)));
+		}
+	}
+};
@@ -0,0 +1,154 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/array.h"
+#include "common/crc.h"
+#include "graphics/scaler/hq.h"
+#include "graphics/scaler/hq_intern.h"
+#include "graphics/scaler/intern.h"
+
+class HQScalerTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 61;
+	static const int kHeight = 37;
+
+	Common::Array<byte> _src;
+	Common::Array<byte> _dst;
+
+	/**
+	 * Draw checkered flat blocks and noisy gradients, crossed by two white
+	 * diagonals, with a border of one pixel around the image.
+	 */
+	void fillSource(const Graphics::PixelFormat &format) {
+		const int bpp = format.bytesPerPixel;
+		const int pitch = (kWidth + 2) * bpp;
+		uint32 seed = 1;
+
+		_src.resize((kHeight + 2) * pitch);
+		for (int y = -1; y <= kHeight; y++) {
+			for (int x = -1; x <= kWidth; x++) {
+				seed = seed * 1103515245 + 12345;
+				const int blockX = (x + 8) / 8;
+				const int blockY = (y + 8) / 8;
+				int r, g, b;
+				if (((blockX + blockY) & 1) == 0) {
+					const int c = blockX * 7 + blockY * 3;
+					r = (c * 53) & 0xFF;
+					g = (c * 97) & 0xFF;
+					b = (c * 31) & 0xFF;
+				} else {
+					r = 96 + ((seed >> 16) & 0x3F);
+					g = (x * 4) & 0xFF;
+					b = (y * 6 + ((seed >> 24) & 0x0F)) & 0xFF;
+				}
+				if (x == y || x == kWidth - y)
+					r = g = b = 255;
+
+				byte *pixel = &_src[(y + 1) * pitch + (x + 1) * bpp];
+				if (bpp == 2)
+					*(uint16 *)pixel = format.RGBToColor(r, g, b);
+				else
+					*(uint32 *)pixel = format.RGBToColor(r, g, b);
+			}
+		}
+	}
+
+	uint32 scale(const Graphics::PixelFormat &format, uint factor) {
+		const int bpp = format.bytesPerPixel;
+		const int srcPitch = (kWidth + 2) * bpp;
+		const int dstPitch = kWidth * factor * bpp;
+
+		_dst.resize(kHeight * factor * dstPitch);
+		HQScaler scaler(format);
+		scaler.setFactor(factor);
+		scaler.scale(&_src[srcPitch + bpp], srcPitch, _dst.data(), dstPitch, kWidth, kHeight, 0, 0);
+
+		Common::CRC32 crc;
+		return crc.crcFast(_dst.data(), _dst.size());
+	}
+
+	void checkGoldenImages(HQPatterns::RowFunc rowFunc) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat::createFormatARGB32(),
+			Graphics::PixelFormat::createFormatRGBA32()
+		};
+		// CRC32 of the output of the scalers before they had SIMD kernels,
+		// for each format at 2x and 3x
+		const uint32 expected[][2] = {
+			{ 0x5d6a759c, 0x733ae67d },
+			{ 0x1ad6e265, 0xa370325c },
+			{ 0x2ea759a5, 0x26c2c146 },
+			{ 0x039a0c1a, 0x5f17f1ae }
+		};
+
+		// The null backend does not report CPU features, so never select
+		HQPatterns::rowFunc = rowFunc;
+		HQPatterns::selected = true;
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+			fillSource(formats[f]);
+			TS_ASSERT_EQUALS(scale(formats[f], 2), expected[f][0]);
+			TS_ASSERT_EQUALS(scale(formats[f], 3), expected[f][1]);
+		}
+
+		HQPatterns::selected = false;
+	}
+
+	/** Compare a kernel with diffYUV on values around the thresholds. */
+	void checkPatterns(HQPatterns::RowFunc rowFunc) {
+		const int width = 45;
+		Common::Array<uint32> yuv(3 * (width + 2));
+		uint32 seed = 7;
+		for (uint i = 0; i < yuv.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			const int y = 80 + ((seed >> 8) & 0x7F);
+			const int u = 120 + ((seed >> 16) & 0x0F);
+			const int v = 120 + ((seed >> 24) & 0x0F);
+			yuv[i] = (y << 16) | (u << 8) | v;
+		}
+
+		const uint32 *above = &yuv[1];
+		const uint32 *row = above + width + 2;
+		const uint32 *below = row + width + 2;
+		const uint32 *neighbours[] = {
+			above - 1, above, above + 1, row - 1, row + 1, below - 1, below, below + 1
+		};
+
+		uint8 patterns[width];
+		const int count = rowFunc(patterns, above, row, below, width);
+		TS_ASSERT_LESS_THAN(width - 16, count);
+		for (int x = 0; x < count; x++) {
+			int pattern = 0;
+			for (int n = 0; n < 8; n++) {
+				if (diffYUV(row[x], neighbours[n][x]))
+					pattern |= 1 << n;
+			}
+			TS_ASSERT_EQUALS(patterns[x], pattern);
+		}
+	}
+
+public:
+	void test_golden_images() {
+		checkGoldenImages(nullptr);
+	}
+
+	void test_simd_kernels() {
+#ifdef SCUMMVM_NEON
+		checkPatterns(HQPatterns::rowNEON);
+		checkGoldenImages(HQPatterns::rowNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			checkPatterns(HQPatterns::rowSSE2);
+			checkGoldenImages(HQPatterns::rowSSE2);
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			checkPatterns(HQPatterns::rowAVX2);
+			checkGoldenImages(HQPatterns::rowAVX2);
+		}
+#endif
+	}
+};
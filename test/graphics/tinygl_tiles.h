@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "common/array.h"
+#include "common/jobsystem.h"
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zgl.h"
+
+#include "../system/null_osystem.h"
+
+// renders the same frames with and without the tiled rasterization,
+// which must give exactly the same pixels
+
+class TinyGLTilesTestSuite : public CxxTest::TestSuite {
+	// not a multiple of the tile size, so that there are partial tiles
+	static const int kWidth = 300;
+	static const int kHeight = 200;
+
+	uint32 _seed;
+
+	float nextFloat() {
+		_seed = _seed * 1103515245 + 12345;
+		return ((_seed >> 8) & 0xffff) / 65535.0f;
+	}
+
+	float nextCoord() {
+		// a bit beyond the viewport, so that some primitives are clipped
+		return nextFloat() * 2.4f - 1.2f;
+	}
+
+	void randomVertex() {
+		tglColor4f(nextFloat(), nextFloat(), nextFloat(), nextFloat());
+		tglTexCoord2f(nextFloat(), nextFloat());
+		tglVertex3f(nextCoord(), nextCoord(), nextCoord());
+	}
+
+	void drawPrimitive(TGLenum mode, int vertexCount) {
+		tglBegin(mode);
+		for (int i = 0; i < vertexCount; i++)
+			randomVertex();
+		tglEnd();
+	}
+
+	void drawFrame(uint32 seed, TGLuint texture) {
+		_seed = seed;
+
+		tglClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		tglClearDepth(1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglEnable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_SMOOTH);
+		drawPrimitive(TGL_TRIANGLES, 30);
+		drawPrimitive(TGL_TRIANGLE_STRIP, 8);
+		drawPrimitive(TGL_TRIANGLE_FAN, 7);
+		drawPrimitive(TGL_QUADS, 8);
+		drawPrimitive(TGL_QUAD_STRIP, 8);
+		drawPrimitive(TGL_POLYGON, 6);
+
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglShadeModel(TGL_FLAT);
+		drawPrimitive(TGL_TRIANGLES, 15);
+		drawPrimitive(TGL_LINES, 20);
+		drawPrimitive(TGL_LINE_LOOP, 5);
+		drawPrimitive(TGL_POINTS, 50);
+
+		// a clear between rasterizations
+		tglEnable(TGL_SCISSOR_TEST);
+		tglScissor(40, 30, 150, 100);
+		tglClear(TGL_DEPTH_BUFFER_BIT);
+		drawPrimitive(TGL_TRIANGLES, 9);
+		tglDisable(TGL_SCISSOR_TEST);
+
+		tglEnable(TGL_TEXTURE_2D);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglPolygonMode(TGL_FRONT_AND_BACK, TGL_LINE);
+		drawPrimitive(TGL_QUADS, 8);
+		tglPolygonMode(TGL_FRONT_AND_BACK, TGL_FILL);
+		drawPrimitive(TGL_TRIANGLE_STRIP, 10);
+
+		tglDisable(TGL_TEXTURE_2D);
+		tglDisable(TGL_BLEND);
+	}
+
+	void renderFrames(bool dirtyRects, bool tiles, const uint32 *seeds, int frameCount, Common::Array<byte> &pixels) {
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, Graphics::PixelFormat::createFormatARGB32(), 256, false, dirtyRects);
+		TinyGL::setContext(context);
+		TinyGL::gl_get_context()->_tiledRasterizationEnabled = tiles;
+
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		byte texData[16 * 16 * 4];
+		for (uint i = 0; i < ARRAYSIZE(texData); i++)
+			texData[i] = (byte)(i * 37);
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_S, TGL_REPEAT);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_T, TGL_REPEAT);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, 16, 16, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texData);
+
+		pixels.clear();
+		for (int i = 0; i < frameCount; i++) {
+			drawFrame(seeds[i], texture);
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			const uint rowSize = surface.w * surface.format.bytesPerPixel;
+			for (int y = 0; y < surface.h; y++) {
+				const uint offset = pixels.size();
+				pixels.resize(offset + rowSize);
+				memcpy(&pixels[offset], surface.getBasePtr(0, y), rowSize);
+			}
+		}
+
+		TinyGL::destroyContext(context);
+	}
+
+	void checkTiles(bool dirtyRects) {
+		// the repeated seed leaves parts of the frame unchanged
+		const uint32 seeds[] = { 1, 2, 2, 3 };
+		Common::Array<byte> expected, result;
+		renderFrames(dirtyRects, false, seeds, ARRAYSIZE(seeds), expected);
+		renderFrames(dirtyRects, true, seeds, ARRAYSIZE(seeds), result);
+
+		TS_ASSERT_EQUALS(expected.size(), result.size());
+		if (expected.size() == result.size()) {
+			TS_ASSERT_EQUALS(memcmp(expected.data(), result.data(), expected.size()), 0);
+		}
+	}
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::JobSystem::destroy();
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void testTilesMatchSerial() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkTiles(false);
+#endif
+	}
+
+	void testTilesMatchSerialDirtyRects() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		checkTiles(true);
+#endif
+	}
+};
+
+#endif
@@ -40,6 +40,7 @@
 #include "common/rect.h"
 #include "common/textconsole.h"
 #include "graphics/blit.h"
+#include "graphics/blit/blit-fast.h"
 #include "graphics/primitives.h"
 #include "graphics/transform_tools.h"
 
@@ -1024,3 +1025,179 @@ public:
 #endif
 	}
 };
+
+class FastBlitConvertTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 83;
+	static const int kHeight = 7;
+
+	const Graphics::PixelFormat *formats(uint &count) {
+		static const Graphics::PixelFormat list[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11,  5,  0,  0), // RGB565
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10,  5,  0,  0), // XRGB1555
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10,  5,  0, 15), // ARGB1555
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12,  8,  4,  0), // RGBA4444
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16,  8,  0,  0), // XRGB8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16,  8,  0, 24), // ARGB8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8,  0,  8, 16, 24), // ABGR8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16,  8,  0), // RGBA8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8,  8, 16, 24,  0)  // BGRA8888
+		};
+		count = ARRAYSIZE(list);
+		return list;
+	}
+
+	void fillRandom(byte *pixels, uint size) {
+		uint32 seed = 1;
+		for (uint i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			pixels[i] = seed >> 24;
+		}
+	}
+
+	/** The conversion of the generic crossBlit() path. */
+	void convertReference(byte *dst, const byte *src, uint dstPitch, uint srcPitch, uint w, uint h,
+	                      const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		for (uint y = 0; y < h; y++) {
+			for (uint x = 0; x < w; x++) {
+				const byte *in = src + y * srcPitch + x * srcFmt.bytesPerPixel;
+				byte *out = dst + y * dstPitch + x * dstFmt.bytesPerPixel;
+				const uint32 color = (srcFmt.bytesPerPixel == 2) ? *(const uint16 *)in : *(const uint32 *)in;
+
+				byte a, r, g, b;
+				srcFmt.colorToARGB(color, a, r, g, b);
+				if (dstFmt.bytesPerPixel == 2)
+					*(uint16 *)out = dstFmt.ARGBToColor(a, r, g, b);
+				else
+					*(uint32 *)out = dstFmt.ARGBToColor(a, r, g, b);
+			}
+		}
+	}
+
+	/** Check all the conversions of a lookup against the generic path, returning how many there are. */
+	int checkLookup(Graphics::FastBlitConvert::LookupFunc lookup, const char *name) {
+		uint count;
+		const Graphics::PixelFormat *list = formats(count);
+		int found = 0;
+
+		for (uint s = 0; s < count; s++) {
+		for (uint d = 0; d < count; d++) {
+			Graphics::FastBlitFunc func = lookup(list[d], list[s]);
+			if (!func)
+				continue;
+			found++;
+
+			// Padding in the pitches, which must not be written
+			const uint srcPitch = (kWidth + 3) * list[s].bytesPerPixel;
+			const uint dstPitch = (kWidth + 5) * list[d].bytesPerPixel;
+			Common::Array<byte> src(srcPitch * kHeight), expected(dstPitch * kHeight), result(dstPitch * kHeight);
+			fillRandom(src.data(), src.size());
+			fillRandom(expected.data(), expected.size());
+			fillRandom(result.data(), result.size());
+
+			convertReference(expected.data(), src.data(), dstPitch, srcPitch, kWidth, kHeight, list[d], list[s]);
+			func(result.data(), src.data(), dstPitch, srcPitch, kWidth, kHeight);
+			if (memcmp(expected.data(), result.data(), result.size()) != 0) {
+				TS_FAIL(Common::String::format("%s conversion from %s to %s differs from crossBlit()",
+				        name, list[s].toString().c_str(), list[d].toString().c_str()).c_str());
+			}
+
+			// In place, with pitches in the ratio of the pixel sizes
+			const uint inPlacePitch = (kWidth + 3) * list[d].bytesPerPixel;
+			Common::Array<byte> inPlace(MAX(srcPitch, inPlacePitch) * kHeight);
+			memcpy(inPlace.data(), src.data(), src.size());
+			func(inPlace.data(), inPlace.data(), inPlacePitch, srcPitch, kWidth, kHeight);
+			for (uint y = 0; y < kHeight; y++) {
+				if (memcmp(inPlace.data() + y * inPlacePitch, expected.data() + y * dstPitch, kWidth * list[d].bytesPerPixel) != 0) {
+					TS_FAIL(Common::String::format("%s conversion from %s to %s fails in place",
+					        name, list[s].toString().c_str(), list[d].toString().c_str()).c_str());
+					break;
+				}
+			}
+		}
+		}
+
+		return found;
+	}
+
+public:
+	void test_conversions_match_crossBlit() {
+		TS_ASSERT_LESS_THAN_EQUALS(25, checkLookup(Graphics::FastBlitConvert::lookupGeneric, "Generic"));
+#ifdef SCUMMVM_NEON
+		TS_ASSERT_LESS_THAN_EQUALS(25, checkLookup(Graphics::FastBlitConvert::lookupNEON, "NEON"));
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			TS_ASSERT_LESS_THAN_EQUALS(25, checkLookup(Graphics::FastBlitConvert::lookupSSE2, "SSE2"));
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			TS_ASSERT_LESS_THAN_EQUALS(25, checkLookup(Graphics::FastBlitConvert::lookupAVX2, "AVX2"));
+		}
+#endif
+	}
+
+	void test_conversion_speed() {
+#if BENCHMARK_TIME
+		Graphics::FastBlitConvert::LookupFunc simd = nullptr;
+#ifdef SCUMMVM_NEON
+		simd = Graphics::FastBlitConvert::lookupNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			simd = Graphics::FastBlitConvert::lookupSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			simd = Graphics::FastBlitConvert::lookupAVX2;
+#endif
+
+		Common::install_null_g_system();
+
+		const uint width = 640, height = 480;
+#ifdef SLOW_TESTS
+		const int iters = 100;
+#else
+		const int iters = 1;
+#endif
+		uint count;
+		const Graphics::PixelFormat *list = formats(count);
+		Common::Array<byte> src(width * height * 4), dst(width * height * 4);
+		fillRandom(src.data(), src.size());
+
+		for (uint s = 0; s < count; s++) {
+		for (uint d = 0; d < count; d++) {
+			Graphics::FastBlitFunc generic = Graphics::FastBlitConvert::lookupGeneric(list[d], list[s]);
+			if (!generic)
+				continue;
+			Graphics::FastBlitFunc vector = simd ? simd(list[d], list[s]) : nullptr;
+			const uint srcPitch = width * list[s].bytesPerPixel;
+			const uint dstPitch = width * list[d].bytesPerPixel;
+
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++)
+				convertReference(dst.data(), src.data(), dstPitch, srcPitch, width, height, list[d], list[s]);
+			const uint32 referenceTime = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int i = 0; i < iters; i++)
+				generic(dst.data(), src.data(), dstPitch, srcPitch, width, height);
+			const uint32 genericTime = g_system->getMillis() - start;
+
+			uint32 vectorTime = 0;
+			if (vector) {
+				start = g_system->getMillis();
+				for (int i = 0; i < iters; i++)
+					vector(dst.data(), src.data(), dstPitch, srcPitch, width, height);
+				vectorTime = g_system->getMillis() - start;
+			}
+
+			debug("%s to %s, %d frames of %dx%d: runtime format %d ms, specialized %d ms, SIMD %d ms",
+			      list[s].toString().c_str(), list[d].toString().c_str(), iters, width, height, referenceTime, genericTime, vectorTime);
+		}
+		}
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
@@ -0,0 +1,214 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../system/null_osystem.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		k444,
+		k422,
+		k420,
+		k420Alpha,
+		k410,
+		kSubsamplingCount
+	};
+
+	static const int kWidth = 300;
+	// Leaves a partial group of pixels in 410
+	static const int kOddWidth = 83;
+	static const int kHeight = 12;
+
+	uint32 _seed;
+	Common::Array<byte> _y, _u, _v, _a;
+
+	void fillPlanes(int width, int height) {
+		_seed = 1;
+		// 410 chroma reads one column and one row past the image
+		const int uvSize = (width + 1) * (height + 1);
+		_y.resize(width * height);
+		_a.resize(width * height);
+		_u.resize(uvSize);
+		_v.resize(uvSize);
+		for (uint i = 0; i < _y.size(); i++) {
+			_y[i] = nextByte();
+			_a[i] = nextByte();
+		}
+		for (uint i = 0; i < _u.size(); i++) {
+			_u[i] = nextByte();
+			_v[i] = nextByte();
+		}
+
+		// Cover the extremes of the luminance ranges
+		for (int i = 0; i < 32; i++) {
+			_y[i] = i < 16 ? 0 : 255;
+			_y[width + i] = i < 16 ? 16 : 235;
+		}
+	}
+
+	byte nextByte() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 24;
+	}
+
+	void convert(Graphics::Surface &dst, Graphics::YUVToRGBManager::LuminanceScale scale, Subsampling subsampling, int width, int height) {
+		switch (subsampling) {
+		case k444:
+			YUVToRGBMan.convert444(&dst, scale, _y.data(), _u.data(), _v.data(), width, height, width, width + 1);
+			break;
+		case k422:
+			YUVToRGBMan.convert422(&dst, scale, _y.data(), _u.data(), _v.data(), width, height, width, width + 1);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&dst, scale, _y.data(), _u.data(), _v.data(), width, height, width, width + 1);
+			break;
+		case k420Alpha:
+			YUVToRGBMan.convert420Alpha(&dst, scale, _y.data(), _u.data(), _v.data(), _a.data(), width, height, width, width + 1);
+			break;
+		case k410:
+			YUVToRGBMan.convert410(&dst, scale, _y.data(), _u.data(), _v.data(), width, height, width, width + 1);
+			break;
+		default:
+			break;
+		}
+	}
+
+	void setRowFuncs(Graphics::YUVToRGBRow::RowFunc row444, Graphics::YUVToRGBRow::RowFunc row422) {
+		// The null backend does not report CPU features, so never select
+		Graphics::YUVToRGBRow::row444 = row444;
+		Graphics::YUVToRGBRow::row422 = row422;
+		Graphics::YUVToRGBRow::selected = true;
+	}
+
+	void checkRowFuncs(Graphics::YUVToRGBRow::RowFunc row444, Graphics::YUVToRGBRow::RowFunc row422, int width) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat::createFormatARGB32(),
+			Graphics::PixelFormat::createFormatRGBA32(),
+			Graphics::PixelFormat::createFormatBGRA32(false)
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+
+		fillPlanes(width, kHeight);
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+		for (uint s = 0; s < ARRAYSIZE(scales); s++) {
+		for (int subsampling = 0; subsampling < kSubsamplingCount; subsampling++) {
+			// Halved chroma needs an even width
+			if ((width & 1) && subsampling != k444 && subsampling != k410)
+				continue;
+
+			Graphics::Surface expected, result;
+			// Padding in the pitch, which must not be written
+			expected.init(width, kHeight, (width + 8) * formats[f].bytesPerPixel, calloc(kHeight, (width + 8) * formats[f].bytesPerPixel), formats[f]);
+			result.init(width, kHeight, expected.pitch, calloc(kHeight, expected.pitch), formats[f]);
+
+			setRowFuncs(nullptr, nullptr);
+			convert(expected, scales[s], (Subsampling)subsampling, width, kHeight);
+			setRowFuncs(row444, row422);
+			convert(result, scales[s], (Subsampling)subsampling, width, kHeight);
+
+			TS_ASSERT_EQUALS(memcmp(expected.getPixels(), result.getPixels(), kHeight * expected.pitch), 0);
+
+			free(expected.getPixels());
+			free(result.getPixels());
+		}
+		}
+		}
+
+		Graphics::YUVToRGBRow::selected = false;
+	}
+
+public:
+	void test_simd_matches_lookup() {
+#ifdef SCUMMVM_NEON
+		checkRowFuncs(Graphics::YUVToRGBRow::row444NEON, Graphics::YUVToRGBRow::row422NEON, kWidth);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkRowFuncs(Graphics::YUVToRGBRow::row444SSE2, Graphics::YUVToRGBRow::row422SSE2, kWidth);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkRowFuncs(Graphics::YUVToRGBRow::row444AVX2, Graphics::YUVToRGBRow::row422AVX2, kWidth);
+#endif
+	}
+
+	void test_simd_matches_lookup_odd_width() {
+#ifdef SCUMMVM_NEON
+		checkRowFuncs(Graphics::YUVToRGBRow::row444NEON, Graphics::YUVToRGBRow::row422NEON, kOddWidth);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkRowFuncs(Graphics::YUVToRGBRow::row444SSE2, Graphics::YUVToRGBRow::row422SSE2, kOddWidth);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkRowFuncs(Graphics::YUVToRGBRow::row444AVX2, Graphics::YUVToRGBRow::row422AVX2, kOddWidth);
+#endif
+	}
+
+	void test_simd_speed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Graphics::YUVToRGBRow::RowFunc row444 = nullptr, row422 = nullptr;
+#ifdef SCUMMVM_NEON
+		row444 = Graphics::YUVToRGBRow::row444NEON;
+		row422 = Graphics::YUVToRGBRow::row422NEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			row444 = Graphics::YUVToRGBRow::row444SSE2;
+			row422 = Graphics::YUVToRGBRow::row422SSE2;
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			row444 = Graphics::YUVToRGBRow::row444AVX2;
+			row422 = Graphics::YUVToRGBRow::row422AVX2;
+		}
+#endif
+		if (!row444)
+			return;
+
+		Common::install_null_g_system();
+
+		const int width = 640, height = 480, iters = 50;
+		fillPlanes(width, height);
+
+		Graphics::Surface dst;
+		dst.create(width, height, Graphics::PixelFormat::createFormatARGB32());
+
+		const char *names[] = { "444", "422", "420", "420 with alpha", "410" };
+		for (int subsampling = 0; subsampling < kSubsamplingCount; subsampling++) {
+			setRowFuncs(nullptr, nullptr);
+			uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++)
+				convert(dst, Graphics::YUVToRGBManager::kScaleITU, (Subsampling)subsampling, width, height);
+			const uint32 lookupTime = g_system->getMillis() - start;
+
+			setRowFuncs(row444, row422);
+			start = g_system->getMillis();
+			for (int i = 0; i < iters; i++)
+				convert(dst, Graphics::YUVToRGBManager::kScaleITU, (Subsampling)subsampling, width, height);
+			const uint32 simdTime = g_system->getMillis() - start;
+
+			debug("YUV %s to ARGB32, %d frames of %dx%d: lookup tables %d ms, SIMD %d ms", names[subsampling], iters, width, height, lookupTime, simdTime);
+		}
+
+		dst.free();
+		Graphics::YUVToRGBRow::selected = false;
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
@@ -10,11 +10,14 @@ TESTS        := $(srcdir)/test/common/*.h \
 	$(srcdir)/test/common/formats/*.h \
 	$(srcdir)/test/audio/*.h \
 	$(srcdir)/test/math/*.h \
-	$(srcdir)/test/image/*.h
+	$(srcdir)/test/image/*.h \
+	$(srcdir)/test/video/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
 TEST_LIBS += test/system/null_osystem.o \
+	backends/mutex/pthread/pthread-mutex.o \
+	backends/thread/pthread/pthread-thread.o \
 	backends/fs/posix/posix-fs-factory.o \
 	backends/fs/posix/posix-fs.o \
 	backends/fs/posix/posix-iostream.o \
@@ -33,12 +36,18 @@ TEST_LIBS += test/system/null_osystem.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
+TESTS += $(srcdir)/test/graphics/dirtyrects*.h
+
 ifdef USE_TINYGL
 TESTS += $(srcdir)/test/graphics/tinygl*.h
 endif
 
+ifdef USE_HQ_SCALERS
+TESTS += $(srcdir)/test/graphics/hq*.h
+endif
+
 # libcommon needs libformats and libformats needs libcommon: so libcommon is put twice
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+TEST_LIBS +=	video/libvideo.a audio/libaudio.a math/libmath.a common/libcommon.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -1,4 +1,5 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_abort
+#define FORBIDDEN_SYMBOL_EXCEPTION_unlink
 
 #define USE_NULL_DRIVER 1
 #define NULL_DRIVER_USE_FOR_TEST 1
@@ -27,6 +28,14 @@ void Common::uninstall_null_g_system() {
 	g_system = nullptr;
 }
 
+void Common::remove_test_file(const char *path) {
+#ifdef WIN32
+	DeleteFileA(path);
+#else
+	unlink(path);
+#endif
+}
+
 void OSystem_NULL::quit() {
 	abort();
 }
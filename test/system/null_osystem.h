@@ -4,6 +4,8 @@ namespace Common {
 #if defined(POSIX) || defined(WIN32)
 void install_null_g_system();
 void uninstall_null_g_system();
+// Delete a file the test created, which the FS API cannot do
+void remove_test_file(const char *path);
 #define NULL_OSYSTEM_IS_AVAILABLE 1
 #else
 #define NULL_OSYSTEM_IS_AVAILABLE 0
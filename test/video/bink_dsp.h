@@ -0,0 +1,123 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "video/bink_dsp.h"
+
+class BinkDSPTestSuite : public CxxTest::TestSuite {
+#ifdef USE_BINK
+	// Blocks are written away from the start of the rows, with a pitch that
+	// is not a multiple of 16, to catch aligned accesses
+	static const uint32 kPitch = 37;
+	static const uint32 kOffset = 3;
+	static const uint32 kSize = 16 * kPitch + kOffset;
+
+	uint32 _seed;
+
+	int nextRandom(int min, int max) {
+		_seed = _seed * 1103515245 + 12345;
+		return min + (int)((_seed >> 8) % (uint32)(max - min + 1));
+	}
+
+	void fillPixels(byte *pixels) {
+		for (uint32 i = 0; i < kSize; i++)
+			pixels[i] = nextRandom(0, 255);
+	}
+
+	/**
+	 * Fill a block of DCT coefficients. Some blocks have only a DC value, or
+	 * only a few coefficients, like most of the blocks of a video.
+	 */
+	void fillCoefficients(int32 *block, int kind) {
+		for (int i = 0; i < 64; i++)
+			block[i] = 0;
+
+		switch (kind % 4) {
+		case 0:
+			block[0] = nextRandom(-2048, 2047);
+			break;
+		case 1:
+			for (int i = 0; i < 4; i++)
+				block[nextRandom(0, 63)] = nextRandom(-512, 511);
+			break;
+		default:
+			for (int i = 0; i < 64; i++)
+				block[i] = nextRandom(-4096, 4095);
+			break;
+		}
+	}
+
+	void checkIDCT(Video::BinkDSP::IDCTFunc idct, Video::BinkDSP::IDCTFunc reference) {
+		byte expected[kSize], actual[kSize];
+		int32 block[64], expectedBlock[64], actualBlock[64];
+
+		_seed = 1;
+		for (int n = 0; n < 200; n++) {
+			fillPixels(expected);
+			memcpy(actual, expected, sizeof(actual));
+			fillCoefficients(block, n);
+			memcpy(expectedBlock, block, sizeof(block));
+			memcpy(actualBlock, block, sizeof(block));
+
+			reference(expected + kOffset, kPitch, expectedBlock);
+			idct(actual + kOffset, kPitch, actualBlock);
+			TS_ASSERT_SAME_DATA(actual, expected, sizeof(actual));
+		}
+	}
+
+	void checkAddBlock(Video::BinkDSP::AddFunc addBlock) {
+		byte expected[kSize], actual[kSize];
+		int16 block[64];
+
+		_seed = 2;
+		for (int n = 0; n < 100; n++) {
+			fillPixels(expected);
+			memcpy(actual, expected, sizeof(actual));
+			// Large residues wrap around
+			const int range = n % 2 ? 255 : 1024;
+			for (int i = 0; i < 64; i++)
+				block[i] = nextRandom(-range, range);
+
+			Video::BinkDSP::addBlockGeneric(expected + kOffset, kPitch, block);
+			addBlock(actual + kOffset, kPitch, block);
+			TS_ASSERT_SAME_DATA(actual, expected, sizeof(actual));
+		}
+	}
+
+	void checkScaleBlock(Video::BinkDSP::ScaleFunc scaleBlock) {
+		byte expected[kSize], actual[kSize];
+		byte src[64];
+
+		_seed = 3;
+		for (int n = 0; n < 20; n++) {
+			fillPixels(expected);
+			memcpy(actual, expected, sizeof(actual));
+			for (int i = 0; i < 64; i++)
+				src[i] = nextRandom(0, 255);
+
+			Video::BinkDSP::scaleBlockGeneric(expected + kOffset, kPitch, src);
+			scaleBlock(actual + kOffset, kPitch, src);
+			TS_ASSERT_SAME_DATA(actual, expected, sizeof(actual));
+		}
+	}
+
+	void checkKernels(Video::BinkDSP::IDCTFunc idctPut, Video::BinkDSP::IDCTFunc idctAdd, Video::BinkDSP::AddFunc addBlock, Video::BinkDSP::ScaleFunc scaleBlock) {
+		checkIDCT(idctPut, Video::BinkDSP::idctPutGeneric);
+		checkIDCT(idctAdd, Video::BinkDSP::idctAddGeneric);
+		checkAddBlock(addBlock);
+		checkScaleBlock(scaleBlock);
+	}
+#endif
+
+public:
+	void test_simd_kernels() {
+#ifdef USE_BINK
+#ifdef SCUMMVM_NEON
+		checkKernels(Video::BinkDSP::idctPutNEON, Video::BinkDSP::idctAddNEON, Video::BinkDSP::addBlockNEON, Video::BinkDSP::scaleBlockNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkKernels(Video::BinkDSP::idctPutSSE2, Video::BinkDSP::idctAddSSE2, Video::BinkDSP::addBlockSSE2, Video::BinkDSP::scaleBlockSSE2);
+#endif
+#endif
+	}
+};
@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+#include "common/jobsystem.h"
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../system/null_osystem.h"
+
+/**
+ * A video whose frames are filled with their frame number.
+ */
+class CountingVideoDecoder : public Video::VideoDecoder {
+public:
+	CountingVideoDecoder(int frameCount) {
+		addTrack(new CountingVideoTrack(frameCount));
+	}
+	~CountingVideoDecoder() { close(); }
+
+	bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+
+private:
+	class CountingVideoTrack : public FixedRateVideoTrack {
+	public:
+		CountingVideoTrack(int frameCount) : _frameCount(frameCount), _curFrame(-1) {
+			_surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8());
+		}
+		~CountingVideoTrack() { _surface.free(); }
+
+		bool endOfTrack() const override { return _curFrame >= _frameCount - 1; }
+		bool isSeekable() const override { return true; }
+		bool seek(const Audio::Timestamp &time) override {
+			_curFrame = getFrameAtTime(time) - 1;
+			return true;
+		}
+
+		uint16 getWidth() const override { return _surface.w; }
+		uint16 getHeight() const override { return _surface.h; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return _frameCount; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			_surface.fillRect(Common::Rect(_surface.w, _surface.h), (byte)_curFrame);
+			return &_surface;
+		}
+
+	protected:
+		Common::Rational getFrameRate() const override { return 30; }
+
+	private:
+		Graphics::Surface _surface;
+		int _frameCount;
+		int _curFrame;
+	};
+};
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite
+{
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		ConfMan.setInt("worker_threads", 2, Common::ConfigManager::kApplicationDomain);
+#endif
+	}
+
+	void tearDown() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::JobSystem::destroy();
+		ConfMan.removeKey("worker_threads", Common::ConfigManager::kApplicationDomain);
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+	void test_decode_ahead_seek_and_rate() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!JobMan.isThreaded())
+			return;
+
+		CountingVideoDecoder decoder(200);
+		TS_ASSERT(decoder.setDecodeAhead(4));
+		decoder.start();
+
+		// The worker decodes ahead while the rate changes and the video seeks
+		int expected = 0;
+		for (int i = 0; i < 120; i++) {
+			if (i % 7 == 3)
+				decoder.setRate(i % 2 ? 2 : 1);
+			if (i % 23 == 11) {
+				expected = (expected * 5) % 150;
+				TS_ASSERT(decoder.seekToFrame(expected));
+			}
+
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(frame);
+			if (!frame)
+				return;
+			TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), (byte)expected);
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), expected);
+			expected++;
+		}
+
+		// The remaining frames are still handed out in order
+		while (!decoder.endOfVideo()) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(frame);
+			if (!frame)
+				return;
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), expected);
+			expected++;
+		}
+		TS_ASSERT_EQUALS(expected, 200);
+		// Seeking drops the frames that were queued
+		TS_ASSERT_LESS_THAN_EQUALS(decoder.getDecodeAheadStats().shownFrames, decoder.getDecodeAheadStats().decodedFrames);
+#endif
+	}
+
+	void test_decode_ahead_end_frame() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!JobMan.isThreaded())
+			return;
+
+		CountingVideoDecoder decoder(100);
+		TS_ASSERT(decoder.setDecodeAhead(8));
+		decoder.start();
+
+		for (int i = 0; i < 10; i++)
+			TS_ASSERT(decoder.decodeNextFrame());
+
+		// The worker is already past the new end frame
+		decoder.setEndFrame(14);
+		decoder.setRate(2);
+
+		int frames = 10;
+		while (!decoder.endOfVideo() && frames < 100) {
+			TS_ASSERT(decoder.decodeNextFrame());
+			frames++;
+		}
+		TS_ASSERT_EQUALS(frames, 15);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 14);
+#endif
+	}
+};
@@ -35,6 +35,7 @@
 #include "common/str.h"
 #include "common/bitstream.h"
 #include "common/compression/huffman.h"
+#include "common/jobsystem.h"
 #include "common/system.h"
 
 #include "graphics/yuv_to_rgb.h"
@@ -47,6 +48,7 @@
 
 #include "video/binkdata.h"
 #include "video/bink_decoder.h"
+#include "video/bink_dsp.h"
 
 static const uint32 kBIKfID = MKTAG('B', 'I', 'K', 'f');
 static const uint32 kBIKgID = MKTAG('B', 'I', 'K', 'g');
@@ -61,6 +63,9 @@ static const uint16 kAudioFlagStereo = 0x2000;
 // Number of bits used to store first DC value in bundle
 static const uint32 kDCStartBits = 11;
 
+// Number of block rows reconstructed by one job
+static const uint32 kBandBlockRows = 8;
+
 namespace Video {
 
 BinkDecoder::BinkDecoder() {
@@ -305,9 +310,22 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32
 
 	initBundles();
 	initHuffman();
+
+	initPlaneWork(0, _yBlockWidth,  _yBlockHeight);
+	initPlaneWork(1, _uvBlockWidth, _uvBlockHeight);
+	initPlaneWork(2, _uvBlockWidth, _uvBlockHeight);
+	if (_hasAlpha)
+		initPlaneWork(3, _yBlockWidth, _yBlockHeight);
+
+	_planeJobs = new Common::JobGroup();
+
+	if (!BinkDSP::selected)
+		BinkDSP::select();
 }
 
 BinkDecoder::BinkVideoTrack::~BinkVideoTrack() {
+	delete _planeJobs;
+
 	for (int i = 0; i < 4; i++) {
 		delete[] _curPlanes[i]; _curPlanes[i] = 0;
 		delete[] _oldPlanes[i]; _oldPlanes[i] = 0;
@@ -476,6 +494,9 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 			break;
 	}
 
+	// Wait for the bands still being reconstructed
+	_planeJobs->wait();
+
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
@@ -527,6 +548,16 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 		readBundle(video, (Source) i);
 	}
 
+	// Blocks that only depend on bundle values are written right away. The
+	// others are queued and reconstructed by jobs, a band of block rows at
+	// a time, while parsing goes on. Every block only writes its own pixels
+	// and only reads the previous frame, so the order does not matter.
+	PlaneWork &work = _planeWork[planeIdx];
+	work.commandCount = 0;
+	work.coeffCount = 0;
+	work.bandCount = 0;
+	uint32 bandStart = 0;
+
 	for (ctx.blockY = 0; ctx.blockY < blockHeight; ctx.blockY++) {
 		readBlockTypes              (video, _bundles[kSourceBlockTypes]);
 		readBlockTypes              (video, _bundles[kSourceSubBlockTypes]);
@@ -589,6 +620,8 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 		}
 
+		if (((ctx.blockY + 1) % kBandBlockRows) == 0 || (ctx.blockY + 1) == blockHeight)
+			submitBand(planeIdx, bandStart);
 	}
 
 	if (video.bits->pos() & 0x1F) // next plane data starts at 32-bit boundary
@@ -596,6 +629,99 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 }
 
+void BinkDecoder::BinkVideoTrack::initPlaneWork(int planeIdx, uint32 blockWidth, uint32 blockHeight) {
+	PlaneWork &work = _planeWork[planeIdx];
+
+	work.commands.resize(blockWidth * blockHeight);
+	work.coeffs.resize(blockWidth * blockHeight * 64);
+	work.bands.resize((blockHeight + kBandBlockRows - 1) / kBandBlockRows);
+	work.commandCount = 0;
+	work.coeffCount = 0;
+	work.bandCount = 0;
+}
+
+BinkDecoder::BinkVideoTrack::BlockCommand &BinkDecoder::BinkVideoTrack::addBlockCommand(DecodeContext &ctx, BlockType type, uint32 prev) {
+	PlaneWork &work = _planeWork[ctx.planeIdx];
+	assert(work.commandCount < work.commands.size());
+
+	BlockCommand &command = work.commands[work.commandCount++];
+	command.type   = type;
+	command.dest   = ctx.dest - ctx.destStart;
+	command.prev   = prev;
+	command.coeffs = nullptr;
+	return command;
+}
+
+int32 *BinkDecoder::BinkVideoTrack::allocBlockCoeffs(DecodeContext &ctx, BlockCommand &command) {
+	PlaneWork &work = _planeWork[ctx.planeIdx];
+	assert(work.coeffCount + 64 <= work.coeffs.size());
+
+	command.coeffs = &work.coeffs[work.coeffCount];
+	work.coeffCount += 64;
+
+	memset(command.coeffs, 0, 64 * sizeof(int32));
+	return command.coeffs;
+}
+
+void BinkDecoder::BinkVideoTrack::submitBand(int planeIdx, uint32 &bandStart) {
+	PlaneWork &work = _planeWork[planeIdx];
+	if (work.commandCount == bandStart)
+		return;
+
+	PlaneBand &band = work.bands[work.bandCount++];
+	band.track    = this;
+	band.planeIdx = planeIdx;
+	band.start    = bandStart;
+	band.end      = work.commandCount;
+	bandStart     = work.commandCount;
+
+	JobMan.submit(&reconstructBandJob, &band, _planeJobs);
+}
+
+void BinkDecoder::BinkVideoTrack::reconstructBandJob(void *param) {
+	PlaneBand *band = (PlaneBand *)param;
+	band->track->reconstructBand(*band);
+}
+
+void BinkDecoder::BinkVideoTrack::reconstructBand(const PlaneBand &band) {
+	const PlaneWork &work = _planeWork[band.planeIdx];
+	const uint32 pitch = (band.planeIdx == 1 || band.planeIdx == 2) ? _uvBlockWidth * 8 : _yBlockWidth * 8;
+	byte *destStart = _curPlanes[band.planeIdx];
+	const byte *prevStart = _oldPlanes[band.planeIdx];
+
+	for (uint32 i = band.start; i < band.end; i++) {
+		const BlockCommand &command = work.commands[i];
+		byte *dest = destStart + command.dest;
+
+		if (command.type == kBlockScaled) {
+			byte pixels[64];
+			BinkDSP::idctPut(pixels, 8, command.coeffs);
+			BinkDSP::scaleBlock(dest, pitch, pixels);
+			continue;
+		}
+
+		if (command.type != kBlockIntra) {
+			const byte *prev = prevStart + command.prev;
+			for (int j = 0; j < 8; j++, prev += pitch)
+				memcpy(dest + j * pitch, prev, 8);
+		}
+
+		switch (command.type) {
+		case kBlockResidue:
+			BinkDSP::addBlock(dest, pitch, (const int16 *)command.coeffs);
+			break;
+		case kBlockIntra:
+			BinkDSP::idctPut(dest, pitch, command.coeffs);
+			break;
+		case kBlockInter:
+			BinkDSP::idctAdd(dest, pitch, command.coeffs);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, Source source) {
 	if (source == kSourceColors) {
 		for (int i = 0; i < 16; i++)
@@ -754,11 +880,7 @@ uint32 BinkDecoder::BinkVideoTrack::readBundleCount(VideoFrame &video, Bundle &b
 }
 
 void BinkDecoder::BinkVideoTrack::blockSkip(DecodeContext &ctx) {
-	byte *dest = ctx.dest;
-	byte *prev = ctx.prev;
-
-	for (int j = 0; j < 8; j++, dest += ctx.pitch, prev += ctx.pitch)
-		memcpy(dest, prev, 8);
+	addBlockCommand(ctx, kBlockSkip, ctx.prev - ctx.prevStart);
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledSkip(DecodeContext &ctx) {
@@ -806,24 +928,12 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
-	int32 block[64];
-	memset(block, 0, 64 * sizeof(int32));
+	BlockCommand &command = addBlockCommand(ctx, kBlockScaled, 0);
+	int32 *block = allocBlockCoeffs(ctx, command);
 
 	block[0] = getBundleValue(kSourceIntraDC);
 
 	readDCTCoeffs(*ctx.video, block, true);
-
-	IDCT(block);
-
-	int32 *src   = block;
-	byte  *dest1 = ctx.dest;
-	byte  *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
-
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
-
-	}
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledFill(DecodeContext &ctx) {
@@ -851,18 +961,9 @@ void BinkDecoder::BinkVideoTrack::blockScaledPattern(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledRaw(DecodeContext &ctx) {
-	byte row[8];
+	BinkDSP::scaleBlock(ctx.dest, ctx.pitch, _bundles[kSourceColors].curPtr);
 
-	byte *dest1 = ctx.dest;
-	byte *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		memcpy(row, _bundles[kSourceColors].curPtr, 8);
-
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = row[i];
-
-		_bundles[kSourceColors].curPtr += 8;
-	}
+	_bundles[kSourceColors].curPtr += 64;
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
@@ -893,17 +994,19 @@ void BinkDecoder::BinkVideoTrack::blockScaled(DecodeContext &ctx) {
 	ctx.prev   += 8;
 }
 
-void BinkDecoder::BinkVideoTrack::blockMotion(DecodeContext &ctx) {
+uint32 BinkDecoder::BinkVideoTrack::readMotionSource(DecodeContext &ctx) {
 	int8 xOff = getBundleValue(kSourceXOff);
 	int8 yOff = getBundleValue(kSourceYOff);
 
-	byte *dest = ctx.dest;
 	byte *prev = ctx.prev + yOff * ((int32) ctx.pitch) + xOff;
 	if ((prev < ctx.prevStart) || (prev > ctx.prevEnd))
 		error("Copy out of bounds (%d | %d)", ctx.blockX * 8 + xOff, ctx.blockY * 8 + yOff);
 
-	for (int j = 0; j < 8; j++, dest += ctx.pitch, prev += ctx.pitch)
-		memcpy(dest, prev, 8);
+	return prev - ctx.prevStart;
+}
+
+void BinkDecoder::BinkVideoTrack::blockMotion(DecodeContext &ctx) {
+	addBlockCommand(ctx, kBlockMotion, readMotionSource(ctx));
 }
 
 void BinkDecoder::BinkVideoTrack::blockRun(DecodeContext &ctx) {
@@ -934,31 +1037,21 @@ void BinkDecoder::BinkVideoTrack::blockRun(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
-	blockMotion(ctx);
+	BlockCommand &command = addBlockCommand(ctx, kBlockResidue, readMotionSource(ctx));
+	int16 *block = (int16 *)allocBlockCoeffs(ctx, command);
 
 	byte v = ctx.video->bits->getBits<7>();
 
-	int16 block[64];
-	memset(block, 0, 64 * sizeof(int16));
-
 	readResidue(*ctx.video, block, v);
-
-	byte  *dst = ctx.dest;
-	int16 *src = block;
-	for (int i = 0; i < 8; i++, dst += ctx.pitch, src += 8)
-		for (int j = 0; j < 8; j++)
-			dst[j] += src[j];
 }
 
 void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
-	int32 block[64];
-	memset(block, 0, 64 * sizeof(int32));
+	BlockCommand &command = addBlockCommand(ctx, kBlockIntra, 0);
+	int32 *block = allocBlockCoeffs(ctx, command);
 
 	block[0] = getBundleValue(kSourceIntraDC);
 
 	readDCTCoeffs(*ctx.video, block, true);
-
-	IDCTPut(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
@@ -970,16 +1063,12 @@ void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
-	blockMotion(ctx);
-
-	int32 block[64];
-	memset(block, 0, 64 * sizeof(int32));
+	BlockCommand &command = addBlockCommand(ctx, kBlockInter, readMotionSource(ctx));
+	int32 *block = allocBlockCoeffs(ctx, command);
 
 	block[0] = getBundleValue(kSourceInterDC);
 
 	readDCTCoeffs(*ctx.video, block, false);
-
-	IDCTAdd(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
@@ -1459,34 +1548,71 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+BinkDSP::IDCTFunc BinkDSP::idctPut = BinkDSP::idctPutGeneric;
+BinkDSP::IDCTFunc BinkDSP::idctAdd = BinkDSP::idctAddGeneric;
+BinkDSP::AddFunc BinkDSP::addBlock = BinkDSP::addBlockGeneric;
+BinkDSP::ScaleFunc BinkDSP::scaleBlock = BinkDSP::scaleBlockGeneric;
+bool BinkDSP::selected = false;
+
+void BinkDSP::select() {
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		idctPut    = idctPutNEON;
+		idctAdd    = idctAddNEON;
+		addBlock   = addBlockNEON;
+		scaleBlock = scaleBlockNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		idctPut    = idctPutSSE2;
+		idctAdd    = idctAddSSE2;
+		addBlock   = addBlockSSE2;
+		scaleBlock = scaleBlockSSE2;
+	}
+#endif
+	selected = true;
+}
+
+void BinkDSP::idctPutGeneric(byte *dest, uint32 pitch, int32 *block) {
 	int i;
 	int32 temp[64];
-
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+void BinkDSP::idctAddGeneric(byte *dest, uint32 pitch, int32 *block) {
 	int i, j;
+	int32 temp[64];
 
-	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	for (i = 0; i < 8; i++)
+		IDCTCol(&temp[i], &block[i]);
+	for (i = 0; i < 8; i++) {
+		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+	}
+
+	for (i = 0; i < 8; i++, dest += pitch, block += 8)
 		for (j = 0; j < 8; j++)
 			 dest[j] += block[j];
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
-	int i;
-	int32 temp[64];
-	for (i = 0; i < 8; i++)
-		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+void BinkDSP::addBlockGeneric(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		for (int j = 0; j < 8; j++)
+			dest[j] += block[j];
+}
+
+void BinkDSP::scaleBlockGeneric(byte *dest, uint32 pitch, const byte *src) {
+	byte *dest1 = dest;
+	byte *dest2 = dest + pitch;
+	for (int j = 0; j < 8; j++, dest1 += (pitch << 1) - 16, dest2 += (pitch << 1) - 16, src += 8) {
+
+		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
+			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+
 	}
 }
 
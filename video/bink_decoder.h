@@ -44,6 +44,7 @@ class QueuingAudioStream;
 }
 
 namespace Common {
+class JobGroup;
 class SeekableReadStream;
 template <class BITSTREAM>
 class Huffman;
@@ -247,6 +248,32 @@ private:
 			byte *curPtr; ///< Pointer to the data that wasn't yet read.
 		};
 
+		/** Pixel work of a block, done on a worker once its band of the plane has been parsed. */
+		struct BlockCommand {
+			BlockType type; ///< Skip, motion, residue, intra or inter block, or kBlockScaled for a 16x16 intra block.
+			uint32 dest;    ///< Offset of the block in the plane.
+			uint32 prev;    ///< Offset of the (motion compensated) source in the previous plane.
+			int32 *coeffs;  ///< DCT coefficients, or the residue as int16 values.
+		};
+
+		/** A band of block rows, reconstructed by one job. */
+		struct PlaneBand {
+			BinkVideoTrack *track;
+			int planeIdx;
+			uint32 start; ///< First command of the band.
+			uint32 end;   ///< Command after the last one of the band.
+		};
+
+		/** The deferred pixel work of a plane. */
+		struct PlaneWork {
+			Common::Array<BlockCommand> commands;
+			Common::Array<int32> coeffs;
+			Common::Array<PlaneBand> bands;
+			uint32 commandCount;
+			uint32 coeffCount;
+			uint32 bandCount;
+		};
+
 		int _curFrame;
 		int _frameCount;
 
@@ -281,6 +308,9 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		PlaneWork _planeWork[4];       ///< Deferred pixel work of the 4 planes.
+		Common::JobGroup *_planeJobs; ///< Reconstruction jobs of the current frame.
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -292,6 +322,20 @@ private:
 		/** Decode a plane. */
 		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 
+		/** Allocate the deferred work buffers of a plane. */
+		void initPlaneWork(int planeIdx, uint32 blockWidth, uint32 blockHeight);
+		/** Queue a block's pixel work. */
+		BlockCommand &addBlockCommand(DecodeContext &ctx, BlockType type, uint32 prev);
+		/** Reserve space for a block's coefficients in the plane's buffer. */
+		int32 *allocBlockCoeffs(DecodeContext &ctx, BlockCommand &command);
+		/** Start reconstructing the block rows parsed since the last band. */
+		void submitBand(int planeIdx, uint32 &bandStart);
+		/** Reconstruct a band of block rows. */
+		void reconstructBand(const PlaneBand &band);
+		static void reconstructBandJob(void *param);
+		/** Offset of a motion compensated block in the previous plane. */
+		uint32 readMotionSource(DecodeContext &ctx);
+
 		/** Read/Initialize a bundle for decoding a plane. */
 		void readBundle(VideoFrame &video, Source source);
 
@@ -336,11 +380,6 @@ private:
 		void readDCS         (VideoFrame &video, Bundle &bundle);
 		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
-
-		// Bink video IDCT
-		void IDCT(int32 *block);
-		void IDCTPut(DecodeContext &ctx, int32 *block);
-		void IDCTAdd(DecodeContext &ctx, int32 *block);
 	};
 
 	class BinkAudioTrack : public AudioTrack {
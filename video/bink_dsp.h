@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIDEO_BINK_DSP_H
+#define VIDEO_BINK_DSP_H
+
+#include "common/scummsys.h"
+
+namespace Video {
+
+/**
+ * Pixel kernels of the Bink video decoder.
+ *
+ * The SIMD variants produce exactly the same pixels as the generic ones,
+ * including the wrap-around of out of range values.
+ */
+struct BinkDSP {
+	/** Inverse transform an 8x8 block of coefficients (which is clobbered) and store or add the result. */
+	typedef void (*IDCTFunc)(byte *dest, uint32 pitch, int32 *block);
+	/** Add an 8x8 block of residue values. */
+	typedef void (*AddFunc)(byte *dest, uint32 pitch, const int16 *block);
+	/** Scale an 8x8 block of pixels with a pitch of 8 up to 16x16. */
+	typedef void (*ScaleFunc)(byte *dest, uint32 pitch, const byte *src);
+
+	static IDCTFunc idctPut;
+	static IDCTFunc idctAdd;
+	static AddFunc addBlock;
+	static ScaleFunc scaleBlock;
+	/**
+	 * Whether the kernels have been picked. They are never picked again, as
+	 * the band jobs of other decoders may be using them.
+	 */
+	static bool selected;
+
+	/** Pick the fastest kernels the CPU supports. */
+	static void select();
+
+	static void idctPutGeneric(byte *dest, uint32 pitch, int32 *block);
+	static void idctAddGeneric(byte *dest, uint32 pitch, int32 *block);
+	static void addBlockGeneric(byte *dest, uint32 pitch, const int16 *block);
+	static void scaleBlockGeneric(byte *dest, uint32 pitch, const byte *src);
+#ifdef SCUMMVM_NEON
+	static void idctPutNEON(byte *dest, uint32 pitch, int32 *block);
+	static void idctAddNEON(byte *dest, uint32 pitch, int32 *block);
+	static void addBlockNEON(byte *dest, uint32 pitch, const int16 *block);
+	static void scaleBlockNEON(byte *dest, uint32 pitch, const byte *src);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void idctPutSSE2(byte *dest, uint32 pitch, int32 *block);
+	static void idctAddSSE2(byte *dest, uint32 pitch, int32 *block);
+	static void addBlockSSE2(byte *dest, uint32 pitch, const int16 *block);
+	static void scaleBlockSSE2(byte *dest, uint32 pitch, const byte *src);
+#endif
+};
+
+// Constants of the Bink IDCT, in 1.11 fixed point
+enum {
+	kBinkIDCTA1 =  2896, // (1/sqrt(2))<<12
+	kBinkIDCTA2 =  2217,
+	kBinkIDCTA3 =  3784,
+	kBinkIDCTA4 = -5352
+};
+
+} // End of namespace Video
+
+#endif // VIDEO_BINK_DSP_H
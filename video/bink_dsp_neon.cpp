@@ -0,0 +1,174 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "video/bink_dsp.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Video {
+
+static inline int32x4_t neon_mulConst(int32x4_t a, int32 c) {
+	return vshrq_n_s32(vmulq_n_s32(a, c), 11);
+}
+
+/** One dimensional IDCT of four columns at once, see IDCT_TRANSFORM. */
+static inline void neon_idct8(int32x4_t *v) {
+	const int32x4_t a0 = vaddq_s32(v[0], v[4]);
+	const int32x4_t a1 = vsubq_s32(v[0], v[4]);
+	const int32x4_t a2 = vaddq_s32(v[2], v[6]);
+	const int32x4_t a3 = neon_mulConst(vsubq_s32(v[2], v[6]), kBinkIDCTA1);
+	const int32x4_t a4 = vaddq_s32(v[5], v[3]);
+	const int32x4_t a5 = vsubq_s32(v[5], v[3]);
+	const int32x4_t a6 = vaddq_s32(v[1], v[7]);
+	const int32x4_t a7 = vsubq_s32(v[1], v[7]);
+	const int32x4_t b0 = vaddq_s32(a4, a6);
+	const int32x4_t b1 = neon_mulConst(vaddq_s32(a5, a7), kBinkIDCTA3);
+	const int32x4_t b2 = vaddq_s32(vsubq_s32(neon_mulConst(a5, kBinkIDCTA4), b0), b1);
+	const int32x4_t b3 = vsubq_s32(neon_mulConst(vsubq_s32(a6, a4), kBinkIDCTA1), b2);
+	const int32x4_t b4 = vsubq_s32(vaddq_s32(neon_mulConst(a7, kBinkIDCTA2), b3), b1);
+
+	const int32x4_t c0 = vaddq_s32(a0, a2);
+	const int32x4_t c1 = vsubq_s32(vaddq_s32(a1, a3), a2);
+	const int32x4_t c2 = vaddq_s32(vsubq_s32(a1, a3), a2);
+	const int32x4_t c3 = vsubq_s32(a0, a2);
+
+	v[0] = vaddq_s32(c0, b0);
+	v[1] = vaddq_s32(c1, b2);
+	v[2] = vaddq_s32(c2, b3);
+	v[3] = vsubq_s32(c3, b4);
+	v[4] = vaddq_s32(c3, b4);
+	v[5] = vsubq_s32(c2, b3);
+	v[6] = vsubq_s32(c1, b2);
+	v[7] = vsubq_s32(c0, b0);
+}
+
+static inline void neon_transpose4(int32x4_t &r0, int32x4_t &r1, int32x4_t &r2, int32x4_t &r3) {
+	const int32x4x2_t t01 = vtrnq_s32(r0, r1);
+	const int32x4x2_t t23 = vtrnq_s32(r2, r3);
+	r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+/**
+ * Transpose an 8x8 matrix held as the left halves of the rows in lo and
+ * the right halves in hi.
+ */
+static inline void neon_transpose8(int32x4_t *lo, int32x4_t *hi) {
+	neon_transpose4(lo[0], lo[1], lo[2], lo[3]);
+	neon_transpose4(hi[0], hi[1], hi[2], hi[3]);
+	neon_transpose4(lo[4], lo[5], lo[6], lo[7]);
+	neon_transpose4(hi[4], hi[5], hi[6], hi[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const int32x4_t t = hi[i];
+		hi[i] = lo[i + 4];
+		lo[i + 4] = t;
+	}
+}
+
+/** Run the full IDCT and return the low bytes of the pixel values, row by row. */
+static inline void neon_idct(const int32 *block, uint8x8_t *rows) {
+	int32x4_t lo[8], hi[8];
+	for (int i = 0; i < 8; i++) {
+		lo[i] = vld1q_s32((const int32_t *)&block[i * 8]);
+		hi[i] = vld1q_s32((const int32_t *)&block[i * 8 + 4]);
+	}
+
+	// Columns, then the rows as columns of the transposed matrix
+	neon_idct8(lo);
+	neon_idct8(hi);
+	neon_transpose8(lo, hi);
+	neon_idct8(lo);
+	neon_idct8(hi);
+	neon_transpose8(lo, hi);
+
+	const int32x4_t round = vdupq_n_s32(0x7F);
+	for (int i = 0; i < 8; i++) {
+		const int16x4_t l = vmovn_s32(vshrq_n_s32(vaddq_s32(lo[i], round), 8));
+		const int16x4_t h = vmovn_s32(vshrq_n_s32(vaddq_s32(hi[i], round), 8));
+		rows[i] = vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(l, h)));
+	}
+}
+
+void BinkDSP::idctPutNEON(byte *dest, uint32 pitch, int32 *block) {
+	uint8x8_t rows[8];
+	neon_idct(block, rows);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, rows[i]);
+}
+
+void BinkDSP::idctAddNEON(byte *dest, uint32 pitch, int32 *block) {
+	uint8x8_t rows[8];
+	neon_idct(block, rows);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), rows[i]));
+}
+
+void BinkDSP::addBlockNEON(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const uint8x8_t residue = vmovn_u16(vreinterpretq_u16_s16(vld1q_s16((const int16_t *)block)));
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), residue));
+	}
+}
+
+void BinkDSP::scaleBlockNEON(byte *dest, uint32 pitch, const byte *src) {
+	for (int i = 0; i < 8; i++, dest += pitch * 2, src += 8) {
+		const uint8x8_t row = vld1_u8(src);
+		const uint8x8x2_t zipped = vzip_u8(row, row);
+		const uint8x16_t doubled = vcombine_u8(zipped.val[0], zipped.val[1]);
+		vst1q_u8(dest, doubled);
+		vst1q_u8(dest + pitch, doubled);
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
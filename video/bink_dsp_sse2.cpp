@@ -0,0 +1,197 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "video/bink_dsp.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Video {
+
+/**
+ * Multiply by one of the IDCT constants and shift the 1.11 fixed point
+ * product back. SSE2 has no 32-bit multiply keeping the low half, so the
+ * even and odd lanes are multiplied separately.
+ */
+static FORCEINLINE __m128i sse2_mulConst(__m128i a, int32 c) {
+	const __m128i k = _mm_set1_epi32(c);
+	const __m128i even = _mm_mul_epu32(a, k);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), k);
+	const __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	return _mm_srai_epi32(product, 11);
+}
+
+/** One dimensional IDCT of four columns at once, see IDCT_TRANSFORM. */
+static FORCEINLINE void sse2_idct8(__m128i *v) {
+	const __m128i a0 = _mm_add_epi32(v[0], v[4]);
+	const __m128i a1 = _mm_sub_epi32(v[0], v[4]);
+	const __m128i a2 = _mm_add_epi32(v[2], v[6]);
+	const __m128i a3 = sse2_mulConst(_mm_sub_epi32(v[2], v[6]), kBinkIDCTA1);
+	const __m128i a4 = _mm_add_epi32(v[5], v[3]);
+	const __m128i a5 = _mm_sub_epi32(v[5], v[3]);
+	const __m128i a6 = _mm_add_epi32(v[1], v[7]);
+	const __m128i a7 = _mm_sub_epi32(v[1], v[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = sse2_mulConst(_mm_add_epi32(a5, a7), kBinkIDCTA3);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(sse2_mulConst(a5, kBinkIDCTA4), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(sse2_mulConst(_mm_sub_epi32(a6, a4), kBinkIDCTA1), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(sse2_mulConst(a7, kBinkIDCTA2), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	v[0] = _mm_add_epi32(c0, b0);
+	v[1] = _mm_add_epi32(c1, b2);
+	v[2] = _mm_add_epi32(c2, b3);
+	v[3] = _mm_sub_epi32(c3, b4);
+	v[4] = _mm_add_epi32(c3, b4);
+	v[5] = _mm_sub_epi32(c2, b3);
+	v[6] = _mm_sub_epi32(c1, b2);
+	v[7] = _mm_sub_epi32(c0, b0);
+}
+
+static FORCEINLINE void sse2_transpose4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Transpose an 8x8 matrix held as the left halves of the rows in lo and
+ * the right halves in hi.
+ */
+static FORCEINLINE void sse2_transpose8(__m128i *lo, __m128i *hi) {
+	sse2_transpose4(lo[0], lo[1], lo[2], lo[3]);
+	sse2_transpose4(hi[0], hi[1], hi[2], hi[3]);
+	sse2_transpose4(lo[4], lo[5], lo[6], lo[7]);
+	sse2_transpose4(hi[4], hi[5], hi[6], hi[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = hi[i];
+		hi[i] = lo[i + 4];
+		lo[i + 4] = t;
+	}
+}
+
+/**
+ * Run the full IDCT. On return, lo and hi hold the left and right halves
+ * of the rows of pixel values.
+ */
+static FORCEINLINE void sse2_idct(const int32 *block, __m128i *lo, __m128i *hi) {
+	for (int i = 0; i < 8; i++) {
+		lo[i] = _mm_loadu_si128((const __m128i *)&block[i * 8]);
+		hi[i] = _mm_loadu_si128((const __m128i *)&block[i * 8 + 4]);
+	}
+
+	// Columns, then the rows as columns of the transposed matrix
+	sse2_idct8(lo);
+	sse2_idct8(hi);
+	sse2_transpose8(lo, hi);
+	sse2_idct8(lo);
+	sse2_idct8(hi);
+	sse2_transpose8(lo, hi);
+
+	const __m128i round = _mm_set1_epi32(0x7F);
+	for (int i = 0; i < 8; i++) {
+		lo[i] = _mm_srai_epi32(_mm_add_epi32(lo[i], round), 8);
+		hi[i] = _mm_srai_epi32(_mm_add_epi32(hi[i], round), 8);
+	}
+}
+
+/** Keep the low bytes of eight 32-bit values, as 16-bit values. */
+static FORCEINLINE __m128i sse2_lowBytes(__m128i lo, __m128i hi) {
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	return _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+}
+
+void BinkDSP::idctPutSSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i lo[8], hi[8];
+	sse2_idct(block, lo, hi);
+
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = sse2_lowBytes(lo[i], hi[i]);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(pixels, pixels));
+	}
+}
+
+void BinkDSP::idctAddSSE2(byte *dest, uint32 pitch, int32 *block) {
+	__m128i lo[8], hi[8];
+	sse2_idct(block, lo, hi);
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	for (int i = 0; i < 8; i++, dest += pitch) {
+		const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), zero);
+		const __m128i sum = _mm_and_si128(_mm_add_epi16(pixels, sse2_lowBytes(lo[i], hi[i])), mask);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+}
+
+void BinkDSP::addBlockSSE2(byte *dest, uint32 pitch, const int16 *block) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)dest), zero);
+		const __m128i sum = _mm_and_si128(_mm_add_epi16(pixels, _mm_loadu_si128((const __m128i *)block)), mask);
+		_mm_storel_epi64((__m128i *)dest, _mm_packus_epi16(sum, sum));
+	}
+}
+
+void BinkDSP::scaleBlockSSE2(byte *dest, uint32 pitch, const byte *src) {
+	for (int i = 0; i < 8; i++, dest += pitch * 2, src += 8) {
+		const __m128i row = _mm_loadl_epi64((const __m128i *)src);
+		const __m128i doubled = _mm_unpacklo_epi8(row, row);
+		_mm_storeu_si128((__m128i *)dest, doubled);
+		_mm_storeu_si128((__m128i *)(dest + pitch), doubled);
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -21,6 +21,14 @@ MODULE_OBJS := \
 ifdef USE_BINK
 MODULE_OBJS += \
 	bink_decoder.o
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	bink_dsp_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_dsp_sse2.o
+endif
 endif
 
 ifdef USE_HNM
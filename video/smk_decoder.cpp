@@ -301,6 +301,8 @@ SmackerDecoder::SmackerDecoder() {
 	_firstFrameStart = 0;
 	_frameTypes = 0;
 	_frameSizes = 0;
+	_seekIndexEnd = 0;
+	_skipAudio = false;
 }
 
 SmackerDecoder::~SmackerDecoder() {
@@ -439,6 +441,10 @@ void SmackerDecoder::close() {
 
 	delete[] _frameSizes;
 	_frameSizes = 0;
+
+	_frameOffsets.clear();
+	_seekPoints.clear();
+	_seekIndexEnd = 0;
 }
 
 bool SmackerDecoder::rewind() {
@@ -499,6 +505,127 @@ const Graphics::Surface *SmackerDecoder::forceSeekToFrame(uint frame) {
 	return surface;
 }
 
+bool SmackerDecoder::seekIntern(const Audio::Timestamp &time) {
+	SmackerVideoTrack *videoTrack = (SmackerVideoTrack *)getTrack(0);
+
+	uint32 frame = videoTrack->getFrameAtTime(time);
+	if (frame >= (uint32)videoTrack->getFrameCount())
+		return false;
+
+	// Start from the nearest keyframe, or from the beginning, unless
+	// going on from the current frame is closer
+	const SeekPoint *seekPoint = findSeekPoint(frame);
+	const int curFrame = videoTrack->getCurFrame();
+	if (curFrame < (int)frame && curFrame >= (seekPoint ? (int)seekPoint->frame : 0)) {
+		// Already in place
+	} else if (seekPoint) {
+		videoTrack->setCurFrame(seekPoint->frame - 1);
+		videoTrack->restorePalette(seekPoint->palette);
+		_fileStream->seek(_firstFrameStart + getFrameOffset(seekPoint->frame));
+	} else {
+		videoTrack->setCurFrame(-1);
+		_fileStream->seek(_firstFrameStart);
+	}
+
+	for (uint32 i = 1; i < getNumTracks(); i++) {
+		Track *track = getTrack(i);
+		if (!track->seek(time))
+			return false;
+	}
+
+	// Decode the frames before the target, and drop their audio so
+	// that the audio restarts with the target frame
+	_skipAudio = true;
+	while (videoTrack->getCurFrame() < (int)frame - 1)
+		readNextPacket();
+	_skipAudio = false;
+
+	return true;
+}
+
+uint32 SmackerDecoder::getFrameOffset(uint32 frame) {
+	if (_frameOffsets.empty()) {
+		const uint32 frameCount = ((SmackerVideoTrack *)getTrack(0))->getFrameCount();
+		_frameOffsets.resize(frameCount + 1);
+		_frameOffsets[0] = 0;
+		for (uint32 i = 0; i < frameCount; i++)
+			_frameOffsets[i + 1] = _frameOffsets[i] + (_frameSizes[i] & ~3);
+	}
+
+	return _frameOffsets[frame];
+}
+
+const SmackerDecoder::SeekPoint *SmackerDecoder::findSeekPoint(uint32 frame) const {
+	// Binary search for the last keyframe not after the frame
+	uint32 lo = 0, hi = _seekPoints.size();
+	while (lo < hi) {
+		const uint32 mid = (lo + hi) / 2;
+		if (_seekPoints[mid].frame <= frame)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo ? &_seekPoints[lo - 1] : nullptr;
+}
+
+uint32 SmackerDecoder::getSeekIndexChecksum() const {
+	const uint32 frameCount = ((const SmackerVideoTrack *)getTrack(0))->getFrameCount();
+
+	uint32 checksum = frameCount;
+	for (uint32 i = 0; i < frameCount; i++)
+		checksum = checksum * 31 + _frameSizes[i] + _frameTypes[i];
+
+	return checksum;
+}
+
+void SmackerDecoder::saveSeekIndex(Common::WriteStream &stream) const {
+	if (!isVideoLoaded())
+		return;
+
+	stream.writeUint32BE(MKTAG('S', 'M', 'K', 'I'));
+	stream.writeUint32LE(getSeekIndexChecksum());
+	stream.writeUint32LE(_seekIndexEnd);
+	stream.writeUint32LE(_seekPoints.size());
+	for (const SeekPoint &seekPoint : _seekPoints) {
+		stream.writeUint32LE(seekPoint.frame);
+		stream.write(seekPoint.palette, sizeof(seekPoint.palette));
+	}
+}
+
+bool SmackerDecoder::loadSeekIndex(Common::SeekableReadStream &stream) {
+	if (!isVideoLoaded())
+		return false;
+
+	if (stream.readUint32BE() != MKTAG('S', 'M', 'K', 'I') || stream.readUint32LE() != getSeekIndexChecksum())
+		return false;
+
+	const uint32 frameCount = ((SmackerVideoTrack *)getTrack(0))->getFrameCount();
+	const uint32 seekIndexEnd = stream.readUint32LE();
+	const uint32 count = stream.readUint32LE();
+	if (stream.err() || seekIndexEnd > frameCount || count > frameCount)
+		return false;
+
+	Common::Array<SeekPoint> seekPoints(count);
+	for (uint32 i = 0; i < count; i++) {
+		seekPoints[i].frame = stream.readUint32LE();
+		stream.read(seekPoints[i].palette, sizeof(seekPoints[i].palette));
+		if (seekPoints[i].frame >= seekIndexEnd || (i > 0 && seekPoints[i].frame <= seekPoints[i - 1].frame))
+			return false;
+	}
+
+	if (stream.err())
+		return false;
+
+	// Keep the current index if it already covers more frames
+	if (seekIndexEnd > _seekIndexEnd) {
+		_seekPoints = seekPoints;
+		_seekIndexEnd = seekIndexEnd;
+	}
+
+	return true;
+}
+
 void SmackerDecoder::readNextPacket() {
 	SmackerVideoTrack *videoTrack = (SmackerVideoTrack *)getTrack(0);
 
@@ -507,6 +634,14 @@ void SmackerDecoder::readNextPacket() {
 
 	videoTrack->increaseCurFrame();
 
+	// Frames reached for the first time are checked for keyframes, which
+	// need the palette the frame starts from
+	const uint32 frame = videoTrack->getCurFrame();
+	const bool indexFrame = (frame == _seekIndexEnd);
+	byte palette[3 * 256];
+	if (indexFrame)
+		videoTrack->grabPalette(palette);
+
 	uint i;
 	uint32 chunkSize = 0;
 	uint32 dataSizeUnpacked = 0;
@@ -534,7 +669,10 @@ void SmackerDecoder::readNextPacket() {
 			chunkSize -= 4;    // subtract the next 4 bytes (unpacked data size)
 		}
 
-		handleAudioTrack(i, chunkSize, dataSizeUnpacked);
+		if (_skipAudio)
+			_fileStream->skip(chunkSize);
+		else
+			handleAudioTrack(i, chunkSize, dataSizeUnpacked);
 	}
 
 	uint32 frameSize = _frameSizes[videoTrack->getCurFrame()] & ~3;
@@ -555,6 +693,17 @@ void SmackerDecoder::readNextPacket() {
 	videoTrack->decodeFrame(bs);
 
 	_fileStream->seek(startPos + frameSize);
+
+	if (indexFrame) {
+		if (videoTrack->isKeyFrame() && (_seekPoints.empty() || frame >= _seekPoints.back().frame + kSeekPointSpacing)) {
+			SeekPoint seekPoint;
+			seekPoint.frame = frame;
+			memcpy(seekPoint.palette, palette, sizeof(palette));
+			_seekPoints.push_back(seekPoint);
+		}
+
+		_seekIndexEnd = frame + 1;
+	}
 }
 
 void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize) {
@@ -610,6 +759,7 @@ SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height
 	_version = version;
 	_curFrame = -1;
 	_dirtyPalette = false;
+	_keyFrame = false;
 	_MMapTree = _MClrTree = _FullTree = _TypeTree = 0;
 }
 
@@ -648,6 +798,7 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 	_FullTree->reset();
 	_TypeTree->reset();
 	_dirtyBlocks.clear();
+	_keyFrame = true;
 
 	// Height needs to be doubled if we have flags (Y-interlaced or Y-doubled)
 	uint doubleY = (_flags & 6) ? 2 : 1;
@@ -768,6 +919,8 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(SmackerBitStream &bs) {
 			}
 			break;
 		case SMK_BLOCK_SKIP:
+			if (block < blocks)
+				_keyFrame = false;
 			while (run-- && block < blocks)
 				block++;
 			break;
@@ -844,6 +997,11 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	_dirtyPalette = true;
 }
 
+void SmackerDecoder::SmackerVideoTrack::restorePalette(const byte *palette) {
+	_palette.set(palette, 0, 256);
+	_dirtyPalette = true;
+}
+
 SmackerDecoder::SmackerAudioTrack::SmackerAudioTrack(const AudioInfo &audioInfo, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(audioInfo) {
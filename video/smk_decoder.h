@@ -29,6 +29,7 @@
 #ifndef VIDEO_SMK_PLAYER_H
 #define VIDEO_SMK_PLAYER_H
 
+#include "common/array.h"
 #include "common/bitarray.h"
 #include "common/bitstream.h"
 #include "common/rational.h"
@@ -45,6 +46,7 @@ class QueuingAudioStream;
 
 namespace Common {
 class SeekableReadStream;
+class WriteStream;
 }
 
 namespace Video {
@@ -88,8 +90,24 @@ public:
 
 	virtual const Common::Rect *getNextDirtyRect();
 
+	/**
+	 * Save the seek index built so far, so that seeking in the same video
+	 * is fast right away after loadSeekIndex().
+	 */
+	void saveSeekIndex(Common::WriteStream &stream) const;
+
+	/**
+	 * Load a seek index saved by saveSeekIndex(). This fails, leaving the
+	 * current index alone, when it was saved for another video.
+	 */
+	bool loadSeekIndex(Common::SeekableReadStream &stream);
+
+	/** Return the number of keyframes in the seek index. */
+	uint getSeekIndexSize() const { return _seekPoints.size(); }
+
 protected:
 	void readNextPacket();
+	bool seekIntern(const Audio::Timestamp &time);
 	bool supportsAudioTrackSwitching() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 
@@ -105,6 +123,10 @@ protected:
 		bool isRewindable() const { return true; }
 		bool rewind() { _curFrame = -1; return true; }
 
+		// The decoder does the seeking, see SmackerDecoder::seekIntern()
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time) { return true; }
+
 		uint16 getWidth() const;
 		uint16 getHeight() const;
 		Graphics::PixelFormat getPixelFormat() const;
@@ -116,9 +138,15 @@ protected:
 
 		void readTrees(SmackerBitStream &bs, uint32 mMapSize, uint32 mClrSize, uint32 fullSize, uint32 typeSize);
 		void increaseCurFrame() { _curFrame++; }
+		void setCurFrame(int frame) { _curFrame = frame; }
 		void decodeFrame(SmackerBitStream &bs);
 		void unpackPalette(Common::SeekableReadStream *stream);
 
+		/** Whether the last decoded frame repainted every block, not depending on the previous frame. */
+		bool isKeyFrame() const { return _keyFrame; }
+		void grabPalette(byte *palette) const { _palette.grab(palette, 0, 256); }
+		void restorePalette(const byte *palette);
+
 		Common::Rational getFrameRate() const { return _frameRate; }
 
 		const Common::Rect *getNextDirtyRect();
@@ -143,6 +171,7 @@ protected:
 
 		Common::BitArray _dirtyBlocks;
 		Common::Rect _lastDirtyRect;
+		bool _keyFrame;
 
 		// Possible runs of blocks
 		static uint getBlockRun(int index) { return (index <= 58) ? index + 1 : 128 << (index - 59); }
@@ -192,6 +221,10 @@ private:
 		bool isRewindable() const { return true; }
 		bool rewind();
 
+		// Only drops the queued audio, the decoder queues the audio of the new position
+		bool isSeekable() const { return true; }
+		bool seek(const Audio::Timestamp &time) { return rewind(); }
+
 		void queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize);
 		void queuePCM(byte *buffer, uint32 bufferSize);
 
@@ -222,6 +255,35 @@ protected:
 
 private:
 	uint32 _firstFrameStart;
+
+	/**
+	 * Smacker has no keyframes as such, but a frame which does not skip any
+	 * block repaints the whole picture, and only depends on the palette of
+	 * the frame before it. These frames are recorded with that palette while
+	 * the video is decoded, at most one every kSeekPointSpacing frames, so
+	 * that seeking only needs to decode from the nearest one.
+	 */
+	struct SeekPoint {
+		uint32 frame;
+		byte palette[3 * 256];
+	};
+
+	enum {
+		kSeekPointSpacing = 32
+	};
+
+	uint32 getFrameOffset(uint32 frame);
+	const SeekPoint *findSeekPoint(uint32 frame) const;
+	uint32 getSeekIndexChecksum() const;
+
+	/** Offset of each frame from the first one, built on the first seek */
+	Common::Array<uint32> _frameOffsets;
+	/** Keyframes found so far, by ascending frame number */
+	Common::Array<SeekPoint> _seekPoints;
+	/** The frames before this one were checked for keyframes */
+	uint32 _seekIndexEnd;
+	/** Set while decoding up to a seek target, whose audio is not queued */
+	bool _skipAudio;
 };
 
 } // End of namespace Video
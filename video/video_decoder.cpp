@@ -26,8 +26,11 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/jobsystem.h"
 #include "common/system.h"
 
+#include "graphics/surface.h"
+
 namespace Video {
 
 VideoDecoder::VideoDecoder() {
@@ -48,9 +51,27 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_decodeAheadHead = 0;
+	_decodeAheadCount = 0;
+	_decodeAheadStarted = false;
+	_decodeAheadStop = false;
+	_decodeAheadEnd = false;
+	_decodeAheadHold = 0;
+	_decodeAheadGroup = nullptr;
+	_decodeAheadSurface = nullptr;
+	memset(&_decodeAheadState, 0, sizeof(_decodeAheadState));
+	memset(&_decodeAheadStats, 0, sizeof(_decodeAheadStats));
+}
+
+VideoDecoder::~VideoDecoder() {
+	// The job uses the tracks of the subclass, which are gone by now
+	assert(!_decodeAheadGroup || _decodeAheadGroup->isDone());
+	setDecodeAhead(0);
 }
 
 void VideoDecoder::close() {
+	setDecodeAhead(0);
+
 	if (isPlaying())
 		stop();
 
@@ -136,11 +157,15 @@ void VideoDecoder::pauseVideo(bool pause) {
 	if (_pauseLevel == 1 && pause) {
 		_pauseStartTime = g_system->getMillis(); // Store the starting time from pausing to keep it for later
 
+		stopDecodeAheadJob();
 		for (auto &track : _tracks)
 			track->pause(true);
+		kickDecodeAhead();
 	} else if (_pauseLevel == 0) {
+		stopDecodeAheadJob();
 		for (auto &track : _tracks)
 			track->pause(false);
+		kickDecodeAhead();
 
 		_startTime += (g_system->getMillis() - _pauseStartTime);
 	}
@@ -154,17 +179,21 @@ void VideoDecoder::resetPauseStartTime() {
 void VideoDecoder::setVolume(byte volume) {
 	_audioVolume = volume;
 
+	stopDecodeAheadJob();
 	for (auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeAudio)
 			((AudioTrack *)track)->setVolume(_audioVolume);
+	kickDecodeAhead();
 }
 
 void VideoDecoder::setBalance(int8 balance) {
 	_audioBalance = balance;
 
+	stopDecodeAheadJob();
 	for (auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeAudio)
 			((AudioTrack *)track)->setBalance(_audioBalance);
+	kickDecodeAhead();
 }
 
 Audio::Mixer::SoundType VideoDecoder::getSoundType() const {
@@ -174,9 +203,11 @@ Audio::Mixer::SoundType VideoDecoder::getSoundType() const {
 void VideoDecoder::setSoundType(Audio::Mixer::SoundType soundType) {
 	_soundType = soundType;
 
+	stopDecodeAheadJob();
 	for (auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeAudio)
 			((AudioTrack *)track)->setSoundType(_soundType);
+	kickDecodeAhead();
 }
 
 bool VideoDecoder::isVideoLoaded() const {
@@ -212,6 +243,9 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (!_decodeAheadQueue.empty())
+		return popDecodeAheadFrame();
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -237,6 +271,12 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// The decode-ahead queue only runs forward
+	if (reverse && !_decodeAheadQueue.empty())
+		return false;
+
+	stopDecodeAheadJob();
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -248,6 +288,7 @@ bool VideoDecoder::setReverse(bool reverse) {
 	}
 
 	findNextVideoTrack();
+	kickDecodeAhead();
 	return true;
 }
 
@@ -257,6 +298,9 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	if (_decodeAheadStarted)
+		return _decodeAheadState.curFrame;
+
 	int32 frame = -1;
 
 	for (const auto &track : _tracks)
@@ -267,6 +311,9 @@ int VideoDecoder::getCurFrame() const {
 }
 
 int VideoDecoder::getCurFrameDelay() const {
+	if (_decodeAheadStarted)
+		return _decodeAheadState.curFrameDelay;
+
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
@@ -309,6 +356,17 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
+	if (_decodeAheadStarted) {
+		if (endOfVideo() || _needsUpdate || !_decodeAheadState.hasNextFrame)
+			return 0;
+
+		uint32 currentTime = getTime();
+		if (_decodeAheadState.nextFrameStartTime <= currentTime)
+			return 0;
+
+		return _decodeAheadState.nextFrameStartTime - currentTime;
+	}
+
 	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
 		return 0;
 
@@ -331,6 +389,20 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	if (_decodeAheadStarted) {
+		// The video tracks are ahead of what has been shown
+		if (hasFramesLeft())
+			return false;
+
+		// The job feeds the other tracks while it reads packets, so they are
+		// only looked at once it is idle
+		for (const auto &track : _tracks)
+			if (track->getTrackType() != Track::kTrackTypeVideo && (!_decodeAheadGroup->isDone() || !track->endOfTrack()))
+				return false;
+
+		return true;
+	}
+
 	for (const auto &track : _tracks) {
 		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
@@ -356,6 +428,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -390,6 +464,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	flushDecodeAhead();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
@@ -475,8 +551,10 @@ void VideoDecoder::stop() {
 	_pauseLevel = 0;
 
 	// Reset the pause state of the tracks too
+	stopDecodeAheadJob();
 	for (auto &track : _tracks)
 		track->pause(false);
+	kickDecodeAhead();
 }
 
 void VideoDecoder::setRate(const Common::Rational &rate) {
@@ -490,6 +568,10 @@ void VideoDecoder::setRate(const Common::Rational &rate) {
 
 	Common::Rational targetRate = rate;
 
+	// Keep the job stopped until the audio tracks are restarted, even
+	// though setReverse() would kick it
+	holdDecodeAhead();
+
 	if (hasAudio()) {
 		setAudioRate(targetRate);
 	}
@@ -500,22 +582,23 @@ void VideoDecoder::setRate(const Common::Rational &rate) {
 		warning("Cannot set custom rate to backwards");
 		setReverse(false);
 		targetRate = 1;
-
-		if (_playbackRate == targetRate)
-			return;
 	}
 
-	if (_playbackRate != 0)
-		_lastTimeChange = getTime();
+	if (_playbackRate != targetRate) {
+		if (_playbackRate != 0)
+			_lastTimeChange = getTime();
 
-	_playbackRate = targetRate;
-	_startTime = g_system->getMillis();
+		_playbackRate = targetRate;
+		_startTime = g_system->getMillis();
+
+		// Adjust start time if we've seek'ed to something besides zero time
+		if (_lastTimeChange != 0)
+			_startTime -= (_lastTimeChange.msecs() / _playbackRate).toInt();
 
-	// Adjust start time if we've seek'ed to something besides zero time
-	if (_lastTimeChange != 0)
-		_startTime -= (_lastTimeChange.msecs() / _playbackRate).toInt();
+		startAudio();
+	}
 
-	startAudio();
+	releaseDecodeAhead();
 }
 
 bool VideoDecoder::isPlaying() const {
@@ -588,10 +671,248 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
 	_videoCodecAccuracy = accuracy;
 
+	stopDecodeAheadJob();
 	for (Track *track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo)
 			static_cast<VideoTrack *>(track)->setCodecAccuracy(accuracy);
 	}
+	kickDecodeAhead();
+}
+
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	flushDecodeAhead();
+
+	for (auto &entry : _decodeAheadQueue) {
+		entry.surface->free();
+		delete entry.surface;
+	}
+	_decodeAheadQueue.clear();
+
+	if (_decodeAheadSurface) {
+		_decodeAheadSurface->free();
+		delete _decodeAheadSurface;
+		_decodeAheadSurface = nullptr;
+	}
+
+	delete _decodeAheadGroup;
+	_decodeAheadGroup = nullptr;
+
+	if (frames == 0)
+		return true;
+
+	if (!JobMan.isThreaded())
+		return false;
+
+	for (const auto &track : _tracks)
+		if (track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->isReversed())
+			return false;
+
+	// Allocate the surfaces up front if the frame format is known already
+	uint16 width = getWidth();
+	uint16 height = getHeight();
+	Graphics::PixelFormat format = getPixelFormat();
+
+	_decodeAheadQueue.resize(frames);
+	for (auto &entry : _decodeAheadQueue) {
+		entry.surface = new Graphics::Surface();
+		if (width && height && format.bytesPerPixel)
+			entry.surface->create(width, height, format);
+	}
+
+	_decodeAheadSurface = new Graphics::Surface();
+	_decodeAheadGroup = new Common::JobGroup();
+	memset(&_decodeAheadStats, 0, sizeof(_decodeAheadStats));
+	return true;
+}
+
+uint VideoDecoder::getDecodeAheadQueueDepth() const {
+	Common::StackLock lock(_decodeAheadMutex);
+	return _decodeAheadCount;
+}
+
+VideoDecoder::DecodeAheadStats VideoDecoder::getDecodeAheadStats() const {
+	Common::StackLock lock(_decodeAheadMutex);
+	return _decodeAheadStats;
+}
+
+void VideoDecoder::decodeAheadJob(void *param) {
+	((VideoDecoder *)param)->runDecodeAhead();
+}
+
+void VideoDecoder::runDecodeAhead() {
+	for (;;) {
+		uint slot;
+
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (_decodeAheadStop || _decodeAheadCount == _decodeAheadQueue.size())
+				return;
+
+			// Slots past the queued frames are not touched by the main thread
+			slot = (_decodeAheadHead + _decodeAheadCount) % _decodeAheadQueue.size();
+		}
+
+		bool decoded = decodeAheadFrame(_decodeAheadQueue[slot]);
+
+		Common::StackLock lock(_decodeAheadMutex);
+		if (!decoded) {
+			_decodeAheadEnd = true;
+			return;
+		}
+
+		_decodeAheadCount++;
+		_decodeAheadStats.decodedFrames++;
+		_decodeAheadStats.maxQueueDepth = MAX(_decodeAheadStats.maxQueueDepth, _decodeAheadCount);
+	}
+}
+
+bool VideoDecoder::decodeAheadFrame(DecodeAheadFrame &entry) {
+	readNextPacket();
+
+	if (!_nextVideoTrack)
+		return false;
+
+	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+
+	entry.hasSurface = frame != nullptr;
+	if (frame) {
+		Graphics::Surface *surface = entry.surface;
+		if (surface->w != frame->w || surface->h != frame->h || surface->format != frame->format) {
+			surface->free();
+			surface->create(frame->w, frame->h, frame->format);
+		}
+		surface->copyRectToSurface(*frame, 0, 0, Common::Rect(frame->w, frame->h));
+	}
+
+	entry.dirtyPalette = _nextVideoTrack->hasDirtyPalette();
+	if (entry.dirtyPalette)
+		memcpy(entry.palette, _nextVideoTrack->getPalette(), sizeof(entry.palette));
+
+	findNextVideoTrack();
+	captureDecodeAheadState(entry.state);
+	return true;
+}
+
+void VideoDecoder::captureDecodeAheadState(DecodeAheadState &state) const {
+	state.curFrame = -1;
+	state.curFrameDelay = -1;
+
+	for (const auto &track : _tracks) {
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			state.curFrame += ((const VideoTrack *)track)->getCurFrame() + 1;
+			state.curFrameDelay += ((const VideoTrack *)track)->getCurFrameDelay() + 1;
+		}
+	}
+
+	state.hasNextFrame = _nextVideoTrack != nullptr;
+	state.nextFrameStartTime = _nextVideoTrack ? _nextVideoTrack->getNextFrameStartTime() : 0;
+}
+
+void VideoDecoder::startDecodeAhead() {
+	captureDecodeAheadState(_decodeAheadState);
+	_decodeAheadStarted = true;
+	kickDecodeAhead();
+}
+
+void VideoDecoder::kickDecodeAhead() {
+	if (!_decodeAheadStarted || _decodeAheadHold || !_decodeAheadGroup->isDone())
+		return;
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		if (_decodeAheadEnd || _decodeAheadCount == _decodeAheadQueue.size())
+			return;
+	}
+
+	_decodeAheadGroup->wait();
+	JobMan.submit(&decodeAheadJob, this, _decodeAheadGroup);
+}
+
+void VideoDecoder::stopDecodeAheadJob() {
+	if (!_decodeAheadGroup)
+		return;
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadStop = true;
+	}
+
+	// Waits at most for the frame being decoded
+	_decodeAheadGroup->wait();
+
+	Common::StackLock lock(_decodeAheadMutex);
+	_decodeAheadStop = false;
+}
+
+void VideoDecoder::holdDecodeAhead() {
+	_decodeAheadHold++;
+	stopDecodeAheadJob();
+}
+
+void VideoDecoder::releaseDecodeAhead() {
+	assert(_decodeAheadHold);
+	_decodeAheadHold--;
+	kickDecodeAhead();
+}
+
+void VideoDecoder::flushDecodeAhead() {
+	stopDecodeAheadJob();
+
+	_decodeAheadHead = 0;
+	_decodeAheadCount = 0;
+	_decodeAheadEnd = false;
+	_decodeAheadStarted = false;
+}
+
+const Graphics::Surface *VideoDecoder::popDecodeAheadFrame() {
+	if (!_decodeAheadStarted)
+		startDecodeAhead();
+
+	if (getDecodeAheadQueueDepth() == 0) {
+		// The worker fell behind: let it finish the frame it is decoding,
+		// or decode the next one right here
+		stopDecodeAheadJob();
+
+		if (_decodeAheadCount == 0) {
+			if (!decodeAheadFrame(_decodeAheadQueue[_decodeAheadHead])) {
+				_decodeAheadEnd = true;
+				return nullptr;
+			}
+
+			_decodeAheadCount = 1;
+			_decodeAheadStats.decodedFrames++;
+			_decodeAheadStats.maxQueueDepth = MAX<uint>(_decodeAheadStats.maxQueueDepth, 1);
+		}
+
+		_decodeAheadEnd = false;
+		_decodeAheadStats.stalls++;
+	}
+
+	// The slot keeps the previous frame's surface for reuse
+	DecodeAheadFrame &entry = _decodeAheadQueue[_decodeAheadHead];
+	SWAP(entry.surface, _decodeAheadSurface);
+	_decodeAheadState = entry.state;
+
+	if (entry.dirtyPalette) {
+		memcpy(_decodeAheadPalette, entry.palette, sizeof(_decodeAheadPalette));
+		_palette = _decodeAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	bool hasSurface = entry.hasSurface;
+	bool late = isPlaying() && _decodeAheadState.hasNextFrame && _decodeAheadState.nextFrameStartTime <= getTime();
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadHead = (_decodeAheadHead + 1) % _decodeAheadQueue.size();
+		_decodeAheadCount--;
+		_decodeAheadStats.shownFrames++;
+		if (late)
+			_decodeAheadStats.lateFrames++;
+	}
+
+	kickDecodeAhead();
+	return hasSurface ? _decodeAheadSurface : nullptr;
 }
 
 VideoDecoder::Track::Track() {
@@ -817,6 +1138,8 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::Path &baseNa
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	stopDecodeAheadJob();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -852,6 +1175,8 @@ void VideoDecoder::addTrack(Track *track, bool isExternal) {
 	// Start the track if we're playing
 	if (isPlaying() && track->getTrackType() == Track::kTrackTypeAudio)
 		((AudioTrack *)track)->start();
+
+	kickDecodeAhead();
 }
 
 bool VideoDecoder::addStreamTrack(Audio::SeekableAudioStream *stream) {
@@ -893,9 +1218,11 @@ bool VideoDecoder::setAudioTrack(int index) {
 	if (_mainAudioTrack == audioTrack)
 		return true;
 
+	stopDecodeAheadJob();
 	_mainAudioTrack->setMute(true);
 	audioTrack->setMute(false);
 	_mainAudioTrack = audioTrack;
+	kickDecodeAhead();
 	return true;
 }
 
@@ -912,6 +1239,8 @@ uint VideoDecoder::getAudioTrackCount() const {
 void VideoDecoder::setEndTime(const Audio::Timestamp &endTime) {
 	Audio::Timestamp startTime = 0;
 
+	holdDecodeAhead();
+
 	if (isPlaying()) {
 		startTime = getTime();
 		stopAudio();
@@ -920,44 +1249,62 @@ void VideoDecoder::setEndTime(const Audio::Timestamp &endTime) {
 	_endTime = endTime;
 	_endTimeSet = true;
 
-	if (startTime > endTime)
-		return;
-
-	if (isPlaying()) {
+	if (startTime <= endTime && isPlaying()) {
 		// We'll assume the audio track is going to start up at the same time it just was
 		// and therefore not do any seeking.
 		// Might want to set it anyway if we're seekable.
 		startAudioLimit(_endTime.msecs() - startTime.msecs());
 		_lastTimeChange = startTime;
 	}
+
+	releaseDecodeAhead();
 }
 
 void VideoDecoder::setEndFrame(uint frame) {
 	VideoTrack *videoTrack = nullptr;
 
+	// Track implementations may look at their decoding state for the frame time
+	holdDecodeAhead();
+
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo) {
 			// We only allow this when one video track is present
-			if (videoTrack)
-				return;
+			if (videoTrack) {
+				videoTrack = nullptr;
+				break;
+			}
 
 			videoTrack = (VideoTrack *)track;
 		}
 	}
 
 	// If we didn't find a video track, we can't set the final frame (of course)
-	if (!videoTrack)
-		return;
-
-	Audio::Timestamp time = videoTrack->getFrameTime(frame + 1);
+	if (videoTrack) {
+		Audio::Timestamp time = videoTrack->getFrameTime(frame + 1);
 
-	if (time < 0)
-		return;
+		if (time >= 0)
+			setEndTime(time);
+	}
 
-	setEndTime(time);
+	releaseDecodeAhead();
 }
 
 void VideoDecoder::resetStartTime() {
+	if (_decodeAheadStarted) {
+		// The tracks are ahead of the frame that is shown
+		stopDecodeAheadJob();
+		for (const auto &track : _tracks) {
+			if (track->getTrackType() == Track::kTrackTypeVideo) {
+				Audio::Timestamp curTime = ((VideoTrack *)track)->getFrameTime(_decodeAheadState.curFrame);
+				if (isPlaying())
+					_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
+				break;
+			}
+		}
+		kickDecodeAhead();
+		return;
+	}
+
 	if (_nextVideoTrack) {
 		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
 		if (isPlaying()) {
@@ -1040,6 +1387,11 @@ void VideoDecoder::startAudioLimit(const Audio::Timestamp &limit) {
 }
 
 bool VideoDecoder::hasFramesLeft() const {
+	if (_decodeAheadStarted) {
+		const DecodeAheadState &state = _decodeAheadState;
+		return state.hasNextFrame && !(isPlaying() && _endTimeSet && state.nextFrameStartTime >= (uint)_endTime.msecs());
+	}
+
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
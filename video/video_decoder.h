@@ -25,6 +25,7 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/mutex.h"
 #include "common/path.h"
 #include "common/rational.h"
 #include "common/str.h"
@@ -38,6 +39,7 @@ class SeekableAudioStream;
 }
 
 namespace Common {
+class JobGroup;
 class SeekableReadStream;
 }
 
@@ -53,7 +55,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -430,6 +432,53 @@ public:
 	 */
 	virtual void setVideoCodecAccuracy(Image::CodecAccuracy accuracy);
 
+	/**
+	 * Statistics about decoding ahead, see setDecodeAhead().
+	 */
+	struct DecodeAheadStats {
+		uint32 decodedFrames; ///< Frames decoded into the queue
+		uint32 shownFrames;   ///< Frames handed out by decodeNextFrame()
+		uint32 lateFrames;    ///< Frames handed out after the following one was already due
+		uint32 stalls;        ///< Times decodeNextFrame() found the queue empty and had to wait
+		uint maxQueueDepth;   ///< Highest number of frames queued at once
+	};
+
+	/**
+	 * Decode frames ahead of time on a worker thread.
+	 *
+	 * A job of the job system decodes up to the given number of frames into
+	 * a ring of surfaces while the current frame is displayed, and
+	 * decodeNextFrame() only hands out the next queued frame. Seeking and
+	 * rewinding drop the queued frames. Passing 0 turns this off again, as
+	 * does close().
+	 *
+	 * The tracks are only touched by the worker while it runs, so subclasses
+	 * must not access them from outside decodeNextFrame() and the
+	 * VideoDecoder API. The worker also reads packets through the subclass,
+	 * so subclasses must call close() in their destructor before freeing
+	 * their own state. Reverse playback is not supported.
+	 *
+	 * @param frames Number of frames to decode ahead, or 0 to decode on demand
+	 * @return true on success, false if there are no worker threads or the
+	 *         video is playing in reverse
+	 */
+	bool setDecodeAhead(uint frames);
+
+	/**
+	 * Return the number of frames decoded ahead, or 0 if disabled.
+	 */
+	uint getDecodeAhead() const { return _decodeAheadQueue.size(); }
+
+	/**
+	 * Return the number of frames currently waiting in the decode-ahead queue.
+	 */
+	uint getDecodeAheadQueueDepth() const;
+
+	/**
+	 * Return statistics about decoding ahead since it was last enabled.
+	 */
+	DecodeAheadStats getDecodeAheadStats() const;
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -1053,6 +1102,48 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decode-ahead
+	struct DecodeAheadState {
+		int curFrame;
+		int curFrameDelay;
+		uint32 nextFrameStartTime;
+		bool hasNextFrame;
+	};
+
+	struct DecodeAheadFrame {
+		Graphics::Surface *surface;
+		bool hasSurface;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+		DecodeAheadState state;
+	};
+
+	static void decodeAheadJob(void *param);
+	void runDecodeAhead();
+	bool decodeAheadFrame(DecodeAheadFrame &entry);
+	void captureDecodeAheadState(DecodeAheadState &state) const;
+	void startDecodeAhead();
+	void kickDecodeAhead();
+	void stopDecodeAheadJob();
+	void holdDecodeAhead();
+	void releaseDecodeAhead();
+	void flushDecodeAhead();
+	const Graphics::Surface *popDecodeAheadFrame();
+
+	Common::Array<DecodeAheadFrame> _decodeAheadQueue;
+	uint _decodeAheadHead;
+	uint _decodeAheadCount;
+	bool _decodeAheadStarted; // The queue and _decodeAheadState are in use
+	bool _decodeAheadStop;
+	bool _decodeAheadEnd;
+	uint _decodeAheadHold; // The job stays stopped while this is non-zero
+	Common::JobGroup *_decodeAheadGroup;
+	Common::Mutex _decodeAheadMutex;
+	DecodeAheadState _decodeAheadState;
+	DecodeAheadStats _decodeAheadStats;
+	Graphics::Surface *_decodeAheadSurface;
+	byte _decodeAheadPalette[256 * 3];
 };
 
 } // End of namespace Video